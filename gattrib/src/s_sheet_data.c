@@ -127,7 +127,7 @@ void s_sheet_data_add_master_comp_list_items (const GList *obj_list) {
     OBJECT *o_current = iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_comp_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_comp_list_items, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
       /*-----  only process if this is a component with attributes ----*/
@@ -193,7 +193,7 @@ void s_sheet_data_add_master_comp_attrib_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_comp_attrib_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_comp_attrib_list_items, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
       /*-----  only process if this is a component with attributes ----*/
@@ -306,7 +306,7 @@ void s_sheet_data_add_master_pin_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-    printf ("In s_sheet_data_add_master_pin_list_items, examining o_current->name = %s\n", o_current->name);
+    printf ("In s_sheet_data_add_master_pin_list_items, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
     if (o_current->type == OBJ_COMPLEX) {
@@ -319,7 +319,7 @@ void s_sheet_data_add_master_pin_list_items (const GList *obj_list) {
              o_lower_iter = g_list_next (o_lower_iter)) {
           OBJECT *o_lower_current = o_lower_iter->data;
 #if DEBUG
-          printf ("In s_sheet_data_add_master_pin_list_items, examining object name %s\n", o_lower_current->name);
+          printf ("In s_sheet_data_add_master_pin_list_items, examining object name %s\n", o_get_name (o_lower_current));
 #endif
           if (o_lower_current->type == OBJ_PIN) {
             temp_pinnumber = o_attrib_search_object_attribs_by_name (o_lower_current, "pinnumber", 0);
@@ -398,7 +398,7 @@ void s_sheet_data_add_master_pin_attrib_list_items (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("In s_sheet_data_add_master_pin_attrib_list_items, examining o_current->name = %s\n", o_current->name);
+      printf("In s_sheet_data_add_master_pin_attrib_list_items, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
       if (o_current->type == OBJ_COMPLEX) {
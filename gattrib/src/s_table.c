@@ -300,7 +300,7 @@ void s_table_add_toplevel_comp_items_to_comp_table (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("   ---> In s_table_add_toplevel_comp_items_to_comp_table, examining o_current->name = %s\n", o_current->name);
+      printf("   ---> In s_table_add_toplevel_comp_items_to_comp_table, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
     /* -----  Now process objects found on page  ----- */
@@ -506,7 +506,7 @@ void s_table_add_toplevel_pin_items_to_pin_table (const GList *obj_list) {
     OBJECT *o_current = o_iter->data;
 
 #ifdef DEBUG
-      printf("   ---> In s_table_add_toplevel_pin_items_to_pin_table, examining o_current->name = %s\n", o_current->name);
+      printf("   ---> In s_table_add_toplevel_pin_items_to_pin_table, examining o_current->name = %s\n", o_get_name (o_current));
 #endif
 
     /* -----  Now process objects found on page  ----- */
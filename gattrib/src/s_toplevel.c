@@ -443,7 +443,7 @@ s_toplevel_sheetdata_to_toplevel (TOPLEVEL *toplevel, PAGE *page)
       } else {
 #ifdef DEBUG
 	printf("In s_toplevel_sheetdata_to_toplevel, found complex with no refdes. name = %s\n", 
-	       o_current->name);
+	       o_get_name (o_current));
 #endif
       }
     }  /* if (o_current->type == OBJ_COMPLEX) */
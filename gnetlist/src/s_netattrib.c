@@ -138,7 +138,7 @@ s_netattrib_create_pins(TOPLEVEL * pr_current, OBJECT * o_current,
 
 		new_cpin = s_cpinlist_add(cpinlist_tail);
 
-		new_cpin->pin_number = g_strdup (current_pin);
+		new_cpin->pin_number = (char *) s_string_intern (current_pin);
 		new_cpin->net_name = NULL;
 
 		new_cpin->plid = o_current->sid;
@@ -268,6 +268,7 @@ CPINLIST *s_traverse_component(TOPLEVEL * pr_current, OBJECT * component,
   NET *nets_head = NULL;
   NET *nets = NULL;
   GList *iter;
+  char *value;
 
   cpinlist_head = cpins = s_cpinlist_add(NULL);
   cpins->plid = -1;
@@ -287,11 +288,13 @@ CPINLIST *s_traverse_component(TOPLEVEL * pr_current, OBJECT * component,
     cpins->plid = o_current->sid;
     cpins->type = o_current->pin_type;
 
-    cpins->pin_number =
-      o_attrib_search_object_attribs_by_name (o_current, "pinnumber", 0);
+    value = o_attrib_search_object_attribs_by_name (o_current, "pinnumber", 0);
+    cpins->pin_number = (char *) s_string_intern (value);
+    g_free (value);
 
-    cpins->pin_label =
-      o_attrib_search_object_attribs_by_name (o_current, "pinlabel", 0);
+    value = o_attrib_search_object_attribs_by_name (o_current, "pinlabel", 0);
+    cpins->pin_label = (char *) s_string_intern (value);
+    g_free (value);
 
     /* head nets node */
     /* is this really need */
@@ -299,7 +302,7 @@ CPINLIST *s_traverse_component(TOPLEVEL * pr_current, OBJECT * component,
     nets->nid = -1;
 
     /* This avoids us adding an unnamed net for an unconnected pin */
-    if (o_current->conn_list != NULL) {
+    if (o_current->conns != NULL) {
       (void) s_traverse_net (pr_current, nets, TRUE,
                              o_current, hierarchy_tag, cpins->type);
       s_traverse_clear_all_visited (s_page_objects (pr_current->page_current));
@@ -332,7 +335,7 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
 {
   NET *new_net;
   CONN *c_current;
-  GList *cl_current;
+  guint i;
   char *temp = NULL;
 
   visit (object);
@@ -367,7 +370,7 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
     }
   }
 #if DEBUG
-  printf("inside traverse: %s\n", object->name);
+  printf("inside traverse: %s\n", o_get_name (object));
 #endif
 
   if (object->type == OBJ_PIN) {
@@ -380,7 +383,8 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
     temp = o_attrib_search_object_attribs_by_name (object, "pinlabel", 0);
 
     if (temp) {
-      new_net->pin_label = temp;
+      new_net->pin_label = (char *) s_string_intern (temp);
+      g_free (temp);
     }
 
     /* net= new */
@@ -407,7 +411,7 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
       return nets;
   }
 
-  /*printf("Found net %s\n", object->name); */
+  /*printf("Found net %s\n", o_get_name (object)); */
   verbose_print("n");
 
   /* this is not perfect yet and won't detect a loop... */
@@ -416,10 +420,9 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
     exit(-1);
   }
 
-  cl_current = object->conn_list;
-  while (cl_current != NULL) {
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
 
-    c_current = (CONN *) cl_current->data;
+    c_current = &g_array_index (object->conns, CONN, i);
 
     if (c_current->other_object != NULL) {
 
@@ -430,7 +433,6 @@ NET *s_traverse_net (TOPLEVEL *pr_current, NET *nets, int starting,
       }
 
     }
-    cl_current = g_list_next(cl_current);
   }
 
   return (nets);
@@ -129,6 +129,9 @@
 #define MENU			1
 #define HOTKEY			2
 
+/* shortest time in ms between two updates of rubberband drawing */
+#define MOTION_FRAME_INTERVAL	16
+
 /* for a_pan_general and a_zoom */
 #define A_PAN_IGNORE_BORDERS 	1
 #define A_PAN_DONT_REDRAW 	2
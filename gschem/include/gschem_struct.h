@@ -106,6 +106,10 @@ struct st_gschem_toplevel {
                                            Its range of values depends on the
                                            type of object being manipulated. */
   OBJECT *which_object;                 /* Object being manipulated */
+  int motion_x, motion_y;               /* Last pointer position seen */
+  GdkModifierType motion_state;         /* Modifier state at that position */
+  guint motion_source;                  /* Timeout handling it, or 0 */
+  GTimeVal motion_time;                 /* When motion was last handled */
 
   /* ------------------ */
   /* Rubberbanding nets */
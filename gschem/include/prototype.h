@@ -30,6 +30,7 @@ SCM g_funcs_msg(SCM msg);
 SCM g_funcs_confirm(SCM msg);
 SCM g_funcs_filesel(SCM msg, SCM templ, SCM flags);
 SCM g_funcs_use_rc_values(void);
+SCM g_funcs_autonumber(SCM scm_searchtext, SCM scm_startnum, SCM scm_overwrite);
 SCM get_selected_component_attributes(GSCHEM_TOPLEVEL *w_current);
 /* g_hook.c */
 void g_init_hook ();
@@ -498,6 +499,7 @@ void o_glist_draw_place(GSCHEM_TOPLEVEL *w_current, int dx, int dy, GList *list)
 void o_invalidate_rect(GSCHEM_TOPLEVEL *w_current, int x1, int y1, int x2, int y2);
 void o_invalidate_all(GSCHEM_TOPLEVEL *w_current);
 void o_invalidate(GSCHEM_TOPLEVEL *w_current, OBJECT *object);
+void o_invalidate_world_rect(GSCHEM_TOPLEVEL *w_current, int left, int top, int right, int bottom);
 void o_invalidate_glist(GSCHEM_TOPLEVEL *w_current, GList *list);
 COLOR *o_drawing_color(GSCHEM_TOPLEVEL *w_current, OBJECT *object);
 /* o_box.c */
@@ -594,9 +596,10 @@ void o_edit_hide_specific_text(GSCHEM_TOPLEVEL *w_current, const GList *o_list,
 void o_edit_show_specific_text(GSCHEM_TOPLEVEL *w_current, const GList *o_list, char *stext);
 OBJECT *o_update_component(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current);
 void o_autosave_backups(GSCHEM_TOPLEVEL *w_current);
+void o_autosave_wait(GSCHEM_TOPLEVEL *w_current);
 /* o_move.c */
 void o_move_start(GSCHEM_TOPLEVEL *w_current, int x, int y);
-void o_move_end_lowlevel(GSCHEM_TOPLEVEL *w_current, OBJECT *object, int diff_x, int diff_y);
+void o_move_end_lowlevel(GSCHEM_TOPLEVEL *w_current, CONN_UPDATE *update, OBJECT *object, int diff_x, int diff_y);
 void o_move_end(GSCHEM_TOPLEVEL *w_current);
 void o_move_cancel(GSCHEM_TOPLEVEL *w_current);
 void o_move_motion(GSCHEM_TOPLEVEL *w_current, int x, int y);
@@ -606,7 +609,7 @@ int o_move_return_whichone(OBJECT *object, int x, int y);
 void o_move_check_endpoint(GSCHEM_TOPLEVEL *w_current, OBJECT *object);
 void o_move_prep_rubberband(GSCHEM_TOPLEVEL *w_current);
 int o_move_zero_length(OBJECT *object);
-void o_move_end_rubberband(GSCHEM_TOPLEVEL *w_current, int world_diff_x, int world_diff_y, GList **objects);
+void o_move_end_rubberband(GSCHEM_TOPLEVEL *w_current, CONN_UPDATE *update, int world_diff_x, int world_diff_y, GList **objects);
 /* o_net.c */
 void o_net_reset(GSCHEM_TOPLEVEL *w_current); 
 void o_net_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current);
@@ -691,7 +694,6 @@ void o_text_change(GSCHEM_TOPLEVEL *w_current, OBJECT *object, char *string, int
 void o_undo_init(void);
 void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag);
 char *o_undo_find_prev_filename(UNDO *start);
-GList *o_undo_find_prev_object_head(UNDO *start);
 void o_undo_callback(GSCHEM_TOPLEVEL *w_current, int type);
 void o_undo_cleanup(void);
 void o_undo_remove_last_undo(GSCHEM_TOPLEVEL *w_current);
@@ -707,6 +709,7 @@ gint option_menu_get_history(GtkOptionMenu *option_menu);
 void attrib_edit_dialog_ok(GtkWidget *w, GSCHEM_TOPLEVEL *w_current);
 void attrib_edit_dialog(GSCHEM_TOPLEVEL *w_current, OBJECT *attr_obj, int flag);
 /* x_autonumber.c */
+void autonumber_text_run(GSCHEM_TOPLEVEL *w_current, const gchar *searchtext, gint startnum, gboolean overwrite);
 void autonumber_text_dialog(GSCHEM_TOPLEVEL *w_current);
 /* x_basic.c */
 void x_repaint_background_region(GSCHEM_TOPLEVEL *w_current, int x, int y, int width, int height);
@@ -775,6 +778,7 @@ gint x_event_expose(GtkWidget *widget, GdkEventExpose *event, GSCHEM_TOPLEVEL *w
 gint x_event_button_pressed(GtkWidget *widget, GdkEventButton *event, GSCHEM_TOPLEVEL *w_current);
 gint x_event_button_released(GtkWidget *widget, GdkEventButton *event, GSCHEM_TOPLEVEL *w_current);
 gint x_event_motion(GtkWidget *widget, GdkEventMotion *event, GSCHEM_TOPLEVEL *w_current);
+void x_event_motion_flush(GSCHEM_TOPLEVEL *w_current);
 gboolean x_event_configure (GtkWidget *widget, GdkEventConfigure *event, gpointer user_data);
 void x_manual_resize(GSCHEM_TOPLEVEL *w_current);
 void x_event_hschanged(GtkAdjustment *adj, GSCHEM_TOPLEVEL *w_current);
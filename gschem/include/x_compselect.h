@@ -50,6 +50,7 @@ GType compselect_behavior_get_type (void);
 
 typedef struct _CompselectClass CompselectClass;
 typedef struct _Compselect      Compselect;
+typedef struct _CompselectFilterIndex CompselectFilterIndex;
 
 
 struct _CompselectClass {
@@ -69,6 +70,10 @@ struct _Compselect {
   GtkEntry    *entry_filter;
   GtkButton   *button_clear;
   guint        filter_timeout;
+  CompselectFilterIndex *filter_index;
+  guint        preview_timeout;
+  guint        prefetch_idle;
+  gint         prefetch_step;
   GtkComboBox *combobox_behaviors;
 
   gboolean hidden;
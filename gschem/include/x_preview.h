@@ -51,11 +51,16 @@ struct _Preview {
   gchar *buffer;
 
   gboolean active;
+
+  GHashTable *page_cache;  /* symbol data -> PAGE holding its objects */
+  GQueue *page_lru;        /* keys of page_cache, most recently used first */
   
 };
 
 
 GType preview_get_type (void);
 
+void preview_prefetch (Preview *preview, const gchar *buffer);
+
 
 #endif /* __X_PREVIEW_H__ */
@@ -273,3 +273,45 @@ SCM g_funcs_use_rc_values(void)
   i_vars_set(g_current_window ());
   return SCM_BOOL_T;
 }
+
+/*! \brief Autonumber texts from a script
+ *  \par Function Description
+ *  Scheme binding of autonumber_text_run(). Numbers the texts matching
+ *  \a scm_searchtext, e.g. "refdes=*", throughout the hierarchy below
+ *  the current page, without the autonumber dialog.
+ *
+ *  The numbering works on the pages of the current gschem window, so
+ *  this is only available in gschem, and needs an X display even from
+ *  a script run with "gschem -s".  It is not a headless entry point.
+ *  Outside a window it raises a misc-error.
+ *
+ *  \param [in] scm_searchtext  The search text, ending with "?" or "*".
+ *  \param [in] scm_startnum    The first number to use (default 1).
+ *  \param [in] scm_overwrite   Whether to renumber numbered texts too
+ *                              (default \#f).
+ *  \return SCM_BOOL_T.
+ */
+SCM g_funcs_autonumber(SCM scm_searchtext, SCM scm_startnum,
+                       SCM scm_overwrite)
+{
+  char *searchtext;
+  int startnum = 1;
+  gboolean overwrite = FALSE;
+
+  SCM_ASSERT (scm_is_string (scm_searchtext), scm_searchtext,
+              SCM_ARG1, "gschem-autonumber");
+  if (!SCM_UNBNDP (scm_startnum)) {
+    SCM_ASSERT (scm_is_integer (scm_startnum), scm_startnum,
+                SCM_ARG2, "gschem-autonumber");
+    startnum = scm_to_int (scm_startnum);
+  }
+  if (!SCM_UNBNDP (scm_overwrite)) {
+    overwrite = scm_is_true (scm_overwrite);
+  }
+
+  searchtext = scm_to_utf8_string (scm_searchtext);
+  autonumber_text_run (g_current_window (), searchtext, startnum, overwrite);
+  free (searchtext);
+
+  return SCM_BOOL_T;
+}
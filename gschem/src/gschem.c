@@ -246,9 +246,8 @@ void main_prog(void *closure, int argc, char *argv[])
                                    o_text_get_rendered_bounds, w_current);
 
   /* Damage notifications should invalidate the object on screen */
-  o_add_change_notify (w_current->toplevel,
-                       (ChangeNotifyFunc) o_invalidate,
-                       (ChangeNotifyFunc) o_invalidate, w_current);
+  o_add_damage_notify (w_current->toplevel,
+                       (DamageNotifyFunc) o_invalidate_world_rect, w_current);
 
   scm_dynwind_begin (0);
   g_dynwind_window (w_current);
@@ -118,6 +118,12 @@ GSCHEM_TOPLEVEL *gschem_toplevel_new ()
   w_current->net_direction = 0;
   w_current->which_grip = -1;
   w_current->which_object = NULL;
+  w_current->motion_x = 0;
+  w_current->motion_y = 0;
+  w_current->motion_state = 0;
+  w_current->motion_source = 0;
+  w_current->motion_time.tv_sec = 0;
+  w_current->motion_time.tv_usec = 0;
 
   /* ------------------ */
   /* Rubberbanding nets */
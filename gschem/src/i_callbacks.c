@@ -113,9 +113,8 @@ DEFINE_I_CALLBACK(file_new_window)
                                    o_text_get_rendered_bounds, w_current);
 
   /* Damage notifications should invalidate the object on screen */
-  o_add_change_notify (w_current->toplevel,
-                       (ChangeNotifyFunc) o_invalidate,
-                       (ChangeNotifyFunc) o_invalidate, w_current);
+  o_add_damage_notify (w_current->toplevel,
+                       (DamageNotifyFunc) o_invalidate_world_rect, w_current);
 
   x_window_setup (w_current);
 
@@ -3088,6 +3087,7 @@ DEFINE_I_CALLBACK(attributes_show_name)
     SELECTION *selection = toplevel->page_current->selection_list;
     GList *s_current;
 
+    o_change_notify_freeze (toplevel);
     for (s_current = geda_list_get_glist (selection);
          s_current != NULL;
          s_current = g_list_next (s_current)) {
@@ -3095,6 +3095,7 @@ DEFINE_I_CALLBACK(attributes_show_name)
       if (object->type == OBJ_TEXT)
         o_attrib_toggle_show_name_value (w_current, object, SHOW_NAME);
     }
+    o_change_notify_thaw (toplevel);
 
     o_undo_savestate (w_current, UNDO_ALL);
   }
@@ -3125,6 +3126,7 @@ DEFINE_I_CALLBACK(attributes_show_value)
     SELECTION *selection = toplevel->page_current->selection_list;
     GList *s_current;
 
+    o_change_notify_freeze (toplevel);
     for (s_current = geda_list_get_glist (selection);
          s_current != NULL;
          s_current = g_list_next (s_current)) {
@@ -3132,6 +3134,7 @@ DEFINE_I_CALLBACK(attributes_show_value)
       if (object->type == OBJ_TEXT)
         o_attrib_toggle_show_name_value (w_current, object, SHOW_VALUE);
     }
+    o_change_notify_thaw (toplevel);
 
     o_undo_savestate (w_current, UNDO_ALL);
   }
@@ -3162,6 +3165,7 @@ DEFINE_I_CALLBACK(attributes_show_both)
     SELECTION *selection = toplevel->page_current->selection_list;
     GList *s_current;
 
+    o_change_notify_freeze (toplevel);
     for (s_current = geda_list_get_glist (selection);
          s_current != NULL;
          s_current = g_list_next (s_current)) {
@@ -3169,6 +3173,7 @@ DEFINE_I_CALLBACK(attributes_show_both)
       if (object->type == OBJ_TEXT)
         o_attrib_toggle_show_name_value (w_current, object, SHOW_NAME_VALUE);
     }
+    o_change_notify_thaw (toplevel);
 
     o_undo_savestate (w_current, UNDO_ALL);
   }
@@ -3200,6 +3205,7 @@ DEFINE_I_CALLBACK(attributes_visibility_toggle)
     SELECTION *selection = toplevel->page_current->selection_list;
     GList *s_current;
 
+    o_change_notify_freeze (toplevel);
     for (s_current = geda_list_get_glist (selection);
          s_current != NULL;
          s_current = g_list_next (s_current)) {
@@ -3207,6 +3213,7 @@ DEFINE_I_CALLBACK(attributes_visibility_toggle)
       if (object->type == OBJ_TEXT)
         o_attrib_toggle_visibility (w_current, object);
     }
+    o_change_notify_thaw (toplevel);
 
     o_undo_savestate (w_current, UNDO_ALL);
   }
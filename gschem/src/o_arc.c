@@ -47,7 +47,7 @@ void o_arc_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
     return;
   }
 
-  gschem_cairo_arc (w_current, o_current->line_width,
+  gschem_cairo_arc (w_current, o_current->style->line_width,
                                o_current->arc->x,
                                o_current->arc->y,
                                o_current->arc->width / 2,
@@ -56,11 +56,11 @@ void o_arc_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
 
   gschem_cairo_set_source_color (w_current,
                                  o_drawing_color (w_current, o_current));
-  gschem_cairo_stroke (w_current, o_current->line_type,
-                                  o_current->line_end,
-                                  o_current->line_width,
-                                  o_current->line_length,
-                                  o_current->line_space);
+  gschem_cairo_stroke (w_current, o_current->style->line_type,
+                                  o_current->style->line_end,
+                                  o_current->style->line_width,
+                                  o_current->style->line_length,
+                                  o_current->style->line_space);
 
   if (o_current->selected && w_current->draw_grips == TRUE) {
     o_arc_draw_grips (w_current, o_current);
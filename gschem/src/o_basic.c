@@ -553,6 +553,31 @@ void o_invalidate (GSCHEM_TOPLEVEL *w_current, OBJECT *object)
 }
 
 
+/*! \brief Invalidate on-screen area for a damaged world region
+ *
+ *  \par Function Description
+ *  This function calls o_invalidate_rect() with the given bounds,
+ *  converted to screen coordinates. It is registered with libgeda
+ *  as a damage notification handler, so a batch of object changes
+ *  results in a single invalidation.
+ *
+ *  \param [in] w_current  The GSCHEM_TOPLEVEL object.
+ *  \param [in] left       Left bound of the region (WORLD units)
+ *  \param [in] top        Top bound of the region (WORLD units)
+ *  \param [in] right      Right bound of the region (WORLD units)
+ *  \param [in] bottom     Bottom bound of the region (WORLD units)
+ */
+void o_invalidate_world_rect (GSCHEM_TOPLEVEL *w_current,
+                              int left, int top, int right, int bottom)
+{
+  int s_left, s_top, s_bottom, s_right;
+
+  WORLDtoSCREEN (w_current, left, top, &s_left, &s_top);
+  WORLDtoSCREEN (w_current, right, bottom, &s_right, &s_bottom);
+  o_invalidate_rect (w_current, s_left, s_top, s_right, s_bottom);
+}
+
+
 /*! \brief Invalidate on-screen area for a GList of objects
  *
  *  \par Function Description
@@ -37,7 +37,7 @@
         max((w)->first_wy, (w)->second_wy)
 
 typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
-                           COLOR *color, BOX *box,
+                           COLOR *color, OBJECT *object,
                            gint fill_width,
                            gint angle1, gint pitch1,
                            gint angle2, gint pitch2);
@@ -50,7 +50,7 @@ typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] box         Box definition
+ *  \param [in] object      Box OBJECT to fill.
  *  \param [in] fill_width  BOX pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -59,7 +59,7 @@ typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_box_fill_hollow (GSCHEM_TOPLEVEL *w_current,
-                   COLOR *color, BOX *box,
+                   COLOR *color, OBJECT *object,
                    gint fill_width,
                    gint angle1, gint pitch1,
                    gint angle2, gint pitch2)
@@ -80,7 +80,7 @@ o_box_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] box         Box definition
+ *  \param [in] object      Box OBJECT to fill.
  *  \param [in] fill_width  BOX pattern fill width.
  *  \param [in] angle1      (unused)
  *  \param [in] pitch1      (unused)
@@ -89,7 +89,7 @@ o_box_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_box_fill_fill (GSCHEM_TOPLEVEL *w_current,
-                 COLOR *color, BOX *box,
+                 COLOR *color, OBJECT *object,
                  gint fill_width,
                  gint angle1, gint pitch1,
                  gint angle2, gint pitch2)
@@ -116,7 +116,7 @@ o_box_fill_fill (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] box         Box definition
+ *  \param [in] object      Box OBJECT to fill.
  *  \param [in] fill_width  BOX pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -125,7 +125,7 @@ o_box_fill_fill (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_box_fill_hatch (GSCHEM_TOPLEVEL *w_current,
-                  COLOR *color, BOX *box,
+                  COLOR *color, OBJECT *object,
                   gint fill_width,
                   gint angle1, gint pitch1,
                   gint angle2, gint pitch2)
@@ -133,10 +133,12 @@ o_box_fill_hatch (GSCHEM_TOPLEVEL *w_current,
   int i;
   GArray *lines;
 
-  gschem_cairo_set_source_color (w_current, color);
+  /* Computed once and kept with the object until it changes */
+  lines = m_hatch_object (object);
+  if (lines == NULL)
+    return;
 
-  lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-  m_hatch_box (box, angle1, pitch1, lines);
+  gschem_cairo_set_source_color (w_current, color);
 
   for (i=0; i < lines->len; i++) {
     LINE *line = &g_array_index (lines, LINE, i);
@@ -145,8 +147,6 @@ o_box_fill_hatch (GSCHEM_TOPLEVEL *w_current,
                                                         line->x[1], line->y[1]);
   }
   gschem_cairo_stroke (w_current, TYPE_SOLID, END_NONE, fill_width, -1, -1);
-
-  g_array_free (lines, TRUE);
 }
 
 /*! \brief Fill inside of box with mesh pattern.
@@ -160,12 +160,12 @@ o_box_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  *  by <B>pitch2</B>.
  *  Every lines have the same width given be <B>fill_width</B>.
  *
- *  This function simply makes two successive calls to the function
- *  #o_box_fill_hatch() respectively with <B>angle1</B>, <B>pitch1</B> and
- *  <B>angle2</B>, <B>pitch2</B> for parameters.
+ *  Both sets of lines are kept in the object's hatch cache (see
+ *  m_hatch_object()), so this function simply draws them with
+ *  #o_box_fill_hatch().
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] box         Box definition
+ *  \param [in] object      Box OBJECT to fill.
  *  \param [in] fill_width  BOX pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -174,13 +174,14 @@ o_box_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_box_fill_mesh (GSCHEM_TOPLEVEL *w_current,
-                 COLOR *color, BOX *box,
+                 COLOR *color, OBJECT *object,
                  gint fill_width,
                  gint angle1, gint pitch1,
                  gint angle2, gint pitch2)
 {
-  o_box_fill_hatch (w_current, color, box, fill_width, angle1, pitch1, -1, -1);
-  o_box_fill_hatch (w_current, color, box, fill_width, angle2, pitch2, -1, -1);
+  /* the object's hatch lines already hold both sets */
+  o_box_fill_hatch (w_current, color, object,
+                    fill_width, angle1, pitch1, angle2, pitch2);
 }
 
 
@@ -251,12 +252,12 @@ void o_box_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
    * hollow (e.q. not filled).
    */
 
-  angle1 = o_current->fill_angle1;
-  pitch1 = o_current->fill_pitch1;
-  angle2 = o_current->fill_angle2;
-  pitch2 = o_current->fill_pitch2;
+  angle1 = o_current->style->fill_angle1;
+  pitch1 = o_current->style->fill_pitch1;
+  angle2 = o_current->style->fill_angle2;
+  pitch2 = o_current->style->fill_pitch2;
 
-  switch (o_current->fill_type) {
+  switch (o_current->style->fill_type) {
     case FILLING_HOLLOW:
       angle1 = -1; angle2 = -1;
       pitch1 = 1; pitch2 = 1;
@@ -296,23 +297,23 @@ void o_box_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
     fill_func = o_box_fill_fill;
 
   (*fill_func) (w_current, o_drawing_color (w_current, o_current),
-                o_current->box, o_current->fill_width,
+                o_current, o_current->style->fill_width,
                 angle1, pitch1, angle2, pitch2);
 
   gschem_cairo_set_source_color (w_current,
                                  o_drawing_color (w_current, o_current));
-  gschem_cairo_box (w_current, o_current->line_width,
+  gschem_cairo_box (w_current, o_current->style->line_width,
                     o_current->box->lower_x, o_current->box->lower_y,
                     o_current->box->upper_x, o_current->box->upper_y);
 
-  if (o_current->fill_type == FILLING_FILL)
+  if (o_current->style->fill_type == FILLING_FILL)
     cairo_fill_preserve (w_current->cr);
 
-  gschem_cairo_stroke (w_current, o_current->line_type,
-                                  o_current->line_end,
-                                  o_current->line_width,
-                                  o_current->line_length,
-                                  o_current->line_space);
+  gschem_cairo_stroke (w_current, o_current->style->line_type,
+                                  o_current->style->line_end,
+                                  o_current->style->line_width,
+                                  o_current->style->line_length,
+                                  o_current->style->line_space);
 
   if (o_current->selected && w_current->draw_grips)
     o_box_draw_grips (w_current, o_current);
@@ -29,7 +29,7 @@
 
 
 typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
-                           COLOR *color, CIRCLE *circle,
+                           COLOR *color, OBJECT *object,
                            gint fill_width, gint angle1, gint pitch1,
                            gint angle2, gint pitch2);
 
@@ -45,7 +45,7 @@ typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Circle fill color.
- *  \param [in] circle      Circle to be drawn
+ *  \param [in] object      Circle OBJECT to fill.
  *  \param [in] fill_width
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -54,7 +54,7 @@ typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_circle_fill_hollow (GSCHEM_TOPLEVEL *w_current,
-                      COLOR *color, CIRCLE *circle,
+                      COLOR *color, OBJECT *object,
                       gint fill_width,
                       gint angle1, gint pitch1,
                       gint angle2, gint pitch2)
@@ -77,7 +77,7 @@ o_circle_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Circle fill color.
- *  \param [in] circle      Circle to be drawn
+ *  \param [in] object      Circle OBJECT to fill.
  *  \param [in] fill_width
  *  \param [in] angle1      (unused)
  *  \param [in] pitch1      (unused)
@@ -86,7 +86,7 @@ o_circle_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_circle_fill_fill (GSCHEM_TOPLEVEL *w_current,
-                    COLOR *color, CIRCLE *circle,
+                    COLOR *color, OBJECT *object,
                     gint fill_width,
                     gint angle1, gint pitch1,
                     gint angle2, gint pitch2)
@@ -117,7 +117,7 @@ o_circle_fill_fill (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Circle fill color.
- *  \param [in] circle      Circle to be drawn
+ *  \param [in] object      Circle OBJECT to fill.
  *  \param [in] fill_width
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -126,7 +126,7 @@ o_circle_fill_fill (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_circle_fill_hatch (GSCHEM_TOPLEVEL *w_current,
-                     COLOR *color, CIRCLE *circle,
+                     COLOR *color, OBJECT *object,
                      gint fill_width,
                      gint angle1, gint pitch1,
                      gint angle2, gint pitch2)
@@ -134,10 +134,12 @@ o_circle_fill_hatch (GSCHEM_TOPLEVEL *w_current,
   int i;
   GArray *lines;
 
-  gschem_cairo_set_source_color (w_current, color);
+  /* Computed once and kept with the object until it changes */
+  lines = m_hatch_object (object);
+  if (lines == NULL)
+    return;
 
-  lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-  m_hatch_circle (circle, angle1, pitch1, lines);
+  gschem_cairo_set_source_color (w_current, color);
 
   for (i=0; i < lines->len; i++) {
     LINE *line = &g_array_index (lines, LINE, i);
@@ -146,8 +148,6 @@ o_circle_fill_hatch (GSCHEM_TOPLEVEL *w_current,
                                                         line->x[1], line->y[1]);
   }
   gschem_cairo_stroke (w_current, TYPE_SOLID, END_NONE, fill_width, -1, -1);
-
-  g_array_free (lines, TRUE);
 }
 
 /*! \brief Fill inside of circle with mesh pattern.
@@ -164,13 +164,13 @@ o_circle_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  *  The unit for <B>width</B>, <B>pitch1</B> and <B>pitch2</B> is pixel and unit
  *  for <B>angle1</B> and <B>angle2</B> is degree.
  *
- *  This function simply makes two successive calls to the function
- *  #o_circle_fill_hatch() respectively with <B>angle1</B>, <B>pitch1</B> and
- *  <B>angle2</B>, <B>pitch2</B> for parameters.
+ *  Both sets of lines are kept in the object's hatch cache (see
+ *  m_hatch_object()), so this function simply draws them with
+ *  #o_circle_fill_hatch().
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Circle fill color.
- *  \param [in] circle      Circle to be drawn
+ *  \param [in] object      Circle OBJECT to fill.
  *  \param [in] fill_width
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -179,16 +179,14 @@ o_circle_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  */
 static void
 o_circle_fill_mesh (GSCHEM_TOPLEVEL *w_current,
-                    COLOR *color, CIRCLE *circle,
+                    COLOR *color, OBJECT *object,
                     gint fill_width,
                     gint angle1, gint pitch1,
                     gint angle2, gint pitch2)
 {
-  o_circle_fill_hatch (w_current, color, circle,
-                       fill_width, angle1, pitch1, -1, -1);
-  o_circle_fill_hatch (w_current, color, circle,
-                       fill_width, angle2, pitch2, -1, -1);
-	
+  /* the object's hatch lines already hold both sets */
+  o_circle_fill_hatch (w_current, color, object,
+                       fill_width, angle1, pitch1, angle2, pitch2);
 }
 
 
@@ -243,12 +241,12 @@ void o_circle_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
    * (e.q. not filled).
    */
 
-  angle1 = o_current->fill_angle1;
-  pitch1 = o_current->fill_pitch1;
-  angle2 = o_current->fill_angle2;
-  pitch2 = o_current->fill_pitch2;
+  angle1 = o_current->style->fill_angle1;
+  pitch1 = o_current->style->fill_pitch1;
+  angle2 = o_current->style->fill_angle2;
+  pitch2 = o_current->style->fill_pitch2;
 
-  switch(o_current->fill_type) {
+  switch(o_current->style->fill_type) {
     case FILLING_HOLLOW:
       angle1 = -1; angle2 = -1;
       pitch1 = 1; pitch2 = 1;
@@ -288,23 +286,23 @@ void o_circle_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
     fill_func = o_circle_fill_fill;
 
   (*fill_func) (w_current, o_drawing_color (w_current, o_current),
-                o_current->circle, o_current->fill_width,
+                o_current, o_current->style->fill_width,
                 angle1, pitch1, angle2, pitch2);
 
-  gschem_cairo_arc (w_current, o_current->line_width,
+  gschem_cairo_arc (w_current, o_current->style->line_width,
                                o_current->circle->center_x,
                                o_current->circle->center_y,
                                o_current->circle->radius, 0, 360);
 
   gschem_cairo_set_source_color (w_current,
                                  o_drawing_color (w_current, o_current));
-  if (o_current->fill_type == FILLING_FILL)
+  if (o_current->style->fill_type == FILLING_FILL)
     cairo_fill_preserve (w_current->cr);
-  gschem_cairo_stroke (w_current, o_current->line_type,
-                                  o_current->line_end,
-                                  o_current->line_width,
-                                  o_current->line_length,
-                                  o_current->line_space);
+  gschem_cairo_stroke (w_current, o_current->style->line_type,
+                                  o_current->style->line_end,
+                                  o_current->style->line_width,
+                                  o_current->style->line_length,
+                                  o_current->style->line_space);
 
   if (o_current->selected && w_current->draw_grips)
     o_circle_draw_grips (w_current, o_current);
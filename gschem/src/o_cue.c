@@ -126,7 +126,7 @@ static void draw_junction_cue (GSCHEM_TOPLEVEL *w_current,
 void o_cue_draw_lowlevel(GSCHEM_TOPLEVEL *w_current, OBJECT *object, int whichone)
 {
   int x, y;
-  GList *cl_current;
+  guint i;
   CONN *conn;
   int type, count = 0;
   int done = FALSE;
@@ -144,9 +144,8 @@ void o_cue_draw_lowlevel(GSCHEM_TOPLEVEL *w_current, OBJECT *object, int whichon
        (object->type == OBJ_PIN && object->pin_type == PIN_TYPE_BUS))
     bus_involved = TRUE;
 
-  cl_current = object->conn_list;
-  while (cl_current != NULL && !done) {
-    conn = (CONN *) cl_current->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len && !done; i++) {
+    conn = &g_array_index (object->conns, CONN, i);
    
     if (conn->x == x && conn->y == y) {
 
@@ -169,8 +168,6 @@ void o_cue_draw_lowlevel(GSCHEM_TOPLEVEL *w_current, OBJECT *object, int whichon
           break;
       }
     }
-
-    cl_current = g_list_next(cl_current);
   }
 
 #if DEBUG
@@ -210,11 +207,11 @@ void o_cue_draw_lowlevel(GSCHEM_TOPLEVEL *w_current, OBJECT *object, int whichon
  */
 void o_cue_draw_lowlevel_midpoints(GSCHEM_TOPLEVEL *w_current, OBJECT *object)
 {
-  GList *iter;
+  guint i;
   int bus_involved;
 
-  for (iter = object->conn_list; iter != NULL; iter = g_list_next (iter)) {
-    CONN *conn = iter->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+    CONN *conn = &g_array_index (object->conns, CONN, i);
 
     if (conn->type == CONN_MIDPOINT) {
       bus_involved = (object->type == OBJ_BUS ||
@@ -113,6 +113,10 @@ find_single_object (GSCHEM_TOPLEVEL *w_current, OBJECT *object,
  *  Tests for OBJECTS hit at a given set of coordinates. If
  *  change_selection is TRUE, it updates the page's selection.
  *
+ *  Only the objects near the coordinates are tested, as found through
+ *  the page's spatial index, so the cost does not grow with the number
+ *  of objects on the page.
+ *
  *  Find operations resume searching after the last object which was
  *  found, so multiple find operations at the same point will cycle
  *  through any objects on top of each other at this location.
@@ -129,45 +133,51 @@ gboolean o_find_object (GSCHEM_TOPLEVEL *w_current, int w_x, int w_y,
 {
   TOPLEVEL *toplevel = w_current->toplevel;
   int w_slack;
-  const GList *iter = NULL;
+  GList *candidates;
+  GList *start;
+  GList *iter;
+  gboolean found = FALSE;
 
   w_slack = WORLDabs (w_current, w_current->select_slack_pixels);
 
-  /* Decide whether to iterate over all object or start at the last
+  /* Candidates are returned in page order */
+  candidates = s_page_objects_in_region (toplevel, toplevel->page_current,
+                                         w_x - w_slack, w_y - w_slack,
+                                         w_x + w_slack, w_y + w_slack);
+
+  /* Decide whether to iterate over all candidates or start at the last
      found object. If there is more than one object below the
      (w_x/w_y) position, this will select the next object below the
      position point. You can change the selected object by clicking
      at the same place multiple times. */
+  start = candidates;
   if (toplevel->page_current->object_lastplace != NULL) {
-    /* NB: g_list_find doesn't declare its input const, so we cast */
-    iter = g_list_find ((GList *)s_page_objects (toplevel->page_current),
-                        toplevel->page_current->object_lastplace);
-    iter = g_list_next (iter);
+    /* Start at the first candidate after the last found object in
+       page order, even if the last found object is elsewhere */
+    for (start = candidates; start != NULL; start = g_list_next (start)) {
+      if (s_page_compare_order (toplevel->page_current, start->data,
+                                toplevel->page_current->object_lastplace) > 0)
+        break;
+    }
   }
 
   /* do first search (if we found any objects after the last found object) */
-  while (iter != NULL) {
-    OBJECT *o_current = iter->data;
-    if (find_single_object (w_current, o_current,
-                            w_x, w_y, w_slack, change_selection)) {
-      return TRUE;
-    }
-    iter = g_list_next (iter);
+  for (iter = start; iter != NULL && !found; iter = g_list_next (iter)) {
+    found = find_single_object (w_current, iter->data,
+                                w_x, w_y, w_slack, change_selection);
   }
 
-  /* now search from the beginning up until the object_lastplace */
-  for (iter = s_page_objects (toplevel->page_current);
-       iter != NULL; iter = g_list_next (iter)) {
-    OBJECT *o_current = iter->data;
-    if (find_single_object (w_current, o_current,
-                            w_x, w_y, w_slack, change_selection)) {
-      return TRUE;
-    }
-    /* break once we've inspected up to where we started the first loop */
-    if (o_current == toplevel->page_current->object_lastplace)
-      break;
+  /* now search from the beginning up until where the first search started */
+  for (iter = candidates; iter != start && !found; iter = g_list_next (iter)) {
+    found = find_single_object (w_current, iter->data,
+                                w_x, w_y, w_slack, change_selection);
   }
 
+  g_list_free (candidates);
+
+  if (found)
+    return TRUE;
+
   /* didn't find anything.... reset lastplace */
   toplevel->page_current->object_lastplace = NULL;
 
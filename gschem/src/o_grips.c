@@ -55,8 +55,8 @@
  *  Else, <B>*whichone</B> is unchanged and the function returns <B>NULL</B>.
  *
  *  A specific search function is provided for every kind of graphical object.
- *  The list of selected object is covered : each object is tested with the
- *  appropriate function.
+ *  The selected objects found near the point by the spatial index are
+ *  covered : each object is tested with the appropriate function.
  *
  *  \param [in]  w_current  The GSCHEM_TOPLEVEL object.
  *  \param [in]  x          Current x coordinate of pointer in world units.
@@ -69,6 +69,7 @@ OBJECT *o_grips_search_world(GSCHEM_TOPLEVEL *w_current, int x, int y, int *whic
   TOPLEVEL *toplevel = w_current->toplevel;
   OBJECT *object=NULL;
   OBJECT *found=NULL;
+  GList *candidates;
   GList *s_current;
   int size;
   int w_size;
@@ -81,44 +82,45 @@ OBJECT *o_grips_search_world(GSCHEM_TOPLEVEL *w_current, int x, int y, int *whic
   size = o_grips_size(w_current);
   w_size = WORLDabs (w_current, size );
 
-  s_current = geda_list_get_glist( toplevel->page_current->selection_list );
-  while (s_current != NULL) {
+  /* every grip lies within the bounds of its object, so only the
+   * selected objects the spatial index finds under the pointer can
+   * have a grip there */
+  candidates = s_page_objects_in_region (toplevel, toplevel->page_current,
+                                         x - w_size, y - w_size,
+                                         x + w_size, y + w_size);
+  s_current = candidates;
+  while (s_current != NULL && found == NULL) {
     object = (OBJECT *) s_current->data;
-    if (object) {
+    if (object && object->selected) {
       switch(object->type) {
         case(OBJ_ARC):
           /* check the grips of the arc object */
           found = o_grips_search_arc_world(w_current, object,
                                            x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         case(OBJ_BOX):
           /* check the grips of the box object */
           found = o_grips_search_box_world(w_current, object,
                                            x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         case(OBJ_PATH):
           /* check the grips of the path object */
           found = o_grips_search_path_world(w_current, object,
                                             x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         case(OBJ_PICTURE):
           /* check the grips of the picture object */
           found = o_grips_search_picture_world(w_current, object,
                                                x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         case(OBJ_CIRCLE):
           /* check the grips of the circle object */
           found = o_grips_search_circle_world(w_current, object,
                                               x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         case(OBJ_LINE):
@@ -129,7 +131,6 @@ OBJECT *o_grips_search_world(GSCHEM_TOPLEVEL *w_current, int x, int y, int *whic
           /* the function is the same for line, pin, net, bus */
           found = o_grips_search_line_world(w_current, object,
                                             x, y, w_size, whichone);
-          if(found != NULL) return found;
           break;
 
         default:
@@ -139,7 +140,8 @@ OBJECT *o_grips_search_world(GSCHEM_TOPLEVEL *w_current, int x, int y, int *whic
     s_current = g_list_next(s_current);
   }
 
-  return(NULL);
+  g_list_free (candidates);
+  return(found);
 }
 
 
@@ -53,17 +53,17 @@ void o_line_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
     return;
   }
 
-  gschem_cairo_line (w_current, o_current->line_end,
-                                o_current->line_width,
+  gschem_cairo_line (w_current, o_current->style->line_end,
+                                o_current->style->line_width,
                                 x1, y1, x2, y2);
 
   gschem_cairo_set_source_color (w_current,
                                  o_drawing_color (w_current, o_current));
-  gschem_cairo_stroke (w_current, o_current->line_type,
-                                  o_current->line_end,
-                                  o_current->line_width,
-                                  o_current->line_length,
-                                  o_current->line_space);
+  gschem_cairo_stroke (w_current, o_current->style->line_type,
+                                  o_current->style->line_end,
+                                  o_current->style->line_width,
+                                  o_current->style->line_length,
+                                  o_current->style->line_space);
 
   if (o_current->selected && w_current->draw_grips) {
     o_line_draw_grips (w_current, o_current);
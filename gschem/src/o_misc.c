@@ -120,6 +120,7 @@ void o_lock(GSCHEM_TOPLEVEL *w_current)
         object->selectable = FALSE;
         object->locked_color = object->color;
         object->color = LOCK_COLOR;
+        s_page_journal_note (object);
         w_current->toplevel->page_current->CHANGED=1;
       } else {
         s_log_message(_("Object already locked\n"));
@@ -158,6 +159,7 @@ void o_unlock(GSCHEM_TOPLEVEL *w_current)
         object->selectable = TRUE;
         object->color = object->locked_color;
         object->locked_color = -1;
+        s_page_journal_note (object);
         w_current->toplevel->page_current->CHANGED = 1;
       } else {
         s_log_message(_("Object already unlocked\n"));
@@ -640,18 +642,41 @@ o_update_component (GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
   return o_new;
 }
 
-/*! \brief Do autosave on all pages that are marked.
+/*! \brief A page backup written by the autosave thread */
+typedef struct {
+  int pid;              /* pid of the page backed up */
+  gchar *page_filename;
+  GList *objects;       /* private copy of the page's objects */
+  gint ops;             /* operations saved by this backup */
+  gboolean saved;
+  GString *log;         /* messages to log from the main thread */
+} AutosaveBackup;
+
+/*! \brief A batch of page backups */
+typedef struct {
+  TOPLEVEL *toplevel;
+  GList *backups;
+  GThread *thread;
+} AutosaveJob;
+
+/* The batch of backups being written, if any */
+static AutosaveJob *autosave_job = NULL;
+
+/*! \brief Write one autosave backup file.
  *  \par Function Description
- *  Looks for pages with the do_autosave_backup flag activated and
- *  autosaves them.
+ *  Saves the copied objects of \a backup next to the file of its page.
+ *  Serializing, syncing and renaming the file all happen in o_save().
+ *  This runs on the autosave thread, so it only touches \a backup and
+ *  never calls s_log_message(); messages are collected in the backup's
+ *  log instead.  Messages which libgeda logs while saving, such as
+ *  from o_picture_save(), are passed to the main loop by
+ *  x_log_message().
  *
- *  \param [in] w_current  The GSCHEM_TOPLEVEL object to search for autosave's.
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] backup    The AutosaveBackup to write.
  */
-void o_autosave_backups(GSCHEM_TOPLEVEL *w_current)
+static void o_autosave_write (TOPLEVEL *toplevel, AutosaveBackup *backup)
 {
-  TOPLEVEL *toplevel = w_current->toplevel;
-  GList *iter;
-  PAGE *p_save, *p_current;
   gchar *backup_filename;
   gchar *real_filename;
   gchar *only_filename;
@@ -660,8 +685,187 @@ void o_autosave_backups(GSCHEM_TOPLEVEL *w_current)
   mode_t mask;
   struct stat st;
 
-  /* save current page */
-  p_save = toplevel->page_current;
+  /* Get the real filename and file permissions */
+  real_filename = follow_symlinks (backup->page_filename, NULL);
+
+  if (real_filename == NULL) {
+    g_string_append_printf (backup->log, _("o_autosave_backups: Can't get the real filename of %s."), backup->page_filename);
+    return;
+  }
+
+  /* Get the directory in which the real filename lives */
+  dirname = g_path_get_dirname (real_filename);
+  only_filename = g_path_get_basename(real_filename);
+
+  backup_filename = g_strdup_printf("%s%c"AUTOSAVE_BACKUP_FILENAME_STRING,
+                                    dirname, G_DIR_SEPARATOR, only_filename);
+
+  /* If there is not an existing file with that name, compute the
+   * permissions and uid/gid that we will use for the newly-created file.
+   */
+
+  if (stat (real_filename, &st) != 0) {
+#if defined(HAVE_GETUID) && defined(HAVE_GETGID)
+      struct stat dir_st;
+      int result;
+#endif
+
+      /* Use default permissions */
+      saved_umask = umask(0);
+      st.st_mode = 0666 & ~saved_umask;
+      umask(saved_umask);
+#if defined(HAVE_GETUID) && defined(HAVE_GETGID)
+      st.st_uid = getuid ();
+
+      result = stat (dirname, &dir_st);
+
+      if (result == 0 && (dir_st.st_mode & S_ISGID))
+        st.st_gid = dir_st.st_gid;
+      else
+        st.st_gid = getgid ();
+#endif
+    }
+  g_free (dirname);
+  g_free (only_filename);
+  g_free (real_filename);
+
+  /* Make the backup file writable before saving a new one */
+  if ( g_file_test (backup_filename, G_FILE_TEST_EXISTS) &&
+       (! g_file_test (backup_filename, G_FILE_TEST_IS_DIR))) {
+    saved_umask = umask(0);
+    if (chmod(backup_filename, (S_IWRITE|S_IWGRP|S_IWOTH) &
+              ((~saved_umask) & 0777)) != 0) {
+      g_string_append_printf (backup->log, _("Could NOT set previous backup file [%s] read-write\n"),
+                              backup_filename);
+    }
+    umask(saved_umask);
+  }
+
+  /* o_save() writes a temporary file, syncs it to disk and renames it
+   * over the backup */
+  if (o_save (toplevel, backup->objects, backup_filename, NULL)) {
+
+    backup->saved = TRUE;
+
+    /* Make the backup file readonly so a 'rm *' command will ask
+       the user before deleting it */
+    saved_umask = umask(0);
+    mask = (S_IWRITE|S_IWGRP|S_IEXEC|S_IXGRP|S_IXOTH);
+    mask = (~mask)&0777;
+    mask &= ((~saved_umask) & 0777);
+    if (chmod(backup_filename,mask) != 0) {
+      g_string_append_printf (backup->log, _("Could NOT set backup file [%s] readonly\n"),
+                              backup_filename);
+    }
+    umask(saved_umask);
+  } else {
+    g_string_append_printf (backup->log, _("Could NOT save backup file [%s]\n"),
+                            backup_filename);
+  }
+  g_free (backup_filename);
+}
+
+/*! \brief Write all the backups of an autosave job.
+ *  \par Function Description
+ *  Writes each backup of \a job in turn.
+ *
+ *  \param [in] job  The AutosaveJob to write.
+ */
+static void o_autosave_write_all (AutosaveJob *job)
+{
+  GList *iter;
+
+  for (iter = job->backups; iter != NULL; iter = g_list_next (iter)) {
+    o_autosave_write (job->toplevel, iter->data);
+  }
+}
+
+/*! \brief Finish an autosave job on the main thread.
+ *  \par Function Description
+ *  Logs the messages of each backup of \a job, clears the autosave
+ *  state of the pages which were backed up, and frees \a job.
+ *
+ *  \param [in] job  The AutosaveJob to finish.
+ */
+static void o_autosave_finish (AutosaveJob *job)
+{
+  TOPLEVEL *toplevel = job->toplevel;
+  GList *iter;
+
+  for (iter = job->backups; iter != NULL; iter = g_list_next (iter)) {
+    AutosaveBackup *backup = iter->data;
+    PAGE *page;
+
+    if (backup->log->len > 0) {
+      s_log_message ("%s", backup->log->str);
+    }
+
+    /* The page may have been closed while the backup was written */
+    page = s_page_search_by_page_id (toplevel->pages, backup->pid);
+    if (backup->saved && page != NULL) {
+      page->ops_since_last_backup =
+        MAX (0, page->ops_since_last_backup - backup->ops);
+      page->do_autosave_backup = 0;
+    }
+
+    s_delete_object_glist (toplevel, backup->objects);
+    g_string_free (backup->log, TRUE);
+    g_free (backup->page_filename);
+    g_free (backup);
+  }
+  g_list_free (job->backups);
+
+  if (autosave_job == job) {
+    autosave_job = NULL;
+  }
+  g_free (job);
+}
+
+/*! \brief Main thread callback run when the autosave thread is done. */
+static gboolean o_autosave_done (gpointer data)
+{
+  AutosaveJob *job = data;
+
+  g_thread_join (job->thread);
+  o_autosave_finish (job);
+  return FALSE;
+}
+
+/*! \brief Entry point of the autosave thread. */
+static gpointer o_autosave_thread (gpointer data)
+{
+  AutosaveJob *job = data;
+
+  o_autosave_write_all (job);
+  g_idle_add (o_autosave_done, job);
+  return NULL;
+}
+
+/*! \brief Do autosave on all pages that are marked.
+ *  \par Function Description
+ *  Looks for pages with the do_autosave_backup flag activated and
+ *  autosaves them.
+ *
+ *  Only a copy of the objects of each page is made here; the backup
+ *  files are written by a separate thread, so that the user interface
+ *  never waits for them.  Nothing is done while a previous autosave is
+ *  still being written, and the pages stay marked until their backup
+ *  has been saved.
+ *
+ *  \param [in] w_current  The GSCHEM_TOPLEVEL object to search for autosave's.
+ */
+void o_autosave_backups(GSCHEM_TOPLEVEL *w_current)
+{
+  TOPLEVEL *toplevel = w_current->toplevel;
+  GList *iter;
+  GList *backups = NULL;
+  PAGE *p_current;
+  AutosaveJob *job;
+  GError *err = NULL;
+
+  if (autosave_job != NULL) {
+    return;
+  }
 
   for ( iter = geda_list_get_glist( toplevel->pages );
         iter != NULL;
@@ -673,89 +877,55 @@ void o_autosave_backups(GSCHEM_TOPLEVEL *w_current)
       continue;
     }
     if (p_current->ops_since_last_backup != 0) {
-      /* make p_current the current page of toplevel */
-      s_page_goto (toplevel, p_current);
+      AutosaveBackup *backup = g_new0 (AutosaveBackup, 1);
 
-      /* Get the real filename and file permissions */
-      real_filename = follow_symlinks (p_current->page_filename, NULL);
+      backup->pid = p_current->pid;
+      backup->page_filename = g_strdup (p_current->page_filename);
+      backup->objects = o_glist_copy_all (toplevel,
+                                          s_page_objects (p_current), NULL);
+      backup->ops = p_current->ops_since_last_backup;
+      backup->log = g_string_new ("");
 
-      if (real_filename == NULL) {
-        s_log_message (_("o_autosave_backups: Can't get the real filename of %s."), p_current->page_filename);
-      } else {
-        /* Get the directory in which the real filename lives */
-        dirname = g_path_get_dirname (real_filename);
-        only_filename = g_path_get_basename(real_filename);
-
-        backup_filename = g_strdup_printf("%s%c"AUTOSAVE_BACKUP_FILENAME_STRING,
-                                          dirname, G_DIR_SEPARATOR, only_filename);
-
-        /* If there is not an existing file with that name, compute the
-         * permissions and uid/gid that we will use for the newly-created file.
-         */
-
-        if (stat (real_filename, &st) != 0) {
-#if defined(HAVE_GETUID) && defined(HAVE_GETGID)
-            struct stat dir_st;
-            int result;
-#endif
+      backups = g_list_prepend (backups, backup);
+    }
+  }
 
-            /* Use default permissions */
-            saved_umask = umask(0);
-            st.st_mode = 0666 & ~saved_umask;
-            umask(saved_umask);
-#if defined(HAVE_GETUID) && defined(HAVE_GETGID)
-            st.st_uid = getuid ();
+  if (backups == NULL) {
+    return;
+  }
 
-            result = stat (dirname, &dir_st);
+  job = g_new0 (AutosaveJob, 1);
+  job->toplevel = toplevel;
+  job->backups = g_list_reverse (backups);
+  autosave_job = job;
+
+  job->thread = g_thread_create (o_autosave_thread, job, TRUE, &err);
+  if (job->thread == NULL) {
+    /* Fall back to writing the backups right away */
+    s_log_message (_("Could not start autosave thread: %s\n"), err->message);
+    g_error_free (err);
+    o_autosave_write_all (job);
+    o_autosave_finish (job);
+  }
+}
 
-            if (result == 0 && (dir_st.st_mode & S_ISGID))
-              st.st_gid = dir_st.st_gid;
-            else
-              st.st_gid = getgid ();
-#endif
-          }
-        g_free (dirname);
-        g_free (only_filename);
-        g_free (real_filename);
-
-        /* Make the backup file writable before saving a new one */
-        if ( g_file_test (backup_filename, G_FILE_TEST_EXISTS) &&
-             (! g_file_test (backup_filename, G_FILE_TEST_IS_DIR))) {
-          saved_umask = umask(0);
-          if (chmod(backup_filename, (S_IWRITE|S_IWGRP|S_IWOTH) &
-                    ((~saved_umask) & 0777)) != 0) {
-            s_log_message (_("Could NOT set previous backup file [%s] read-write\n"),
-                           backup_filename);
-          }
-          umask(saved_umask);
-        }
+/*! \brief Wait for the autosave backups of a window.
+ *  \par Function Description
+ *  Waits until the autosave thread, if it is writing backups of the
+ *  pages of \a w_current, is done, and finishes its job.  This must
+ *  be called before the window's TOPLEVEL is freed.
+ *
+ *  \param [in] w_current  The GSCHEM_TOPLEVEL object being closed.
+ */
+void o_autosave_wait (GSCHEM_TOPLEVEL *w_current)
+{
+  AutosaveJob *job = autosave_job;
 
-        if (o_save (toplevel,
-                    s_page_objects (toplevel->page_current),
-                    backup_filename, NULL)) {
-
-          p_current->ops_since_last_backup = 0;
-                p_current->do_autosave_backup = 0;
-
-          /* Make the backup file readonly so a 'rm *' command will ask
-             the user before deleting it */
-          saved_umask = umask(0);
-          mask = (S_IWRITE|S_IWGRP|S_IEXEC|S_IXGRP|S_IXOTH);
-          mask = (~mask)&0777;
-          mask &= ((~saved_umask) & 0777);
-          if (chmod(backup_filename,mask) != 0) {
-            s_log_message (_("Could NOT set backup file [%s] readonly\n"),
-                           backup_filename);
-          }
-          umask(saved_umask);
-        } else {
-          s_log_message (_("Could NOT save backup file [%s]\n"),
-                         backup_filename);
-        }
-        g_free (backup_filename);
-      }
-    }
+  if (job == NULL || job->toplevel != w_current->toplevel) {
+    return;
   }
-  /* restore current page */
-  s_page_goto (toplevel, p_save);
+
+  g_thread_join (job->thread);
+  g_source_remove_by_user_data (job);
+  o_autosave_finish (job);
 }
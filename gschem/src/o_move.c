@@ -80,6 +80,7 @@ void o_move_start(GSCHEM_TOPLEVEL *w_current, int w_x, int w_y)
  *
  */
 static void o_move_end_lowlevel_glist (GSCHEM_TOPLEVEL *w_current,
+                                       CONN_UPDATE *update,
                                        GList *list,
                                        int diff_x, int diff_y)
 {
@@ -89,20 +90,23 @@ static void o_move_end_lowlevel_glist (GSCHEM_TOPLEVEL *w_current,
   iter = list;
   while (iter != NULL) {
     object = (OBJECT *)iter->data;
-    o_move_end_lowlevel (w_current, object, diff_x, diff_y);
+    o_move_end_lowlevel (w_current, update, object, diff_x, diff_y);
     iter = g_list_next (iter);
   }
 }
 
 
-/*! \todo Finish function documentation!!!
- *  \brief
+/*! \brief Move an object to its final position
  *  \par Function Description
- *
+ *  Translates <b>object</b> by <b>diff_x</b>, <b>diff_y</b>.  If
+ *  <b>update</b> is not NULL, the object must already have been added
+ *  to it, and is reconnected when the update ends.  Otherwise the
+ *  object is disconnected and reconnected here.
  */
 void o_move_end_lowlevel (GSCHEM_TOPLEVEL *w_current,
-                         OBJECT *object,
-                         int diff_x, int diff_y)
+                          CONN_UPDATE *update,
+                          OBJECT *object,
+                          int diff_x, int diff_y)
 {
   TOPLEVEL *toplevel = w_current->toplevel;
 
@@ -111,9 +115,11 @@ void o_move_end_lowlevel (GSCHEM_TOPLEVEL *w_current,
     case (OBJ_NET):
     case (OBJ_BUS):
     case (OBJ_PIN):
-      s_conn_remove_object (toplevel, object);
+      if (update == NULL)
+        s_conn_remove_object (toplevel, object);
       o_translate_world (toplevel, diff_x, diff_y, object);
-      s_conn_update_object (toplevel, object);
+      if (update == NULL)
+        s_conn_update_object (toplevel, object);
       break;
 
     default:
@@ -136,6 +142,7 @@ void o_move_end(GSCHEM_TOPLEVEL *w_current)
   int left, top, right, bottom;
   GList *s_iter;
   GList *rubbernet_objects = NULL; 
+  CONN_UPDATE *update;
 
   object = o_select_return_first_object(w_current);
 
@@ -152,8 +159,12 @@ void o_move_end(GSCHEM_TOPLEVEL *w_current)
   o_move_invalidate_rubber (w_current, FALSE);
   w_current->rubber_visible = 0;
 
+  /* Reconnect everything that moves in one go, once it has all moved */
+  update = s_conn_update_begin (toplevel);
+
   if (w_current->netconn_rubberband) {
-    o_move_end_rubberband (w_current, diff_x, diff_y, &rubbernet_objects);
+    o_move_end_rubberband (w_current, update, diff_x, diff_y,
+                           &rubbernet_objects);
   }
 
   /* Unset the dont_redraw flag on rubberbanded objects.
@@ -175,6 +186,7 @@ void o_move_end(GSCHEM_TOPLEVEL *w_current)
       exit(-1);
     }
 
+    s_conn_update_add_object (update, object);
 
     switch (object->type) {
       case (OBJ_COMPLEX):
@@ -188,7 +200,8 @@ void o_move_end(GSCHEM_TOPLEVEL *w_current)
         object->complex->x = object->complex->x + diff_x;
         object->complex->y = object->complex->y + diff_y;
 
-        o_move_end_lowlevel_glist (w_current, object->complex->prim_objs,
+        o_move_end_lowlevel_glist (w_current, update,
+                                   object->complex->prim_objs,
                                    diff_x, diff_y);
 
 
@@ -203,13 +216,15 @@ void o_move_end(GSCHEM_TOPLEVEL *w_current)
         break;
 
       default:
-        o_move_end_lowlevel (w_current, object, diff_x, diff_y);
+        o_move_end_lowlevel (w_current, update, object, diff_x, diff_y);
         break;
     }
 
     s_current = g_list_next(s_current);
   }
 
+  s_conn_update_end (update);
+
   /* Remove the undo saved in o_move_start */
   o_undo_remove_last_undo(w_current);
 
@@ -440,7 +455,7 @@ int o_move_return_whichone(OBJECT * object, int x, int y)
 void o_move_check_endpoint(GSCHEM_TOPLEVEL *w_current, OBJECT * object)
 {
   TOPLEVEL *toplevel = w_current->toplevel;
-  GList *cl_current;
+  guint i;
   CONN *c_current;
   OBJECT *other;
   int whichone;
@@ -454,11 +469,9 @@ void o_move_check_endpoint(GSCHEM_TOPLEVEL *w_current, OBJECT * object)
     return;
   }
 
-  for (cl_current = object->conn_list;
-       cl_current != NULL;
-       cl_current = g_list_next(cl_current)) {
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
 
-    c_current = (CONN *) cl_current->data;
+    c_current = &g_array_index (object->conns, CONN, i);
     other = c_current->other_object;
 
     if (other == NULL)
@@ -505,7 +518,7 @@ void o_move_check_endpoint(GSCHEM_TOPLEVEL *w_current, OBJECT * object)
 
 #if DEBUG
     printf ("FOUND: %s type: %d, whichone: %d, x,y: %d %d\n",
-            other->name, c_current->type,
+            o_get_name (other), c_current->type,
             whichone, c_current->x, c_current->y);
 
     printf("other x,y: %d %d\n", c_current->x, c_current->y);
@@ -591,6 +604,7 @@ int o_move_zero_length(OBJECT * object)
  *
  */
 void o_move_end_rubberband (GSCHEM_TOPLEVEL *w_current,
+                            CONN_UPDATE *update,
                             int w_dx, int w_dy,
                             GList** objects)
 {
@@ -609,9 +623,6 @@ void o_move_end_rubberband (GSCHEM_TOPLEVEL *w_current,
     if (object->type == OBJ_NET ||
         object->type == OBJ_BUS) {
 
-      /* remove the object's connections */
-      s_conn_remove_object (toplevel, object);
-
       object->line->x[whichone] += w_dx;
       object->line->y[whichone] += w_dy;
 
@@ -621,10 +632,23 @@ void o_move_end_rubberband (GSCHEM_TOPLEVEL *w_current,
         o_delete (w_current, object);
         continue;
       }
+    }
+  }
+
+  /* Only add the surviving nets and buses to the connection update,
+   * as nothing in it may be deleted before it ends. */
+  for (s_iter = w_current->stretch_list;
+       s_iter != NULL; s_iter = g_list_next (s_iter)) {
+    STRETCH *s_current = s_iter->data;
+    OBJECT *object = s_current->object;
+
+    if (object->type == OBJ_NET ||
+        object->type == OBJ_BUS) {
+
+      s_conn_update_add_object (update, object);
 
       o_recalc_single_object (toplevel, object);
       s_tile_update_object (toplevel, object);
-      s_conn_update_object (toplevel, object);
       *objects = g_list_append (*objects, object);
     }
   }
@@ -293,11 +293,33 @@ void o_net_guess_direction(GSCHEM_TOPLEVEL *w_current,
   g_list_free(objectlists);
 }
 
+/*! \brief Check whether an object is on screen
+ *  \par Function Description
+ *  Filter for s_page_find_nearest(), which accepts only the objects
+ *  whose bounds are visible in the window \a data.
+ *
+ *  \param [in] object  The OBJECT to check.
+ *  \param [in] data    The GSCHEM_TOPLEVEL of the window.
+ *  \return TRUE if \a object is on screen, FALSE otherwise.
+ */
+static gboolean o_net_magnetic_visible (OBJECT *object, void *data)
+{
+  GSCHEM_TOPLEVEL *w_current = data;
+  int left, top, right, bottom;
+
+  if (!world_get_single_object_bounds (w_current->toplevel, object,
+                                       &left, &top, &right, &bottom))
+    return FALSE;
+
+  return visible (w_current, left, top, right, bottom);
+}
+
 /*! \brief find the closest possible location to connect to
  *  \par Function Description
- *  This function calculates the distance to all connectable objects 
- *  and searches the closest connection point.
- *  It searches for pins, nets and busses.
+ *  This function asks the spatial index of the current page for the
+ *  closest pin, net and bus and picks the best connection point
+ *  among them, weighting each kind of object by its magnetic weight.
+ *  Objects which are off screen are skipped.
  *  
  *  The connection point is stored in GSCHEM_TOPLEVEL->magnetic_wx and
  *  GSCHEM_TOPLEVEL->magnetic_wy. If no connection is found. Both variables
@@ -306,130 +328,57 @@ void o_net_guess_direction(GSCHEM_TOPLEVEL *w_current,
 void o_net_find_magnetic(GSCHEM_TOPLEVEL *w_current,
 			 int w_x, int w_y)
 {
+  static const struct {
+    int type;
+    int reach;
+    double weight;
+  } magnetic[] = {
+    { OBJ_PIN, MAGNETIC_PIN_REACH, MAGNETIC_PIN_WEIGHT },
+    { OBJ_NET, MAGNETIC_NET_REACH, MAGNETIC_NET_WEIGHT },
+    { OBJ_BUS, MAGNETIC_BUS_REACH, MAGNETIC_BUS_WEIGHT },
+  };
   TOPLEVEL *toplevel = w_current->toplevel;
-  int x1, x2, y1, y2, min_x, min_y, w_magnetic_reach;
-  double mindist, minbest, dist1, dist2;
-  double weight, min_weight;
-  int magnetic_reach = 0;
-  OBJECT *o_current;
+  int magnetic_reach, w_magnetic_reach;
+  int min_x, min_y;
+  double mindist, minbest = 0;
+  double weight, min_weight = 0;
   OBJECT *o_magnetic = NULL;
-  GList *objectlists, *iter1, *iter2;
-
-  minbest = min_x = min_y = 0;
-  min_weight = 0;
+  int best = 0;
+  int i;
 
   /* max distance of all the different reaches */
   magnetic_reach = max(MAGNETIC_PIN_REACH, MAGNETIC_NET_REACH);
   magnetic_reach = max(magnetic_reach, MAGNETIC_BUS_REACH);
   w_magnetic_reach = WORLDabs (w_current, magnetic_reach);
 
-  /* get the objects of the tiles around the reach region */
-  x1 = w_x - w_magnetic_reach;
-  y1 = w_y - w_magnetic_reach;
-  x2 = w_x + w_magnetic_reach;
-  y2 = w_y + w_magnetic_reach;
-  objectlists = s_tile_get_objectlists(toplevel, toplevel->page_current,
-                                       x1, y1, x2, y2);
-
-  for (iter1 = objectlists; iter1 != NULL; iter1 = g_list_next(iter1)) {
-    for (iter2 = (GList*) iter1->data; iter2 != NULL; iter2 = g_list_next(iter2)) {
-      o_current = (OBJECT*) iter2->data;
-
-      if (!visible (w_current,  o_current->w_left, o_current->w_top,
-		   o_current->w_right, o_current->w_bottom))
-	continue; /* skip invisible objects */
-
-      if (o_current->type == OBJ_PIN) {
-	min_x = o_current->line->x[o_current->whichend];
-	min_y = o_current->line->y[o_current->whichend];
-
-	mindist = sqrt((double) (w_x - min_x)*(w_x - min_x)
-		       + (double) (w_y - min_y)*(w_y - min_y));
-	weight = mindist / MAGNETIC_PIN_WEIGHT;
-      }
-
-      else if (o_current->type == OBJ_NET
-	       || o_current->type == OBJ_BUS) {
-	/* we have 3 possible points to connect: 
-	   2 endpoints and 1 midpoint point */
-	x1 = o_current->line->x[0];
-	y1 = o_current->line->y[0];
-	x2 = o_current->line->x[1];
-	y2 = o_current->line->y[1];
-	/* endpoint tests */
-	dist1 = sqrt((double) (w_x - x1)*(w_x - x1)
-		     + (double) (w_y - y1)*(w_y - y1));
-	dist2 = sqrt((double) (w_x - x2)*(w_x - x2)
-		     + (double) (w_y - y2)*(w_y - y2));
-	if (dist1 < dist2) {
-	  min_x = x1;
-	  min_y = y1;
-	  mindist = dist1;
-	}
-	else {
-	  min_x = x2;
-	  min_y = y2;
-	  mindist = dist2;
-	}
-      
-	/* midpoint tests */
-	if ((x1 == x2)  /* vertical net */
-	    && ((y1 >= w_y && w_y >= y2)
-		|| (y2 >= w_y && w_y >= y1))) {
-	  if (abs(w_x - x1) < mindist) {
-	    mindist = abs(w_x - x1);
-	    min_x = x1;
-	    min_y = w_y;
-	  }
-	} 
-	if ((y1 == y2)  /* horitontal net */
-	    && ((x1 >= w_x && w_x >= x2)
-		|| (x2 >= w_x && w_x >= x1))) {  
-	  if (abs(w_y - y1) < mindist) {
-	    mindist = abs(w_y - y1);
-	    min_x = w_x;
-	    min_y = y1;
-	  }
-	}
-
-	if (o_current->type == OBJ_BUS)
-	  weight = mindist / MAGNETIC_BUS_WEIGHT;
-	else /* OBJ_NET */
-	  weight = mindist / MAGNETIC_NET_WEIGHT;
-      }
-      else { /* neither pin nor net or bus */
-	continue;
-      }
-
-      if (o_magnetic == NULL
-	  || weight < min_weight) {
-	minbest = mindist;
-	min_weight = weight;
-	o_magnetic = o_current;
-	w_current->magnetic_wx = min_x;
-	w_current->magnetic_wy = min_y;
-      }
+  for (i = 0; i < sizeof (magnetic) / sizeof (magnetic[0]); i++) {
+    OBJECT *o_current;
+
+    o_current = s_page_find_nearest (toplevel, toplevel->page_current,
+                                     w_x, w_y, w_magnetic_reach,
+                                     magnetic[i].type,
+                                     o_net_magnetic_visible, w_current,
+                                     &min_x, &min_y, &mindist);
+    if (o_current == NULL)
+      continue;
+
+    weight = mindist / magnetic[i].weight;
+    if (o_magnetic == NULL || weight < min_weight) {
+      minbest = mindist;
+      min_weight = weight;
+      o_magnetic = o_current;
+      best = i;
+      w_current->magnetic_wx = min_x;
+      w_current->magnetic_wy = min_y;
     }
   }
 
   /* check whether we found an object and if it's close enough */
-  if (o_magnetic != NULL) {
-    switch (o_magnetic->type) {
-    case (OBJ_PIN): magnetic_reach = MAGNETIC_PIN_REACH; break;
-    case (OBJ_NET): magnetic_reach = MAGNETIC_NET_REACH; break;
-    case (OBJ_BUS): magnetic_reach = MAGNETIC_BUS_REACH; break;
-    }
-    if (minbest > WORLDabs (w_current, magnetic_reach)) {
-      w_current->magnetic_wx = -1;
-      w_current->magnetic_wy = -1;
-    }
-  }
-  else {
+  if (o_magnetic == NULL
+      || minbest > WORLDabs (w_current, magnetic[best].reach)) {
     w_current->magnetic_wx = -1;
     w_current->magnetic_wy = -1;
   }
-
-  g_list_free(objectlists);
 }
 
 /*! \brief calcutates the net route to the magnetic marker
@@ -621,12 +570,12 @@ int o_net_end(GSCHEM_TOPLEVEL *w_current, int w_x, int w_y)
 
 #if DEBUG 
       printf("primary:\n"); 
-      s_conn_print(new_net->conn_list);
+      s_conn_print(new_net->conns);
 #endif
 
       /* Go off and search for valid connection on this newly created net */
       found_primary_connection = s_conn_net_search(new_net, 1, 
-                                                   new_net->conn_list);
+                                                   new_net->conns);
       if (found_primary_connection)
       {
       	/* if a net connection is found, reset start point of next net */
@@ -654,7 +603,7 @@ int o_net_end(GSCHEM_TOPLEVEL *w_current, int w_x, int w_y)
       o_net_add_busrippers (w_current, new_net, prev_conn_objects);
       g_list_free (prev_conn_objects);
 #if DEBUG
-      s_conn_print(new_net->conn_list);
+      s_conn_print(new_net->conns);
 #endif
   }
 
@@ -888,19 +837,18 @@ int o_net_add_busrippers(GSCHEM_TOPLEVEL *w_current, OBJECT *net_obj,
       int net_orientation = o_net_orientation(net_obj);
 
       /* find the CONN structure which is associated with this object */
-      GList *cl_current2 = net_obj->conn_list;
+      guint j;
       done = FALSE;
-      while (cl_current2 != NULL && !done) {
-	CONN *tmp_conn = (CONN *) cl_current2->data;
+      for (j = 0; net_obj->conns != NULL && j < net_obj->conns->len && !done;
+           j++) {
+	CONN *tmp_conn = &g_array_index (net_obj->conns, CONN, j);
 
-	if (tmp_conn && tmp_conn->other_object &&
+	if (tmp_conn->other_object &&
 	    tmp_conn->other_object == bus_object) {
 
 	  found_conn = tmp_conn;
 	  done = TRUE;
 	}
-
-	cl_current2 = g_list_next(cl_current2);
       }
 
       if (!found_conn) {
@@ -911,7 +859,7 @@ int o_net_add_busrippers(GSCHEM_TOPLEVEL *w_current, OBJECT *net_obj,
       
       /* now deal with the found connection */
       if (bus_orientation == HORIZONTAL && net_orientation == VERTICAL) {
-	/* printf("found horiz bus %s %d!\n", bus_object->name, 
+	/* printf("found horiz bus %s %d!\n", o_get_name (bus_object), 
            found_conn->whichone);*/
 
         sign = bus_object->bus_ripper_direction;
@@ -1018,7 +966,7 @@ int o_net_add_busrippers(GSCHEM_TOPLEVEL *w_current, OBJECT *net_obj,
       } else if (bus_orientation == VERTICAL &&
 		 net_orientation == HORIZONTAL) {
 
-	/* printf("found vert bus %s %d!\n", bus_object->name,
+	/* printf("found vert bus %s %d!\n", o_get_name (bus_object),
            found_conn->whichone); */
 
         sign = bus_object->bus_ripper_direction;
@@ -33,7 +33,7 @@
 
 
 typedef void (*FILL_FUNC) (GSCHEM_TOPLEVEL *w_current,
-                           COLOR *color, PATH *path,
+                           COLOR *color, OBJECT *object,
                            gint fill_width,
                            gint angle1, gint pitch1, gint angle2, gint pitch2);
 
@@ -56,7 +56,7 @@ static void path_path (GSCHEM_TOPLEVEL *w_current, OBJECT *object)
   double fx2 = 0.0, fy2 = 0.0;
   double fx3 = 0.0, fy3 = 0.0;
 
-  line_width = SCREENabs (w_current, object->line_width);
+  line_width = SCREENabs (w_current, object->style->line_width);
   if (line_width <= 0) {
     line_width = 1;
   }
@@ -162,7 +162,7 @@ static PATH *path_copy_modify (PATH *path, int dx, int dy,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] path        The PATH object to draw
+ *  \param [in] object      Path OBJECT to fill.
  *  \param [in] fill_width  PATH pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -170,7 +170,7 @@ static PATH *path_copy_modify (PATH *path, int dx, int dy,
  *  \param [in] pitch2      2nd pitch for pattern.
  */
 static void o_path_fill_hollow (GSCHEM_TOPLEVEL *w_current,
-                                COLOR *color, PATH *path,
+                                COLOR *color, OBJECT *object,
                                 gint fill_width,
                                 gint angle1, gint pitch1,
                                 gint angle2, gint pitch2)
@@ -187,7 +187,7 @@ static void o_path_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] path        The PATH object to draw
+ *  \param [in] object      Path OBJECT to fill.
  *  \param [in] fill_width  PATH pattern fill width.
  *  \param [in] angle1      (unused)
  *  \param [in] pitch1      (unused)
@@ -195,7 +195,7 @@ static void o_path_fill_hollow (GSCHEM_TOPLEVEL *w_current,
  *  \param [in] pitch2      (unused)
  */
 static void o_path_fill_fill (GSCHEM_TOPLEVEL *w_current,
-                              COLOR *color, PATH *path,
+                              COLOR *color, OBJECT *object,
                               gint fill_width,
                               gint angle1, gint pitch1,
                               gint angle2, gint pitch2)
@@ -214,7 +214,7 @@ static void o_path_fill_fill (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] path        The PATH object to draw
+ *  \param [in] object      Path OBJECT to fill.
  *  \param [in] fill_width  PATH pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -222,7 +222,7 @@ static void o_path_fill_fill (GSCHEM_TOPLEVEL *w_current,
  *  \param [in] pitch2      (unused)
  */
 static void o_path_fill_hatch (GSCHEM_TOPLEVEL *w_current,
-                               COLOR *color, PATH *path,
+                               COLOR *color, OBJECT *object,
                                gint fill_width,
                                gint angle1, gint pitch1,
                                gint angle2, gint pitch2)
@@ -230,10 +230,12 @@ static void o_path_fill_hatch (GSCHEM_TOPLEVEL *w_current,
   int i;
   GArray *lines;
 
-  gschem_cairo_set_source_color (w_current, color);
+  /* Computed once and kept with the object until it changes */
+  lines = m_hatch_object (object);
+  if (lines == NULL)
+    return;
 
-  lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-  m_hatch_path (path, angle1, pitch1, lines);
+  gschem_cairo_set_source_color (w_current, color);
 
   for (i=0; i < lines->len; i++) {
     LINE *line = &g_array_index (lines, LINE, i);
@@ -242,8 +244,6 @@ static void o_path_fill_hatch (GSCHEM_TOPLEVEL *w_current,
                                                         line->x[1], line->y[1]);
   }
   gschem_cairo_stroke (w_current, TYPE_SOLID, END_NONE, fill_width, -1, -1);
-
-  g_array_free (lines, TRUE);
 }
 
 
@@ -259,7 +259,7 @@ static void o_path_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  *
  *  \param [in] w_current   Schematic top level
  *  \param [in] color       Box fill color.
- *  \param [in] path        The PATH object to draw
+ *  \param [in] object      Path OBJECT to fill.
  *  \param [in] fill_width  PATH pattern fill width.
  *  \param [in] angle1      1st angle for pattern.
  *  \param [in] pitch1      1st pitch for pattern.
@@ -267,15 +267,14 @@ static void o_path_fill_hatch (GSCHEM_TOPLEVEL *w_current,
  *  \param [in] pitch2      2nd pitch for pattern.
  */
 static void o_path_fill_mesh (GSCHEM_TOPLEVEL *w_current,
-                              COLOR *color, PATH *path,
+                              COLOR *color, OBJECT *object,
                               gint fill_width,
                               gint angle1, gint pitch1,
                               gint angle2, gint pitch2)
 {
-  o_path_fill_hatch (w_current, color, path,
-                     fill_width, angle1, pitch1, -1, -1);
-  o_path_fill_hatch (w_current, color, path,
-                     fill_width, angle2, pitch2, -1, -1);
+  /* the object's hatch lines already hold both sets */
+  o_path_fill_hatch (w_current, color, object,
+                     fill_width, angle1, pitch1, angle2, pitch2);
 }
 
 
@@ -299,12 +298,12 @@ void o_path_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
     return;
   }
 
-  angle1 = o_current->fill_angle1;
-  pitch1 = o_current->fill_pitch1;
-  angle2 = o_current->fill_angle2;
-  pitch2 = o_current->fill_pitch2;
+  angle1 = o_current->style->fill_angle1;
+  pitch1 = o_current->style->fill_pitch1;
+  angle2 = o_current->style->fill_angle2;
+  pitch2 = o_current->style->fill_pitch2;
 
-  switch(o_current->fill_type) {
+  switch(o_current->style->fill_type) {
     case FILLING_HOLLOW:
       angle1 = -1; angle2 = -1;
       pitch1 = 1; pitch2 = 1;
@@ -345,21 +344,21 @@ void o_path_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
   }
 
   (*fill_func) (w_current, o_drawing_color (w_current, o_current),
-                path, o_current->fill_width, angle1, pitch1, angle2, pitch2);
+                o_current, o_current->style->fill_width, angle1, pitch1, angle2, pitch2);
 
   path_path (w_current, o_current);
 
   gschem_cairo_set_source_color (w_current,
                                  o_drawing_color (w_current, o_current));
 
-  if (o_current->fill_type == FILLING_FILL)
+  if (o_current->style->fill_type == FILLING_FILL)
     cairo_fill_preserve (w_current->cr);
 
-  gschem_cairo_stroke (w_current, o_current->line_type,
-                                  o_current->line_end,
-                                  o_current->line_width,
-                                  o_current->line_length,
-                                  o_current->line_space);
+  gschem_cairo_stroke (w_current, o_current->style->line_type,
+                                  o_current->style->line_end,
+                                  o_current->style->line_width,
+                                  o_current->style->line_length,
+                                  o_current->style->line_space);
 
   if (o_current->selected && w_current->draw_grips) {
     o_path_draw_grips (w_current, o_current);
@@ -446,7 +445,7 @@ void o_path_draw_place (GSCHEM_TOPLEVEL *w_current, int dx, int dy, OBJECT *o_cu
   g_return_if_fail (o_current->path != NULL);
 
   /* Setup a fake object to pass the drawing routine */
-  object.line_width = 0; /* clamped to 1 pixel in circle_path */
+  object.style = s_style_default (); /* zero width, clamped to 1 pixel in circle_path */
   object.path = path_copy_modify (o_current->path, dx, dy, 0, 0, -1);
 
   path_path (w_current, &object);
@@ -537,7 +536,7 @@ void o_path_draw_rubber (GSCHEM_TOPLEVEL *w_current)
   OBJECT object;
 
   /* Setup a fake object to pass the drawing routine */
-  object.line_width = 0; /* clamped to 1 pixel in circle_path */
+  object.style = s_style_default (); /* zero width, clamped to 1 pixel in circle_path */
   object.path = path_copy_modify (w_current->which_object->path, 0, 0,
                                   w_current->second_wx,
                                   w_current->second_wy, w_current->which_grip);
@@ -302,6 +302,7 @@ void o_picture_draw_rubber (GSCHEM_TOPLEVEL *w_current)
 void o_picture_draw (GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
 {
   int s_upper_x, s_upper_y, s_lower_x, s_lower_y;
+  int s_width, s_height;
   GdkPixbuf *pixbuf;
 
   g_return_if_fail (w_current != NULL);
@@ -309,7 +310,18 @@ void o_picture_draw (GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
   g_return_if_fail (o_current != NULL);
   g_return_if_fail (o_current->picture != NULL);
 
-  pixbuf = o_picture_get_pixbuf (w_current->toplevel, o_current);
+  /* Use a downscaled copy of the image when zoomed out */
+  s_width = SCREENabs (w_current, abs (o_current->picture->upper_x -
+                                       o_current->picture->lower_x));
+  s_height = SCREENabs (w_current, abs (o_current->picture->upper_y -
+                                        o_current->picture->lower_y));
+  if (o_current->picture->angle == 90 || o_current->picture->angle == 270) {
+    pixbuf = o_picture_get_pixbuf_for_size (w_current->toplevel, o_current,
+                                            s_height, s_width);
+  } else {
+    pixbuf = o_picture_get_pixbuf_for_size (w_current->toplevel, o_current,
+                                            s_width, s_height);
+  }
 
   /* If the image failed to load, get the fallback image. */
   if (pixbuf == NULL) pixbuf = o_picture_get_fallback_pixbuf (w_current->toplevel);
@@ -348,10 +360,8 @@ void o_picture_draw (GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
 
   cairo_translate (w_current->cr, s_upper_x, s_upper_y);
   cairo_scale (w_current->cr,
-    (float)SCREENabs (w_current, abs (o_current->picture->upper_x -
-                                      o_current->picture->lower_x)) / orig_width,
-    (float)SCREENabs (w_current, abs (o_current->picture->upper_y -
-                                      o_current->picture->lower_y)) / orig_height);
+               (float)s_width / orig_width,
+               (float)s_height / orig_height);
 
   /* Evil magic translates picture origin to the right position for a given rotation */
   switch (o_current->picture->angle) {
@@ -50,7 +50,7 @@ void o_pin_draw(GSCHEM_TOPLEVEL *w_current, OBJECT *o_current)
   }
 
   if (toplevel->pin_style == THICK)
-    size = o_current->line_width;
+    size = o_current->style->line_width;
 
   end = o_get_line_end (toplevel->print_output_capstyle);
 
@@ -88,7 +88,7 @@ void o_pin_draw_place (GSCHEM_TOPLEVEL *w_current, int dx, int dy, OBJECT *o_cur
   }
 
   if (toplevel->pin_style == THICK)
-    size = o_current->line_width;
+    size = o_current->style->line_width;
 
   gschem_cairo_line (w_current, END_NONE, size,
                      o_current->line->x[0] + dx, o_current->line->y[0] + dy,
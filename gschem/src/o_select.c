@@ -298,14 +298,19 @@ void o_select_box_search(GSCHEM_TOPLEVEL *w_current)
   int SHIFTKEY = w_current->SHIFTKEY;
   int CONTROLKEY = w_current->CONTROLKEY;
   int left, right, top, bottom;
-  const GList *iter;
+  GList *candidates;
+  GList *iter;
 	
   left = min(w_current->first_wx, w_current->second_wx);
   right = max(w_current->first_wx, w_current->second_wx);
   top = min(w_current->first_wy, w_current->second_wy);
   bottom = max(w_current->first_wy, w_current->second_wy);
 
-  iter = s_page_objects (toplevel->page_current);
+  /* only objects intersecting the box can be inside it */
+  candidates = s_page_objects_in_region (toplevel, toplevel->page_current,
+                                         left, top, right, bottom);
+
+  iter = candidates;
   while (iter != NULL) {
     o_current = iter->data;
     /* only select visible objects */
@@ -322,6 +327,7 @@ void o_select_box_search(GSCHEM_TOPLEVEL *w_current)
     }
     iter = g_list_next (iter);
   }
+  g_list_free (candidates);
 
   /* if there were no objects to be found in select box, count will be */
   /* zero, and you need to deselect anything remaining (except when the */
@@ -77,7 +77,7 @@ void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag)
 {
   TOPLEVEL *toplevel = w_current->toplevel;
   char *filename = NULL;
-  GList *object_list = NULL;
+  GList *changes = NULL;
   int levels;
   UNDO *u_current;
   UNDO *u_current_next;
@@ -119,10 +119,11 @@ void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag)
        saving an undo backup copy */
     o_save (toplevel, s_page_objects (toplevel->page_current), filename, NULL);
 
-  } else if (w_current->undo_type == UNDO_MEMORY && flag == UNDO_ALL) {
-    object_list = o_glist_copy_all (toplevel,
-                                    s_page_objects (toplevel->page_current),
-                                    object_list);
+  } else if (w_current->undo_type == UNDO_MEMORY) {
+    /* Only the objects changed since the last level are saved.  This
+     * must be done before the levels above the current one, which may
+     * hold changes not yet undone, are removed. */
+    changes = s_undo_take_changes (toplevel, toplevel->page_current);
   }
 
   /* Clear Anything above current */
@@ -140,7 +141,7 @@ void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag)
 
   toplevel->page_current->undo_tos =
   s_undo_add(toplevel->page_current->undo_tos,
-             flag, filename, object_list,
+             flag, filename, changes,
              toplevel->page_current->left,
              toplevel->page_current->top,
              toplevel->page_current->right,
@@ -151,6 +152,11 @@ void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag)
   toplevel->page_current->undo_current =
       toplevel->page_current->undo_tos;
 
+  if (w_current->undo_type == UNDO_MEMORY) {
+    toplevel->page_current->undo_synced =
+      toplevel->page_current->undo_current;
+  }
+
   if (toplevel->page_current->undo_bottom == NULL) {
     toplevel->page_current->undo_bottom =
         toplevel->page_current->undo_tos;
@@ -205,10 +211,8 @@ void o_undo_savestate(GSCHEM_TOPLEVEL *w_current, int flag)
         g_free(u_current->filename);
       }
 
-      if (u_current->object_list) {
-        s_delete_object_glist (toplevel, u_current->object_list);
-        u_current->object_list = NULL;
-      }
+      s_undo_free_changes (toplevel, u_current->changes);
+      u_current->changes = NULL;
 
       u_current->next = NULL;
       u_current->prev = NULL;
@@ -259,27 +263,6 @@ char *o_undo_find_prev_filename(UNDO *start)
   return(NULL); 
 }
 
-/*! \todo Finish function documentation!!!
- *  \brief
- *  \par Function Description
- *
- */
-GList *o_undo_find_prev_object_head (UNDO *start)
-{
-  UNDO *u_current;
-
-  u_current = start->prev;
-
-  while(u_current) {
-    if (u_current->object_list) {
-      return u_current->object_list;
-    }
-    u_current = u_current->prev;
-  }
-
-  return(NULL); 
-}
-
 /*! \todo Finish function documentation!!!
  *  \brief
  *  \par Function Description
@@ -324,18 +307,15 @@ void o_undo_callback(GSCHEM_TOPLEVEL *w_current, int type)
     return;
   }
 
-  if (u_next->type == UNDO_ALL && u_current->type == UNDO_VIEWPORT_ONLY) {
+  if (w_current->undo_type == UNDO_DISK &&
+      u_next->type == UNDO_ALL && u_current->type == UNDO_VIEWPORT_ONLY) {
 #if DEBUG
     printf("Type: %d\n", u_current->type);
     printf("Current is an undo all, next is viewport only!\n");
 #endif
     find_prev_data = TRUE;
 
-    if (w_current->undo_type == UNDO_DISK) {
-      u_current->filename = o_undo_find_prev_filename(u_current);
-    } else {
-      u_current->object_list = o_undo_find_prev_object_head (u_current);
-    }
+    u_current->filename = o_undo_find_prev_filename(u_current);
   }
 
   /* save filename */
@@ -354,11 +334,6 @@ void o_undo_callback(GSCHEM_TOPLEVEL *w_current, int type)
     s_page_delete (toplevel, toplevel->page_current);
     p_new = s_page_new(toplevel, u_current->filename);
     s_page_goto (toplevel, p_new);
-  } else if (w_current->undo_type == UNDO_MEMORY && u_current->object_list) {
-    PAGE *p_new;
-    s_page_delete (toplevel, toplevel->page_current);
-    p_new = s_page_new (toplevel, save_filename);
-    s_page_goto (toplevel, p_new);
   }
 
   /* temporarily disable logging */
@@ -374,13 +349,11 @@ void o_undo_callback(GSCHEM_TOPLEVEL *w_current, int type)
     toplevel->page_current->up = u_current->up;
     toplevel->page_current->CHANGED=1;
 
-  } else if (w_current->undo_type == UNDO_MEMORY && u_current->object_list) {
-
-    s_page_delete_objects (toplevel, toplevel->page_current);
+  } else if (w_current->undo_type == UNDO_MEMORY) {
 
-    s_page_append_list (toplevel, toplevel->page_current,
-                        o_glist_copy_all (toplevel, u_current->object_list,
-                                          NULL));
+    /* Only the objects which differ between the levels are replaced */
+    o_select_unselect_all (w_current);
+    s_undo_goto (toplevel, toplevel->page_current, u_current);
 
     x_manual_resize(w_current);
     toplevel->page_current->page_control = u_current->page_control;
@@ -439,7 +412,6 @@ void o_undo_callback(GSCHEM_TOPLEVEL *w_current, int type)
   /* just pointers to the real data (lower in the stack) */
   if (find_prev_data) {
     u_current->filename = NULL;
-    u_current->object_list = NULL;
   }
 
 #if DEBUG
@@ -102,7 +102,7 @@ void s_stretch_print_all (GList *list)
     STRETCH *s_current = iter->data;
 
     if (s_current->object) {
-      printf("Object: %s\n", s_current->object->name);
+      printf("Object: %s\n", o_get_name (s_current->object));
     } else {
       printf("Object is NULL\n");
     }
@@ -102,9 +102,10 @@ struct autonumber_text_t {
   /* variables used while autonumbering */
   gchar * current_searchtext;
   gint root_page;      /* flag whether its the root page or not */
-  GList *used_numbers; /* list of used numbers */ 
-  GList *free_slots;   /* list of FREE_SLOT objects */
-  GList *used_slots;   /* list of USED_SLOT objects */
+  GHashTable *used_numbers; /* set of used numbers */
+  gint next_number;         /* all numbers from startnum up to it are used */
+  GHashTable *free_slots;   /* GTree of free AUTONUMBER_SLOTs per symbol */
+  GHashTable *used_slots;   /* GTree of used AUTONUMBER_SLOTs per symbol */
 };
 
 typedef struct autonumber_slot_t AUTONUMBER_SLOT;
@@ -120,19 +121,6 @@ struct autonumber_slot_t {
 /* ***** BACK-END CODE ***************************************************** */
 
 /********** compare functions for g_list_sort, ... ***********************/
-/*! \brief GCompareFunc function to sort a list with g_list_sort().
- *  \par Function Description
- *  Compares the integer values of the gconstpointers a and b.
- *  \return -1 if a<b, 1 if a>b, 0 if a==b
- */
-gint autonumber_sort_numbers(gconstpointer a, gconstpointer b) {
-  if (GPOINTER_TO_INT(a) < GPOINTER_TO_INT(b))
-    return -1;
-  if (GPOINTER_TO_INT(a) > GPOINTER_TO_INT(b))
-    return 1;
-  return 0;
-}
-
 /*! \brief GCompareFunc function to sort text objects by there location 
  *  \par Function Description 
  *  This Funcion takes two <B>OBJECT*</B> arguments and compares the  
@@ -240,78 +228,133 @@ int autonumber_sort_diagonal(gconstpointer a, gconstpointer b) {
   return 0;
 }
 
-/*! \brief GCompareFunc function to acces <B>AUTONUMBER_SLOT</B> object in a GList
+/*! \brief GCompareDataFunc function to order <B>AUTONUMBER_SLOT</B> objects
  *  \par Function Description
- *  This Funcion takes two <B>AUTONUMBER_SLOT*</B> arguments and compares them.
- *  Sorting criteria is are the AUTONUMBER_SLOT members: first the symbolname, than the 
- *  number and last the slotnr.
- *  If the number or the slotnr is set to zero it acts as a wildcard. 
- *  The function is used as GCompareFunc by GList functions.
+ *  This Funcion takes two <B>AUTONUMBER_SLOT*</B> arguments of the same
+ *  symbol and compares them. Sorting criteria are the AUTONUMBER_SLOT
+ *  members: first the number and then the slotnr.
+ *  The function is used as GCompareDataFunc by the GTree of each symbol.
  */
-gint freeslot_compare(gconstpointer a, gconstpointer b) 
+static gint autonumber_slot_compare (gconstpointer a, gconstpointer b,
+                                     gpointer user_data)
 {
-  AUTONUMBER_SLOT *aa, *bb;
-  gint res;
-  aa = (AUTONUMBER_SLOT *) a;  bb = (AUTONUMBER_SLOT *) b;
-  
-  if ((res = strcmp(aa->symbolname, bb->symbolname)) != 0)
-    return res;
-
-  /* aa->symbolname == bb->symbolname */
-  if (aa->number == 0 || bb->number == 0)
-    return 0;
-  if (aa->number > bb->number)
-    return 1;
-  if (aa->number < bb->number)
-    return -1;
-
-  /* aa->number == bb->number */
-  if (aa->slotnr == 0 || bb->slotnr == 0)
-    return 0;
-  if (aa->slotnr > bb->slotnr)
-    return 1;
-  if (aa->slotnr < bb->slotnr)
-    return -1;
+  const AUTONUMBER_SLOT *aa = a;
+  const AUTONUMBER_SLOT *bb = b;
 
+  if (aa->number != bb->number)
+    return (aa->number > bb->number) ? 1 : -1;
+  if (aa->slotnr != bb->slotnr)
+    return (aa->slotnr > bb->slotnr) ? 1 : -1;
   return 0;
 }
 
-/*! \brief Prints a <B>GList</B> of <B>AUTONUMBER_SLOT</B> elements
+/*! \brief Get the slots of a symbol from a slot database
  *  \par Function Description
- *  This funcion prints the elements of a GList that contains <B>AUTONUMBER_SLOT</B> elements
- *  It is only used for debugging purposes.
+ *  The slot databases map each symbolname to a GTree holding its
+ *  <B>AUTONUMBER_SLOT</B>s ordered by number and slot, so that a slot
+ *  is found, added or removed in O(log n).
+ *
+ *  \param [in,out] table       The slot database, created when needed.
+ *  \param [in]     symbolname  The symbol to look up.
+ *  \param [in]     create      Whether to add a tree for a new symbol.
+ *  \return The GTree of the symbol, or NULL if it has none.
  */
-void freeslot_print(GList *list) {
-  GList *item;
-  AUTONUMBER_SLOT *fs;
-  
-  printf("freeslot_print(): symname, number, slot\n");
-  for (item = list; item != NULL; item = g_list_next(item)) {
-    fs = item ->data;
-    printf("  %s, %d, %d\n",fs->symbolname, fs->number, fs->slotnr);
+static GTree *autonumber_slot_tree (GHashTable **table,
+                                    const gchar *symbolname, gboolean create)
+{
+  GTree *tree;
+
+  if (*table == NULL) {
+    if (!create)
+      return NULL;
+    *table = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                    (GDestroyNotify) g_tree_destroy);
   }
+
+  tree = g_hash_table_lookup (*table, symbolname);
+  if (tree == NULL && create) {
+    tree = g_tree_new_full (autonumber_slot_compare, NULL, g_free, NULL);
+    g_hash_table_insert (*table, (gpointer) symbolname, tree);
+  }
+  return tree;
 }
 
+/*! \brief Add a slot to a slot database
+ *  \par Function Description
+ *  Adds a copy of <B>slot</B> to the tree of its symbol in <B>table</B>.
+ */
+static void autonumber_slot_add (GHashTable **table, AUTONUMBER_SLOT *slot)
+{
+  GTree *tree = autonumber_slot_tree (table, slot->symbolname, TRUE);
+  AUTONUMBER_SLOT *copy = g_memdup (slot, sizeof (AUTONUMBER_SLOT));
+
+  g_tree_insert (tree, copy, copy);
+}
+
+/*! \brief GTraverseFunc function to fetch the first slot of a GTree
+ *  \par Function Description
+ *  Stores the first <B>AUTONUMBER_SLOT</B> visited in <B>data</B> and
+ *  stops the traversal.
+ */
+static gboolean autonumber_slot_first (gpointer key, gpointer value,
+                                       gpointer data)
+{
+  *((AUTONUMBER_SLOT **) data) = value;
+  return TRUE;
+}
+
+/*! \brief Mark a number as used
+ *  \par Function Description
+ *  Adds <B>number</B> to the set of used numbers of the current searchtext.
+ */
+static void autonumber_use_number (AUTONUMBER_TEXT *autotext, gint number)
+{
+  if (autotext->used_numbers == NULL)
+    autotext->used_numbers = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  g_hash_table_insert (autotext->used_numbers,
+                       GINT_TO_POINTER (number), GINT_TO_POINTER (number));
+}
+
+/*! \brief Find the lowest unused number
+ *  \par Function Description
+ *  Returns the lowest number from startnum on which is not used yet.
+ *  Numbers are only added to the database while it exists, so the
+ *  search resumes where the last one stopped, and allocating all the
+ *  numbers of a run takes linear time overall.
+ */
+static gint autonumber_next_free_number (AUTONUMBER_TEXT *autotext)
+{
+  if (autotext->next_number < autotext->startnum)
+    autotext->next_number = autotext->startnum;
+
+  while (autotext->used_numbers != NULL &&
+         g_hash_table_lookup_extended (autotext->used_numbers,
+                                       GINT_TO_POINTER (autotext->next_number),
+                                       NULL, NULL))
+    autotext->next_number++;
+
+  return autotext->next_number;
+}
 
 /*! \brief Function to clear the databases of used parts
  *  \par Function Descriptions
- *  Just remove the list of used numbers, used slots and free slots.
+ *  Just remove the set of used numbers, used slots and free slots.
  */
 void autonumber_clear_database (AUTONUMBER_TEXT *autotext)
 {
   /* cleanup everything for the next searchtext */
   if (autotext->used_numbers != NULL) {
-    g_list_free(autotext->used_numbers);
+    g_hash_table_destroy (autotext->used_numbers);
     autotext->used_numbers = NULL;
   }
+  autotext->next_number = 0;
   if (autotext->free_slots != NULL) {
-    g_list_foreach(autotext->free_slots, (GFunc) g_free, NULL);
-    g_list_free(autotext->free_slots);
+    g_hash_table_destroy (autotext->free_slots);
     autotext->free_slots = NULL;
   }
   if (autotext->used_slots != NULL) {
-    g_list_foreach(autotext->used_slots, (GFunc) g_free, NULL);
-    g_list_free(autotext->used_slots);
+    g_hash_table_destroy (autotext->used_slots);
     autotext->used_slots = NULL;
   }
 }
@@ -376,10 +419,10 @@ gint autonumber_match(AUTONUMBER_TEXT *autotext, OBJECT *o_current, gint *number
 }
 
 
-/*! \brief Creates a list of already numbered objects and slots
+/*! \brief Creates a database of already numbered objects and slots
  *  \par Function Description
  *  This function collects the used numbers of a single schematic page.
- *  The used element numbers are stored in a GList container
+ *  The used element numbers are stored in a hashed set
  *  inside the <B>AUTONUMBER_TEXT</B> struct.
  *  The slotting container is a little bit different. It stores free slots of
  *  multislotted symbols, that were used only partially.
@@ -389,8 +432,9 @@ void autonumber_get_used(GSCHEM_TOPLEVEL *w_current, AUTONUMBER_TEXT *autotext)
 {
   gint number, numslots, slotnr, i;
   OBJECT *o_current, *o_parent;
-  AUTONUMBER_SLOT *slot;
-  GList *slot_item;
+  AUTONUMBER_SLOT slot;
+  GTree *free_tree, *used_tree;
+  gpointer free_slot;
   char *numslot_str, *slot_str;
   const GList *iter;
   
@@ -417,54 +461,46 @@ void autonumber_get_used(GSCHEM_TOPLEVEL *w_current, AUTONUMBER_TEXT *autotext)
 	    }
 	    else {
 	      sscanf(slot_str, " %d", &slotnr);
-	      slot = g_new(AUTONUMBER_SLOT,1);
-	      slot->number = number;
-	      slot->slotnr = slotnr;
-	      slot->symbolname = o_parent->complex_basename;
-	
-
-	      slot_item = g_list_find_custom(autotext->used_slots,
-						 slot,
-						 (GCompareFunc) freeslot_compare);
-	      if (slot_item != NULL) { /* duplicate slot in used_slots */
+	      g_free(slot_str);
+	      slot.number = number;
+	      slot.slotnr = slotnr;
+	      slot.symbolname = o_parent->complex_basename;
+
+	      used_tree = autonumber_slot_tree (&autotext->used_slots,
+						slot.symbolname, FALSE);
+	      if (used_tree != NULL
+		  && g_tree_lookup (used_tree, &slot) != NULL) {
+		/* duplicate slot in used_slots */
 		s_log_message(_("duplicate slot may cause problems: "
 				"[symbolname=%s, number=%d, slot=%d]\n"),
-				slot->symbolname, slot->number, slot->slotnr);
-		g_free(slot);
+				slot.symbolname, slot.number, slot.slotnr);
 	      }
 	      else {
-		autotext->used_slots = g_list_insert_sorted(autotext->used_slots,
-							    slot,
-							    (GCompareFunc) freeslot_compare);
-		
-		slot_item = g_list_find_custom(autotext->free_slots,
-						   slot,
-						   (GCompareFunc) freeslot_compare);
-		if (slot_item == NULL) {
-		  /* insert all slots to the list, except of the current one */
+		autonumber_slot_add (&autotext->used_slots, &slot);
+
+		free_tree = autonumber_slot_tree (&autotext->free_slots,
+						  slot.symbolname, FALSE);
+		free_slot = (free_tree == NULL) ? NULL
+		  : g_tree_lookup (free_tree, &slot);
+		if (free_slot == NULL) {
+		  /* insert all slots to the database, except of the current one */
 		  for (i=1; i <= numslots; i++) {
 		    if (i != slotnr) {
-		      slot = g_memdup(slot, sizeof(AUTONUMBER_SLOT));
-		      slot->slotnr = i;
-		      autotext->free_slots = g_list_insert_sorted(autotext->free_slots,
-								  slot,
-								  (GCompareFunc) freeslot_compare);
+		      slot.slotnr = i;
+		      autonumber_slot_add (&autotext->free_slots, &slot);
 		    }
 		  }
 		}
 		else {
-		  g_free(slot_item->data);
-		  autotext->free_slots = g_list_delete_link(autotext->free_slots, slot_item);
+		  g_tree_remove (free_tree, free_slot);
 		}
 	      }
 	    }
 	  }
 	}
       }
-      /* put number into the used list */
-      autotext->used_numbers = g_list_insert_sorted(autotext->used_numbers,
-						    GINT_TO_POINTER(number),
-						    (GCompareFunc) autonumber_sort_numbers);
+      /* put number into the used set */
+      autonumber_use_number (autotext, number);
     }
   }
 }
@@ -473,7 +509,7 @@ void autonumber_get_used(GSCHEM_TOPLEVEL *w_current, AUTONUMBER_TEXT *autotext)
 /*! \brief Gets or generates free numbers for the autonumbering process.
  *  \par Function Description
  *  This function gets or generates new numbers for the <B>OBJECT o_current</B>. 
- *  It uses the element numbers <B>used_numbers</B> and the list of the free slots
+ *  It uses the element numbers <B>used_numbers</B> and the database of the free slots
  *  <B>free_slots</B> of the <B>AUTONUMBER_TEXT</B> struct.
  *  \return 
  *  The new number is returned into the <B>number</B> parameter.
@@ -482,57 +518,38 @@ void autonumber_get_used(GSCHEM_TOPLEVEL *w_current, AUTONUMBER_TEXT *autotext)
 void autonumber_get_new_numbers(AUTONUMBER_TEXT *autotext, OBJECT *o_current, 
 				gint *number, gint *slot)
 {
-  GList *item;
   gint new_number, numslots, i;
-  AUTONUMBER_SLOT *freeslot;
+  AUTONUMBER_SLOT *freeslot = NULL;
+  AUTONUMBER_SLOT newslot;
   OBJECT *o_parent = NULL;
-  GList *freeslot_item;
+  GTree *free_tree;
   gchar *numslot_str;
 
-  new_number = autotext->startnum;
-  
   /* Check for slots first */
   /* 1. are there any unused slots in the database? */
   o_parent = o_current->attached_to;
   if (autotext->slotting && o_parent != NULL) {
-    freeslot = g_new(AUTONUMBER_SLOT,1);
-    freeslot->symbolname = o_parent->complex_basename;
-    freeslot->number = 0;
-    freeslot->slotnr = 0;
-    freeslot_item = g_list_find_custom(autotext->free_slots,
-				       freeslot,
-				       (GCompareFunc) freeslot_compare);
-    g_free(freeslot);
+    free_tree = autonumber_slot_tree (&autotext->free_slots,
+                                      o_parent->complex_basename, FALSE);
+    if (free_tree != NULL)
+      g_tree_foreach (free_tree, autonumber_slot_first, &freeslot);
     /* Yes! -> remove from database, apply it */
-    if (freeslot_item != NULL) {
-      freeslot = freeslot_item->data;
+    if (freeslot != NULL) {
       *number = freeslot->number;
       *slot = freeslot->slotnr;
-      g_free(freeslot);
-      autotext->free_slots = g_list_delete_link(autotext->free_slots, freeslot_item);
-      
+      g_tree_remove (free_tree, freeslot);
+
       return;
     }
   }
 
   /* get a new number */
-  item = autotext->used_numbers; 
-  while (1) {
-    while (item != NULL && GPOINTER_TO_INT(item->data) < new_number)
-      item = g_list_next(item);
-
-    if (item == NULL || GPOINTER_TO_INT(item->data) > new_number)
-      break;
-    else  /* new_number == item->data */
-      new_number++;
-  }
+  new_number = autonumber_next_free_number (autotext);
   *number = new_number;
   *slot = 0;
   
-  /* insert the new number to the used list */
-  autotext->used_numbers = g_list_insert_sorted(autotext->used_numbers,
-						GINT_TO_POINTER(new_number),
-						(GCompareFunc) autonumber_sort_numbers);
+  /* insert the new number to the used set */
+  autonumber_use_number (autotext, new_number);
 
   /* 3. is o_current a slotted object ? */
   if ((autotext->slotting) && o_parent != NULL) {
@@ -544,14 +561,11 @@ void autonumber_get_new_numbers(AUTONUMBER_TEXT *autotext, OBJECT *o_current,
       if (numslots > 0) { 
 	/* Yes! -> new number and slot=1; add the other slots to the database */
 	*slot = 1;
+	newslot.symbolname = o_parent->complex_basename;
+	newslot.number = new_number;
 	for (i=2; i <=numslots; i++) {
-	  freeslot = g_new(AUTONUMBER_SLOT,1);
-	  freeslot->symbolname = o_parent->complex_basename;
-	  freeslot->number = new_number;
-	  freeslot->slotnr = i;
-	  autotext->free_slots = g_list_insert_sorted(autotext->free_slots,
-						      freeslot,
-						      (GCompareFunc) freeslot_compare);
+	  newslot.slotnr = i;
+	  autonumber_slot_add (&autotext->free_slots, &newslot);
 	}
       }
     }
@@ -646,6 +660,7 @@ void autonumber_text_autonumber(AUTONUMBER_TEXT *autotext)
   autotext->current_searchtext = NULL;
   autotext->root_page = 1;
   autotext->used_numbers = NULL;
+  autotext->next_number = 0;
   autotext->free_slots = NULL;
   autotext->used_slots = NULL;
 
@@ -820,6 +835,45 @@ void autonumber_text_autonumber(AUTONUMBER_TEXT *autotext)
   o_undo_savestate(w_current, UNDO_ALL);
 }
 
+/*! \brief Autonumbers a whole hierarchy without the dialog
+ *  \par Function Description
+ *  This function numbers all the texts matching <B>searchtext</B> on
+ *  the current page and the pages below it, respecting the numbers
+ *  used anywhere in the hierarchy, in diagonal order and without
+ *  autoslotting. It is the entry point for scripts run inside gschem.
+ *
+ *  Like the dialog, it edits the pages through <B>w_current</B>: it
+ *  switches pages, updates slots with o_slot_end() and records the
+ *  result as one undo step.  It is therefore tied to a gschem window,
+ *  and cannot renumber a design without a display.
+ *
+ *  \param [in] w_current   The GSCHEM_TOPLEVEL object.
+ *  \param [in] searchtext  The search text, ending with "?" or "*".
+ *  \param [in] startnum    The first number to hand out.
+ *  \param [in] overwrite   Whether to renumber already numbered texts.
+ */
+void autonumber_text_run(GSCHEM_TOPLEVEL *w_current, const gchar *searchtext,
+                         gint startnum, gboolean overwrite)
+{
+  AUTONUMBER_TEXT autotext;
+
+  memset (&autotext, 0, sizeof (autotext));
+  autotext.scope_text = g_list_append (NULL, g_strdup (searchtext));
+  autotext.scope_skip = SCOPE_HIERARCHY;
+  autotext.scope_number = SCOPE_HIERARCHY;
+  autotext.scope_overwrite = overwrite;
+  autotext.order = AUTONUMBER_SORT_DIAGONAL;
+  autotext.startnum = startnum;
+  autotext.removenum = FALSE;
+  autotext.slotting = FALSE;
+  autotext.w_current = w_current;
+
+  autonumber_text_autonumber (&autotext);
+
+  g_list_foreach (autotext.scope_text, (GFunc) g_free, NULL);
+  g_list_free (autotext.scope_text);
+}
+
 /* ***** UTILITY GUI FUNCTIONS (move to a separate file in the future?) **** */
 
 /** @brief Finds a widget by its name given a pointer to its parent.
@@ -33,7 +33,16 @@
 #endif
 
 #define MIME_TYPE_SCHEMATIC "application/x-geda-schematic"
+#define MIME_TYPE_OBJECTS   "application/x-geda-gschem-objects"
 #define CLIP_TYPE_SCHEMATIC 1
+#define CLIP_TYPE_OBJECTS   2
+
+/* The window whose clipboard buffer owns the system clipboard, and a
+ * serial number identifying the current contents of the buffer.  Used
+ * to paste between windows of this process without going through the
+ * schematic file format. */
+static GSCHEM_TOPLEVEL *clip_owner = NULL;
+static guint clip_serial = 0;
 
 /* \brief Callback for handling system clipboard owner change.
  * \par Function Description
@@ -56,6 +65,18 @@ clip_get (GtkClipboard *cb, GtkSelectionData *selection_data,
   TOPLEVEL *toplevel = w_current->toplevel;
   GdkAtom type = gdk_atom_intern (MIME_TYPE_SCHEMATIC, FALSE);
   gchar *buf;
+
+  if (info == CLIP_TYPE_OBJECTS) {
+    /* Only identify the clipboard buffer; a gschem window of the same
+     * process copies the objects directly from it. */
+    buf = g_strdup_printf ("%d %u", (int) getpid (), clip_serial);
+    gtk_selection_data_set (selection_data,
+                            gdk_atom_intern (MIME_TYPE_OBJECTS, FALSE),
+                            8, (guchar *) buf, (gint) strlen (buf));
+    g_free (buf);
+    return;
+  }
+
   if (info != CLIP_TYPE_SCHEMATIC) return;
   /* Convert the objects in the clipboard buffer to gEDA schematic
    * format */
@@ -77,6 +98,51 @@ clip_clear (GtkClipboard *cb, gpointer user_data_or_owner)
   /* Free the objects in the clipboard buffer */
   s_delete_object_glist (toplevel, w_current->clipboard_buffer);
   w_current->clipboard_buffer = NULL;
+
+  if (clip_owner == w_current) {
+    clip_owner = NULL;
+  }
+}
+
+/* \brief Get the objects of a clipboard buffer in this process.
+ * \par Function Description
+ * If \a selection_data identifies the current clipboard buffer of a
+ * window of this process, returns a copy of its objects.
+ *
+ * \param [in] w_current       The GSCHEM_TOPLEVEL to paste into.
+ * \param [in] selection_data  The MIME_TYPE_OBJECTS clipboard data.
+ * \param [out] object_list    The copied objects.
+ * \returns TRUE if the clipboard buffer was found.
+ */
+static gboolean
+clip_get_local (GSCHEM_TOPLEVEL *w_current, GtkSelectionData *selection_data,
+                GList **object_list)
+{
+  const guchar *buf;
+  gchar *data;
+  int pid;
+  guint serial;
+  gboolean found = FALSE;
+
+#if GTK_CHECK_VERSION(2,14,0)
+  buf = gtk_selection_data_get_data (selection_data);
+#else
+  buf = selection_data->data;
+#endif
+
+  if (buf == NULL || clip_owner == NULL)
+    return FALSE;
+
+  data = g_strdup ((const gchar *) buf);
+  if (sscanf (data, "%d %u", &pid, &serial) == 2 &&
+      pid == (int) getpid () && serial == clip_serial) {
+    *object_list = o_glist_copy_all (w_current->toplevel,
+                                     clip_owner->clipboard_buffer, NULL);
+    found = TRUE;
+  }
+  g_free (data);
+
+  return found;
 }
 
 /* \brief Initialises system clipboard support
@@ -106,6 +172,10 @@ x_clipboard_finish (GSCHEM_TOPLEVEL *w_current)
   g_signal_handlers_disconnect_by_func (cb, clip_handle_owner_change, w_current);
   if (w_current->clipboard_buffer)
     gtk_clipboard_store (cb);
+
+  /* The window's clipboard buffer can no longer be pasted directly */
+  if (clip_owner == w_current)
+    clip_owner = NULL;
 }
 
 struct query_usable {
@@ -130,10 +200,14 @@ query_usable_targets_cb (GtkClipboard *clip, GdkAtom *targets, gint ntargets,
   int is_usable = FALSE;
 
   for (i = 0; i < ntargets; i++) {
-    if (strcmp (gdk_atom_name (targets[i]), MIME_TYPE_SCHEMATIC) == 0) {
+    gchar *name = gdk_atom_name (targets[i]);
+    if (strcmp (name, MIME_TYPE_SCHEMATIC) == 0 ||
+        strcmp (name, MIME_TYPE_OBJECTS) == 0) {
       is_usable = TRUE;
-      break;
     }
+    g_free (name);
+    if (is_usable)
+      break;
   }
 
   cbinfo->callback (is_usable, cbinfo->userdata);
@@ -173,6 +247,10 @@ x_clipboard_query_usable (GSCHEM_TOPLEVEL *w_current,
  * Set the system clipboard to contain the gschem objects listed in \a
  * object_list.
  *
+ * The objects are offered both in the schematic file format and as a
+ * reference to the clipboard buffer, which other windows of this
+ * process copy from directly.
+ *
  * \param [in,out] w_current   The current GSCHEM_TOPLEVEL.
  * \param [in]     object_list The objects to put in the clipboard.
  *
@@ -182,8 +260,10 @@ gboolean
 x_clipboard_set (GSCHEM_TOPLEVEL *w_current, const GList *object_list)
 {
   GtkClipboard *cb = gtk_clipboard_get (GDK_SELECTION_CLIPBOARD);
-  GtkTargetEntry target = { MIME_TYPE_SCHEMATIC, 0,
-                            CLIP_TYPE_SCHEMATIC };
+  GtkTargetEntry targets[] = {
+    { MIME_TYPE_OBJECTS, GTK_TARGET_SAME_APP, CLIP_TYPE_OBJECTS },
+    { MIME_TYPE_SCHEMATIC, 0, CLIP_TYPE_SCHEMATIC },
+  };
   TOPLEVEL *toplevel = w_current->toplevel;
   gboolean result;
 
@@ -196,12 +276,16 @@ x_clipboard_set (GSCHEM_TOPLEVEL *w_current, const GList *object_list)
     o_glist_copy_all (toplevel, object_list, w_current->clipboard_buffer);
 
   /* Advertise that the data is available */
-  result = gtk_clipboard_set_with_data (cb, &target, 1,
+  result = gtk_clipboard_set_with_data (cb, targets, G_N_ELEMENTS (targets),
                                         clip_get, clip_clear, w_current);
+  if (result) {
+    clip_owner = w_current;
+    clip_serial++;
+  }
 
   /* Hint that the data can be stored to be accessed after the program
-   * has quit. */
-  gtk_clipboard_set_can_store (cb, NULL, 0);
+   * has quit.  Only the schematic format remains valid then. */
+  gtk_clipboard_set_can_store (cb, &targets[1], 1);
 
   return result;
 }
@@ -209,6 +293,9 @@ x_clipboard_set (GSCHEM_TOPLEVEL *w_current, const GList *object_list)
 /* \brief Get the contents of the system clipboard.
  * \par Function Description
  * If the system clipboard contains schematic data, retrieve it.
+ * Objects copied in another window of this process are copied
+ * directly from its clipboard buffer; otherwise they are read from
+ * the schematic file format.
  *
  * \param [in,out] w_current   The current GSCHEM_TOPLEVEL.
  *
@@ -226,6 +313,16 @@ x_clipboard_get (GSCHEM_TOPLEVEL *w_current)
   const guchar *buf;
   GError * err = NULL;
 
+  /* Prefer copying the objects from a window of this process */
+  selection_data =
+    gtk_clipboard_wait_for_contents (cb, gdk_atom_intern (MIME_TYPE_OBJECTS,
+                                                          FALSE));
+  if (selection_data != NULL) {
+    gboolean found = clip_get_local (w_current, selection_data, &object_list);
+    gtk_selection_data_free (selection_data);
+    if (found) return object_list;
+  }
+
   /* Try to get the contents of the clipboard */
   selection_data = gtk_clipboard_wait_for_contents (cb, type);
   if (selection_data == NULL) return FALSE;
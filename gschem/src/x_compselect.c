@@ -56,6 +56,18 @@
  */
 #define COMPSELECT_FILTER_INTERVAL 200
 
+/*! \def COMPSELECT_PREVIEW_INTERVAL
+ *  \brief The time interval between selection and preview of a symbol
+ *
+ *  This constant is the time-lag between a change of the selected
+ *  symbol and the update of the preview and attribute list. When the
+ *  user moves quickly through the list, only the symbol the selection
+ *  settles on is loaded.
+ *
+ *  Unit is milliseconds.
+ */
+#define COMPSELECT_PREVIEW_INTERVAL 100
+
 
 enum compselect_view {
   VIEW_INUSE=0,
@@ -363,11 +375,282 @@ lib_treeview_set_cell_data (GtkTreeViewColumn *tree_column,
   g_object_set ((GObject*)cell, "text", text, NULL);
 }
 
+/*! \brief Index of symbol names used to filter the library treeview
+ *
+ *  Every symbol of the library model is given an id, and every
+ *  sequence of three characters (trigram) of the upper cased symbol
+ *  names is mapped to the sorted list of ids of the names containing
+ *  it. A filter text can only match names containing all of its
+ *  trigrams, so only those names need to be tested against it.
+ *
+ *  The result of the last filter is kept, both as the set of rows to
+ *  show and as the list of matching ids, so that a filter text which
+ *  extends the previous one only re-tests the previous matches.
+ */
+struct _CompselectFilterIndex {
+  GPtrArray *symbols;   /* CLibSymbol of each id */
+  GPtrArray *sources;   /* CLibSource of each id */
+  GPtrArray *names;     /* upper cased name of each id */
+  GHashTable *trigrams; /* packed trigram -> GArray of ids */
+
+  gchar *text;          /* upper cased filter text, or NULL if none */
+  GArray *matches;      /* ids of the names matching text */
+  GHashTable *visible;  /* symbols and sources of the matches */
+};
+
+/*! \brief Packs three characters into a trigram key. */
+#define FILTER_TRIGRAM(s) \
+  GUINT_TO_POINTER (((guint) (guchar) (s)[0] << 16) | \
+                    ((guint) (guchar) (s)[1] << 8)  | \
+                     (guint) (guchar) (s)[2])
+
+static void
+filter_index_free_postings (gpointer data)
+{
+  g_array_free ((GArray *) data, TRUE);
+}
+
+/*! \brief Creates an empty filter index. */
+static CompselectFilterIndex *
+filter_index_new (void)
+{
+  CompselectFilterIndex *index = g_new0 (CompselectFilterIndex, 1);
+
+  index->symbols  = g_ptr_array_new ();
+  index->sources  = g_ptr_array_new ();
+  index->names    = g_ptr_array_new ();
+  index->trigrams = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                           NULL, filter_index_free_postings);
+  index->text     = NULL;
+  index->matches  = g_array_new (FALSE, FALSE, sizeof (guint));
+  index->visible  = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  return index;
+}
+
+/*! \brief Frees a filter index. */
+static void
+filter_index_free (CompselectFilterIndex *index)
+{
+  if (index == NULL) {
+    return;
+  }
+
+  g_ptr_array_free (index->symbols, TRUE);
+  g_ptr_array_free (index->sources, TRUE);
+  g_ptr_array_foreach (index->names, (GFunc) g_free, NULL);
+  g_ptr_array_free (index->names, TRUE);
+  g_hash_table_destroy (index->trigrams);
+  g_free (index->text);
+  g_array_free (index->matches, TRUE);
+  g_hash_table_destroy (index->visible);
+  g_free (index);
+}
+
+/*! \brief Adds a symbol to a filter index.
+ *  \par Function Description
+ *  Gives <B>symbol</B> the next id and files the id under each trigram
+ *  of its upper cased name.
+ *
+ *  \param [in] index  The filter index.
+ *  \param [in] source The source the symbol belongs to.
+ *  \param [in] symbol The symbol to add.
+ */
+static void
+filter_index_add (CompselectFilterIndex *index,
+                  CLibSource *source, CLibSymbol *symbol)
+{
+  guint id = index->symbols->len;
+  gchar *name = g_ascii_strup (s_clib_symbol_get_name (symbol), -1);
+  GArray *postings;
+  gchar *p;
+
+  g_ptr_array_add (index->symbols, symbol);
+  g_ptr_array_add (index->sources, source);
+  g_ptr_array_add (index->names, name);
+
+  for (p = name; p[0] != '\0' && p[1] != '\0' && p[2] != '\0'; p++) {
+    postings = g_hash_table_lookup (index->trigrams, FILTER_TRIGRAM (p));
+    if (postings == NULL) {
+      postings = g_array_new (FALSE, FALSE, sizeof (guint));
+      g_hash_table_insert (index->trigrams, FILTER_TRIGRAM (p), postings);
+    }
+
+    /* ids are added in increasing order, so duplicates are adjacent */
+    if (postings->len == 0 ||
+        g_array_index (postings, guint, postings->len - 1) != id) {
+      g_array_append_val (postings, id);
+    }
+  }
+}
+
+/*! \brief Intersects two sorted lists of ids.
+ *  \returns A new GArray of the ids in both <B>a</B> and <B>b</B>.
+ */
+static GArray *
+filter_intersect (GArray *a, GArray *b)
+{
+  GArray *result = g_array_new (FALSE, FALSE, sizeof (guint));
+  guint i = 0, j = 0;
+  guint id_a, id_b;
+
+  while (i < a->len && j < b->len) {
+    id_a = g_array_index (a, guint, i);
+    id_b = g_array_index (b, guint, j);
+    if (id_a < id_b) {
+      i++;
+    } else if (id_b < id_a) {
+      j++;
+    } else {
+      g_array_append_val (result, id_a);
+      i++;
+      j++;
+    }
+  }
+
+  return result;
+}
+
+/*! \brief Finds the names which may match a filter text.
+ *  \par Function Description
+ *  Intersects the ids of the names containing each trigram of the
+ *  literal parts of <B>text</B>. Trigrams spanning a wildcard are
+ *  skipped.
+ *
+ *  \param [in] index The filter index.
+ *  \param [in] text  The upper cased filter text.
+ *  \returns A new GArray of candidate ids, or NULL if <B>text</B> has
+ *            no trigram and every name is a candidate.
+ */
+static GArray *
+filter_index_candidates (CompselectFilterIndex *index, const gchar *text)
+{
+  GArray *candidates = NULL;
+  GArray *postings, *tmp;
+  const gchar *p;
+
+  for (p = text; p[0] != '\0' && p[1] != '\0' && p[2] != '\0'; p++) {
+    if (strchr ("*?", p[0]) != NULL ||
+        strchr ("*?", p[1]) != NULL ||
+        strchr ("*?", p[2]) != NULL) {
+      continue;
+    }
+
+    postings = g_hash_table_lookup (index->trigrams, FILTER_TRIGRAM (p));
+    if (postings == NULL) {
+      /* no name contains this trigram */
+      if (candidates != NULL) {
+        g_array_free (candidates, TRUE);
+      }
+      return g_array_new (FALSE, FALSE, sizeof (guint));
+    }
+
+    if (candidates == NULL) {
+      candidates = g_array_new (FALSE, FALSE, sizeof (guint));
+      g_array_append_vals (candidates, postings->data, postings->len);
+    } else {
+      tmp = filter_intersect (candidates, postings);
+      g_array_free (candidates, TRUE);
+      candidates = tmp;
+    }
+
+    if (candidates->len == 0) {
+      break;
+    }
+  }
+
+  return candidates;
+}
+
+/*! \brief Computes the rows shown for a filter text.
+ *  \par Function Description
+ *  Finds the symbols whose names match <B>text</B>, ignoring case, and
+ *  records them and their sources as the visible rows of the library
+ *  treeview. If <B>text</B> contains the previous filter text, only
+ *  the previous matches are tested.
+ *
+ *  \param [in] index The filter index.
+ *  \param [in] text  The filter text.
+ */
+static void
+filter_index_update (CompselectFilterIndex *index, const gchar *text)
+{
+  gchar *text_upper, *pattern;
+  GPatternSpec *spec;
+  GArray *candidates, *matches;
+  guint i, id, n;
+
+  text_upper = g_ascii_strup (text, -1);
+
+  if (text_upper[0] == '\0') {
+    g_free (text_upper);
+    g_free (index->text);
+    index->text = NULL;
+    g_array_set_size (index->matches, 0);
+    g_hash_table_remove_all (index->visible);
+    return;
+  }
+
+  if (index->text != NULL && strcmp (text_upper, index->text) == 0) {
+    g_free (text_upper);
+    return;
+  }
+
+  /* Any name matching the new text also matched the old one if the
+   * old text is part of the new one */
+  if (index->text != NULL && strstr (text_upper, index->text) != NULL) {
+    candidates = index->matches;
+    index->matches = NULL;
+  } else {
+    candidates = filter_index_candidates (index, text_upper);
+  }
+
+  pattern = g_strconcat ("*", text_upper, "*", NULL);
+  spec = g_pattern_spec_new (pattern);
+
+  matches = g_array_new (FALSE, FALSE, sizeof (guint));
+  n = (candidates != NULL) ? candidates->len : index->names->len;
+  for (i = 0; i < n; i++) {
+    id = (candidates != NULL) ? g_array_index (candidates, guint, i) : i;
+    if (g_pattern_match_string (spec,
+                                g_ptr_array_index (index->names, id))) {
+      g_array_append_val (matches, id);
+    }
+  }
+
+  g_pattern_spec_free (spec);
+  g_free (pattern);
+  if (candidates != NULL) {
+    g_array_free (candidates, TRUE);
+  }
+  if (index->matches != NULL) {
+    g_array_free (index->matches, TRUE);
+  }
+
+  g_hash_table_remove_all (index->visible);
+  for (i = 0; i < matches->len; i++) {
+    id = g_array_index (matches, guint, i);
+    g_hash_table_insert (index->visible,
+                         g_ptr_array_index (index->symbols, id),
+                         GINT_TO_POINTER (TRUE));
+    g_hash_table_insert (index->visible,
+                         g_ptr_array_index (index->sources, id),
+                         GINT_TO_POINTER (TRUE));
+  }
+
+  g_free (index->text);
+  index->text = text_upper;
+  index->matches = matches;
+}
+
 /*! \brief Determines visibility of items of the library treeview.
  *  \par Function Description
  *  This is the function used to filter entries of the component
  *  selection tree.
  *
+ *  The matching itself is done by filter_index_update() whenever the
+ *  filter text changes, so this only looks the item up in its result.
+ *
  *  \param [in] model The current selection in the treeview.
  *  \param [in] iter  An iterator on a component or folder in the tree.
  *  \param [in] data  The component selection dialog.
@@ -379,49 +662,19 @@ lib_model_filter_visible_func (GtkTreeModel *model,
                                       gpointer      data)
 {
   Compselect *compselect = (Compselect*)data;
-  CLibSymbol *sym;
-  const gchar *compname;
-  gchar *compname_upper, *text_upper, *pattern;
-  const gchar *text;
-  gboolean ret;
+  gpointer item;
 
   g_assert (IS_COMPSELECT (data));
 
-  text = gtk_entry_get_text (compselect->entry_filter);
-  if (g_ascii_strcasecmp (text, "") == 0) {
+  if (compselect->filter_index == NULL ||
+      compselect->filter_index->text == NULL) {
     return TRUE;
   }
 
-  /* If this is a source, only display it if it has children that
-   * match */
-  if (gtk_tree_model_iter_has_child (model, iter)) {
-    GtkTreeIter iter2;
-
-    gtk_tree_model_iter_children (model, &iter2, iter);
-    ret = FALSE;
-    do {
-      if (lib_model_filter_visible_func (model, &iter2, data)) {
-        ret = TRUE;
-        break;
-      }
-    } while (gtk_tree_model_iter_next (model, &iter2));
-  } else {
-    gtk_tree_model_get (model, iter,
-                        0, &sym,
-                        -1);
-    compname = s_clib_symbol_get_name (sym);
-    /* Do a case insensitive comparison, converting the strings
-       to uppercase */
-    compname_upper = g_ascii_strup (compname, -1);
-    text_upper = g_ascii_strup (text, -1);
-    pattern = g_strconcat ("*", text_upper, "*", NULL);
-    ret = g_pattern_match_simple (pattern, compname_upper);
-    g_free (compname_upper);
-    g_free (text_upper);
-    g_free (pattern);
-  }
-
-  return ret;
+  /* Sources are only visible if they have children that match */
+  gtk_tree_model_get (model, iter, 0, &item, -1);
+  return (g_hash_table_lookup (compselect->filter_index->visible,
+                               item) != NULL);
 }
 
 
@@ -550,44 +803,110 @@ update_attributes_model (Compselect *compselect, TOPLEVEL *preview_toplevel)
   g_list_free (o_attrlist);
 }
 
-/*! \brief Handles changes in the treeview selection.
+/*! \brief Returns a symbol next to the selected one.
  *  \par Function Description
- *  This is the callback function that is called every time the user
- *  select a row in either component treeview of the dialog.
- *
- *  If the selection is not a selection of a component (a directory
- *  name), it does nothing. Otherwise it retrieves the #CLibSymbol
- *  from the model.
- *
- *  It then emits the dialog's <B>apply</B> signal to let its parent
- *  know that a component has been selected.
+ *  Looks up the symbol in the row after (or before) the selected row
+ *  of the active view of the dialog.
  *
- *  \param [in] selection The current selection in the treeview.
- *  \param [in] user_data The component selection dialog.
+ *  \param [in] compselect The component selection dialog.
+ *  \param [in] next       TRUE for the next row, FALSE for the previous.
+ *  \returns The neighbouring symbol, or NULL if there is none.
  */
-static void
-compselect_callback_tree_selection_changed (GtkTreeSelection *selection,
-                                            gpointer          user_data)
+static CLibSymbol *
+compselect_get_neighbour_symbol (Compselect *compselect, gboolean next)
 {
   GtkTreeView *view;
   GtkTreeModel *model;
   GtkTreeIter iter, parent;
-  Compselect *compselect = (Compselect*)user_data;
-  const CLibSymbol *sym = NULL;
-  gchar *buffer = NULL;
+  GtkTreePath *path;
+  CLibSymbol *symbol = NULL;
+  gboolean found;
 
-  if (gtk_tree_selection_get_selected (selection, &model, &iter)) {
+  view = (compselect_get_view (compselect) == VIEW_INUSE) ?
+    compselect->inusetreeview : compselect->libtreeview;
 
-    view = gtk_tree_selection_get_tree_view (selection);
-    if (view == compselect->inusetreeview ||
-        /* No special handling required */
-        (view == compselect->libtreeview &&
-         gtk_tree_model_iter_parent (model, &parent, &iter))) {
-         /* Tree view needs to check that we're at a leaf node */
+  if (!gtk_tree_selection_get_selected (gtk_tree_view_get_selection (view),
+                                        &model, &iter)) {
+    return NULL;
+  }
 
-      gtk_tree_model_get (model, &iter, 0, &sym, -1);
-      buffer = s_clib_symbol_get_data (sym);
-    }
+  /* In the library view, only leaf nodes are symbols */
+  if (view == compselect->libtreeview &&
+      !gtk_tree_model_iter_parent (model, &parent, &iter)) {
+    return NULL;
+  }
+
+  if (next) {
+    found = gtk_tree_model_iter_next (model, &iter);
+  } else {
+    path = gtk_tree_model_get_path (model, &iter);
+    found = (gtk_tree_path_prev (path) &&
+             gtk_tree_model_get_iter (model, &iter, path));
+    gtk_tree_path_free (path);
+  }
+
+  if (found) {
+    gtk_tree_model_get (model, &iter, 0, &symbol, -1);
+  }
+
+  return symbol;
+}
+
+/*! \brief Loads the symbols next to the selected one in the background.
+ *  \par Function Description
+ *  This is the idle function which loads the symbols in the rows after
+ *  and before the selected one into the preview cache, one symbol per
+ *  call, so that moving the selection by one row is immediate.
+ *
+ *  \param [in] data The component selection dialog.
+ *  \returns FALSE to remove the idle source when done.
+ */
+static gboolean
+compselect_prefetch_idle (gpointer data)
+{
+  Compselect *compselect = COMPSELECT (data);
+  CLibSymbol *symbol;
+  gchar *buffer;
+
+  symbol = compselect_get_neighbour_symbol (compselect,
+                                            compselect->prefetch_step == 0);
+
+  if (symbol != NULL) {
+    buffer = s_clib_symbol_get_data (symbol);
+    preview_prefetch (compselect->preview, buffer);
+    g_free (buffer);
+  }
+
+  if (++compselect->prefetch_step < 2) {
+    return TRUE;
+  }
+
+  compselect->prefetch_idle = 0;
+  return FALSE;
+}
+
+/*! \brief Updates the preview after the selection has settled.
+ *  \par Function Description
+ *  This is the timeout function which updates the preview and the
+ *  attribute list with the currently selected symbol. It then starts
+ *  loading the neighbouring symbols in the background.
+ *
+ *  \param [in] data The component selection dialog.
+ *  \returns FALSE to remove the timeout.
+ */
+static gboolean
+compselect_preview_timeout (gpointer data)
+{
+  Compselect *compselect = COMPSELECT (data);
+  CLibSymbol *sym = NULL;
+  gchar *buffer = NULL;
+
+  /* resets the source id in compselect */
+  compselect->preview_timeout = 0;
+
+  g_object_get (compselect, "symbol", &sym, NULL);
+  if (sym != NULL) {
+    buffer = s_clib_symbol_get_data (sym);
   }
 
   /* update the preview with new symbol data */
@@ -601,13 +920,69 @@ compselect_callback_tree_selection_changed (GtkTreeSelection *selection,
     update_attributes_model (compselect,
                              compselect->preview->preview_w_current->toplevel);
 
+  g_free (buffer);
+
+  if (sym != NULL) {
+    compselect->prefetch_step = 0;
+    compselect->prefetch_idle = g_idle_add_full (G_PRIORITY_LOW,
+                                                 compselect_prefetch_idle,
+                                                 compselect, NULL);
+  }
+
+  /* return FALSE to remove the source */
+  return FALSE;
+}
+
+/*! \brief Cancels pending preview work.
+ *  \par Function Description
+ *  Removes the preview timeout and the prefetch idle function of the
+ *  dialog, if any.
+ *
+ *  \param [in] compselect The component selection dialog.
+ */
+static void
+compselect_cancel_preview (Compselect *compselect)
+{
+  if (compselect->preview_timeout != 0) {
+    g_source_remove (compselect->preview_timeout);
+    compselect->preview_timeout = 0;
+  }
+
+  if (compselect->prefetch_idle != 0) {
+    g_source_remove (compselect->prefetch_idle);
+    compselect->prefetch_idle = 0;
+  }
+}
+
+/*! \brief Handles changes in the treeview selection.
+ *  \par Function Description
+ *  This is the callback function that is called every time the user
+ *  select a row in either component treeview of the dialog.
+ *
+ *  It emits the dialog's <B>apply</B> signal to let its parent know
+ *  that a component has been selected. The update of the preview is
+ *  deferred until the selection has stopped changing, and any preview
+ *  work still pending for the previous selection is cancelled.
+ *
+ *  \param [in] selection The current selection in the treeview.
+ *  \param [in] user_data The component selection dialog.
+ */
+static void
+compselect_callback_tree_selection_changed (GtkTreeSelection *selection,
+                                            gpointer          user_data)
+{
+  Compselect *compselect = (Compselect*)user_data;
+
+  compselect_cancel_preview (compselect);
+  compselect->preview_timeout = g_timeout_add (COMPSELECT_PREVIEW_INTERVAL,
+                                               compselect_preview_timeout,
+                                               compselect);
+
   /* signal a component has been selected to parent of dialog */
   g_signal_emit_by_name (compselect,
                          "response",
                          COMPSELECT_RESPONSE_PLACE,
                          NULL);
-
-  g_free (buffer);
 }
 
 /*! \brief Requests re-evaluation of the filter.
@@ -634,6 +1009,7 @@ compselect_filter_timeout (gpointer data)
 
   if (model != NULL) {
     const gchar *text = gtk_entry_get_text (compselect->entry_filter);
+    filter_index_update (compselect->filter_index, text);
     gtk_tree_model_filter_refilter ((GtkTreeModelFilter*)model);
     if (strcmp (text, "") != 0) {
       /* filter text not-empty */
@@ -781,6 +1157,10 @@ create_lib_tree_model (Compselect *compselect)
 
   store = (GtkTreeStore*)gtk_tree_store_new (1, G_TYPE_POINTER);
 
+  /* the filter index is rebuilt along with the store */
+  filter_index_free (compselect->filter_index);
+  compselect->filter_index = filter_index_new ();
+
   /* populate component store */
   srchead = s_clib_get_sources (GSCHEM_DIALOG (compselect)->w_current->sort_component_library != 0);
   for (srclist = srchead;
@@ -803,12 +1183,21 @@ create_lib_tree_model (Compselect *compselect)
       gtk_tree_store_set (store, &iter2,
                           0, symlist->data,
                           -1);
+
+      filter_index_add (compselect->filter_index,
+                        (CLibSource *)srclist->data,
+                        (CLibSymbol *)symlist->data);
     }
 
     g_list_free (symhead);
   }
   g_list_free (srchead);
 
+  if (compselect->entry_filter != NULL) {
+    filter_index_update (compselect->filter_index,
+                         gtk_entry_get_text (compselect->entry_filter));
+  }
+
   return (GtkTreeModel*)store;
 }
 
@@ -1479,6 +1868,10 @@ compselect_constructor (GType type,
                                           GTK_RESPONSE_CLOSE,
                                           -1);
 
+  /* No preview work is pending yet */
+  compselect->preview_timeout = 0;
+  compselect->prefetch_idle = 0;
+
   /* Initialize the hidden property */
   compselect->hidden = FALSE;
 
@@ -1495,6 +1888,11 @@ compselect_finalize (GObject *object)
     compselect->filter_timeout = 0;
   }
 
+  compselect_cancel_preview (compselect);
+
+  filter_index_free (compselect->filter_index);
+  compselect->filter_index = NULL;
+
   G_OBJECT_CLASS (compselect_parent_class)->finalize (object);
 }
 
@@ -35,7 +35,6 @@
 
 /* used by mouse pan */
 int start_pan_x, start_pan_y;
-int throttle = 0;
 
 /* used for the stroke stuff */
 #ifdef HAVE_LIBSTROKE
@@ -99,6 +98,8 @@ gint x_event_button_pressed(GtkWidget *widget, GdkEventButton *event,
 
   g_return_val_if_fail ((w_current != NULL), 0);
 
+  x_event_motion_flush (w_current);
+
   scm_dynwind_begin (0);
   g_dynwind_window (w_current);
 
@@ -425,7 +426,6 @@ gint x_event_button_pressed(GtkWidget *widget, GdkEventButton *event,
       w_current->doing_pan = TRUE;
       start_pan_x = (int) event->x;
       start_pan_y = (int) event->y;
-      throttle=0;
       break;
     }
 
@@ -440,7 +440,6 @@ gint x_event_button_pressed(GtkWidget *widget, GdkEventButton *event,
         w_current->doing_pan = TRUE;
         start_pan_x = (int) event->x;
         start_pan_y = (int) event->y;
-        throttle=0;
       }
     } else { /* this is the default cancel */
       switch (w_current->event_state) {
@@ -529,6 +528,8 @@ gint x_event_button_released(GtkWidget *widget, GdkEventButton *event,
 
   g_return_val_if_fail ((w_current != NULL), 0);
 
+  x_event_motion_flush (w_current);
+
 #if DEBUG
   printf("released! %d \n", w_current->event_state);
 #endif
@@ -719,75 +720,48 @@ gint x_event_button_released(GtkWidget *widget, GdkEventButton *event,
   return(0);
 }
 
-/*! \todo Finish function documentation!!!
- *  \brief
+/*! \brief Handle the latest pointer position
  *  \par Function Description
+ *  Updates the rubberband geometry of the current action for the
+ *  pointer position and modifier state last stored by
+ *  x_event_motion(). This is called at most once per
+ *  #MOTION_FRAME_INTERVAL, however many motion events arrived since.
  *
+ *  \param [in] w_current  The GSCHEM_TOPLEVEL object.
  */
-gint x_event_motion(GtkWidget *widget, GdkEventMotion *event,
-                    GSCHEM_TOPLEVEL *w_current)
+static void x_event_motion_process (GSCHEM_TOPLEVEL *w_current)
 {
   int pdiff_x, pdiff_y;
   int w_x, w_y;
   int unsnapped_wx, unsnapped_wy;
-  int skip_event=0;
-  GdkEvent *test_event;
+  int x = w_current->motion_x;
+  int y = w_current->motion_y;
 
-  g_return_val_if_fail ((w_current != NULL), 0);
-
-  w_current->SHIFTKEY   = (event->state & GDK_SHIFT_MASK  ) ? 1 : 0;
-  w_current->CONTROLKEY = (event->state & GDK_CONTROL_MASK) ? 1 : 0;
-  w_current->ALTKEY     = (event->state & GDK_MOD1_MASK) ? 1 : 0;
-
-#if DEBUG
-  /*  printf("MOTION!\n");*/
-#endif
-
-#ifdef HAVE_LIBSTROKE
-  if (DOING_STROKE == TRUE) {
-    x_stroke_record (w_current, event->x, event->y);
-    return(0);
-  }
-#endif /* HAVE_LIBSTROKE */
+  g_get_current_time (&w_current->motion_time);
 
-  /* skip the moving event if there are other moving events in the
-     gdk event queue (Werner)
-     Only skip the event if is the same event and no buttons or modifier
-     keys changed*/
-  if ((test_event = gdk_event_get()) != NULL) {
-    if (test_event->type == GDK_MOTION_NOTIFY
-        && ((GdkEventMotion *) test_event)->state == event->state) {
-      skip_event= 1;
-    }
-    gdk_event_put(test_event); /* put it back in front of the queue */
-    gdk_event_free(test_event);
-    if (skip_event == 1)
-      return 0;
-  }
+  w_current->SHIFTKEY   = (w_current->motion_state & GDK_SHIFT_MASK  ) ? 1 : 0;
+  w_current->CONTROLKEY = (w_current->motion_state & GDK_CONTROL_MASK) ? 1 : 0;
+  w_current->ALTKEY     = (w_current->motion_state & GDK_MOD1_MASK) ? 1 : 0;
 
-  SCREENtoWORLD (w_current, (int) event->x, (int) event->y,
-                 &unsnapped_wx, &unsnapped_wy);
+  SCREENtoWORLD (w_current, x, y, &unsnapped_wx, &unsnapped_wy);
   w_x = snap_grid (w_current, unsnapped_wx);
   w_y = snap_grid (w_current, unsnapped_wy);
 
   if (w_current->cowindow) {
-    coord_display_update(w_current, (int) event->x, (int) event->y);
+    coord_display_update(w_current, x, y);
   }
   if (w_current->third_button == MOUSEPAN_ENABLED || w_current->middle_button == MID_MOUSEPAN_ENABLED) {
     if((w_current->event_state == MOUSEPAN) &&
        w_current->inside_action) {
-         pdiff_x = (int) event->x - start_pan_x;
-         pdiff_y = (int) event->y - start_pan_y;
-
-         if (!(throttle % 5)) {
-           a_pan_mouse(w_current, pdiff_x*w_current->mousepan_gain,
-                       pdiff_y*w_current->mousepan_gain);
-
-           start_pan_x = (int) event->x;
-           start_pan_y = (int) event->y;
-         }
-         throttle++;
-         return(0);
+         pdiff_x = x - start_pan_x;
+         pdiff_y = y - start_pan_y;
+
+         a_pan_mouse(w_current, pdiff_x*w_current->mousepan_gain,
+                     pdiff_y*w_current->mousepan_gain);
+
+         start_pan_x = x;
+         start_pan_y = y;
+         return;
        }
   }
 
@@ -907,7 +881,99 @@ gint x_event_motion(GtkWidget *widget, GdkEventMotion *event,
   }
 
   scm_dynwind_end ();
+}
+
+/*! \brief Handle the pending pointer motion of the next frame
+ *  \par Function Description
+ *  Timeout callback scheduled by x_event_motion() when motion arrives
+ *  sooner than #MOTION_FRAME_INTERVAL after the last one was handled.
+ *
+ *  \param [in] data  The GSCHEM_TOPLEVEL object.
+ *  \returns FALSE to remove the timeout.
+ */
+static gboolean x_event_motion_timeout (gpointer data)
+{
+  GSCHEM_TOPLEVEL *w_current = (GSCHEM_TOPLEVEL *) data;
+
+  w_current->motion_source = 0;
+  x_event_motion_process (w_current);
+
+  return FALSE;
+}
 
+/*! \brief Handle pointer motion which is still waiting for its frame
+ *  \par Function Description
+ *  Button and key handlers call this first, so that the rubberband
+ *  geometry they act on matches the last position of the pointer.
+ *
+ *  \param [in] w_current  The GSCHEM_TOPLEVEL object.
+ */
+void x_event_motion_flush (GSCHEM_TOPLEVEL *w_current)
+{
+  if (w_current->motion_source == 0)
+    return;
+
+  g_source_remove (w_current->motion_source);
+  w_current->motion_source = 0;
+  x_event_motion_process (w_current);
+}
+
+/*! \brief Handle pointer motion in the drawing area
+ *  \par Function Description
+ *  Records the pointer position and modifier state of a motion event
+ *  and handles it at most once per #MOTION_FRAME_INTERVAL. The drawing
+ *  area asks for motion hints, so the server sends a single event until
+ *  the position is read back here and events never pile up in the queue.
+ */
+gint x_event_motion(GtkWidget *widget, GdkEventMotion *event,
+                    GSCHEM_TOPLEVEL *w_current)
+{
+  GdkModifierType state;
+  GTimeVal now;
+  glong elapsed;
+  gint x, y;
+
+  g_return_val_if_fail ((w_current != NULL), 0);
+
+  if (event->is_hint) {
+    gdk_window_get_pointer (event->window, &x, &y, &state);
+  } else {
+    x = (int) event->x;
+    y = (int) event->y;
+    state = event->state;
+  }
+
+#if DEBUG
+  /*  printf("MOTION!\n");*/
+#endif
+
+#ifdef HAVE_LIBSTROKE
+  if (DOING_STROKE == TRUE) {
+    x_stroke_record (w_current, x, y);
+    return(0);
+  }
+#endif /* HAVE_LIBSTROKE */
+
+  w_current->motion_x = x;
+  w_current->motion_y = y;
+  w_current->motion_state = state;
+
+  /* already waiting for the next frame */
+  if (w_current->motion_source != 0)
+    return(0);
+
+  g_get_current_time (&now);
+  elapsed = (now.tv_sec  - w_current->motion_time.tv_sec) * 1000 +
+            (now.tv_usec - w_current->motion_time.tv_usec) / 1000;
+
+  if (elapsed >= 0 && elapsed < MOTION_FRAME_INTERVAL) {
+    w_current->motion_source =
+      g_timeout_add (MOTION_FRAME_INTERVAL - elapsed,
+                     x_event_motion_timeout, w_current);
+    return(0);
+  }
+
+  x_event_motion_process (w_current);
   return(0);
 }
 
@@ -1180,6 +1246,8 @@ gboolean x_event_key (GtkWidget *widget, GdkEventKey *event,
   printf("x_event_key_pressed: Pressed key %i.\n", event->keyval);
 #endif
 
+  x_event_motion_flush (w_current);
+
   /* update the state of the modifiers */
   w_current->ALTKEY     = (event->state & GDK_MOD1_MASK)    ? 1 : 0;
   w_current->SHIFTKEY   = (event->state & GDK_SHIFT_MASK)   ? 1 : 0;
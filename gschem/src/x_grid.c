@@ -81,6 +81,11 @@ static int query_dots_grid_spacing (GSCHEM_TOPLEVEL *w_current)
  *  \par Function Description
  *  Draws the dotted grid pattern over a given region of the screen.
  *
+ *  The region is clipped to the page extents once up front, and the
+ *  screen coordinates of each grid column and row are computed once,
+ *  so the inner loop only copies precomputed coordinates into the
+ *  point buffer.
+ *
  *  \param [in] w_current  The GSCHEM_TOPLEVEL.
  *  \param [in] x          The left screen coordinate for the drawing.
  *  \param [in] y          The top screen coordinate for the drawing.
@@ -90,10 +95,12 @@ static int query_dots_grid_spacing (GSCHEM_TOPLEVEL *w_current)
 static void draw_dots_grid_region (GSCHEM_TOPLEVEL *w_current,
                                    int x, int y, int width, int height)
 {
-  TOPLEVEL *toplevel = w_current->toplevel;
+  PAGE *page = w_current->toplevel->page_current;
   int i, j;
   int dot_x, dot_y;
   int x_start, y_start, x_end, y_end;
+  int num_cols, num_rows;
+  int *col_x;
   int count = 0;
   GdkPoint points[DOTS_POINTS_ARRAY_SIZE];
 
@@ -107,38 +114,55 @@ static void draw_dots_grid_region (GSCHEM_TOPLEVEL *w_current,
   SCREENtoWORLD (w_current, x - 1, y + height + 1, &x_start, &y_start);
   SCREENtoWORLD (w_current, x + width + 1, y - 1, &x_end, &y_end);
 
+  /* clip to the page extents, so no dot needs an inside_region test */
+  x_start = max (x_start, page->left);
+  y_start = max (y_start, page->top);
+  x_end = min (x_end, page->right);
+  y_end = min (y_end, page->bottom);
+
   /* figure starting grid coordinates, work by taking the start
    * and end coordinates and rounding down to the nearest
    * increment */
   x_start -= (x_start % incr);
   y_start -= (y_start % incr);
+  if (x_start < page->left) x_start += incr;
+  if (y_start < page->top)  y_start += incr;
+
+  if (x_start > x_end || y_start > y_end)
+    return;
+
+  num_cols = (x_end - x_start) / incr + 1;
+  num_rows = (y_end - y_start) / incr + 1;
 
-  for (i = x_start; i <= x_end; i = i + incr) {
-    for(j = y_start; j <= y_end; j = j + incr) {
-      WORLDtoSCREEN (w_current, i,j, &dot_x, &dot_y);
-      if (inside_region (toplevel->page_current->left,
-                         toplevel->page_current->top,
-                         toplevel->page_current->right,
-                         toplevel->page_current->bottom, i, j)) {
-
-        if (w_current->dots_grid_dot_size == 1) {
-          points[count].x = dot_x;
-          points[count].y = dot_y;
-          count++;
-
-          /* get out of loop if we're hit the end of the array */
-          if (count == DOTS_POINTS_ARRAY_SIZE) {
-            gdk_draw_points (w_current->drawable,
-                             w_current->gc, points, count);
-            count = 0;
-          }
-        } else {
-          gdk_draw_arc (w_current->drawable, w_current->gc,
-                        TRUE, dot_x, dot_y,
-                        w_current->dots_grid_dot_size,
-                        w_current->dots_grid_dot_size, 0, FULL_CIRCLE);
+  /* screen x coordinates are the same for every row */
+  col_x = g_new (int, num_cols);
+  for (i = 0; i < num_cols; i++) {
+    WORLDtoSCREEN (w_current, x_start + i * incr, y_start, &col_x[i], &dot_y);
+  }
+
+  for (j = 0; j < num_rows; j++) {
+    WORLDtoSCREEN (w_current, x_start, y_start + j * incr, &dot_x, &dot_y);
+
+    if (w_current->dots_grid_dot_size == 1) {
+      for (i = 0; i < num_cols; i++) {
+        points[count].x = col_x[i];
+        points[count].y = dot_y;
+        count++;
+
+        /* get out of loop if we're hit the end of the array */
+        if (count == DOTS_POINTS_ARRAY_SIZE) {
+          gdk_draw_points (w_current->drawable,
+                           w_current->gc, points, count);
+          count = 0;
         }
       }
+    } else {
+      for (i = 0; i < num_cols; i++) {
+        gdk_draw_arc (w_current->drawable, w_current->gc,
+                      TRUE, col_x[i], dot_y,
+                      w_current->dots_grid_dot_size,
+                      w_current->dots_grid_dot_size, 0, FULL_CIRCLE);
+      }
     }
   }
 
@@ -146,6 +170,8 @@ static void draw_dots_grid_region (GSCHEM_TOPLEVEL *w_current,
   if(count != 0) {
     gdk_draw_points (w_current->drawable, w_current->gc, points, count);
   }
+
+  g_free (col_x);
 }
 
 
@@ -59,6 +59,15 @@ static void log_init       (Log *log);
 
 static GtkWidget *log_dialog = NULL;
 
+/* The thread which runs the user interface */
+static GThread *log_thread = NULL;
+
+/*! \brief A message logged from another thread */
+typedef struct {
+  GLogLevelFlags log_level;
+  gchar *message;
+} LogDeferred;
+
 /*!
  *  \brief Open the Log window
  *
@@ -100,6 +109,7 @@ void x_log_open ()
     log_message (LOG (log_dialog), contents, "old");
     g_free (contents);
 
+    log_thread = g_thread_self ();
     x_log_update_func = x_log_message;
    
     if( auto_place_mode )
@@ -128,11 +138,35 @@ void x_log_close ()
 
 }
 
+/*!
+ *  \brief Add a message from another thread to the Log window
+ *  \par Function Description
+ *  Idle callback which adds a message deferred by x_log_message() to
+ *  the Log window, unless it has been closed since.  The message is
+ *  in the log file already.
+ *  \param [in] data  The LogDeferred message.
+ *  \return FALSE, to run only once.
+ */
+static gboolean x_log_message_deferred (gpointer data)
+{
+  LogDeferred *deferred = data;
+
+  if (log_dialog != NULL) {
+    x_log_message (NULL, deferred->log_level, deferred->message);
+  }
+  g_free (deferred->message);
+  g_free (deferred);
+  return FALSE;
+}
+
 /*!
  *  \brief Add a message to the Log window
  *  \par Function Description
  *  Add a message to the Log window.
  *  Calls log_message() to do the actual logging.
+ *
+ *  Messages logged from other threads, such as the autosave thread,
+ *  are passed to the main loop and added from there.
  *  \param [in] log_domain
  *  \param [in] log_level The severity of the message
  *  \param [in] message   The message to be displayed
@@ -141,6 +175,15 @@ void x_log_message (const gchar *log_domain, GLogLevelFlags log_level,
                     const gchar *message)
 {
   gchar *style;
+
+  if (g_thread_self () != log_thread) {
+    LogDeferred *deferred = g_new (LogDeferred, 1);
+    deferred->log_level = log_level;
+    deferred->message = g_strdup (message);
+    g_idle_add (x_log_message_deferred, deferred);
+    return;
+  }
+
   g_return_if_fail (log_dialog != NULL);
 
   if (log_level & (G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_ERROR)) {
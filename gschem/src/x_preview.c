@@ -38,6 +38,16 @@
 
 #define OVER_ZOOM_FACTOR 0.1
 
+/*! \def PREVIEW_CACHE_SIZE
+ *  \brief Number of previewed symbols kept loaded
+ *
+ *  Each symbol shown in the preview is kept in its own page of the
+ *  preview's TOPLEVEL, so that going back to a recently previewed
+ *  symbol does not parse it again.  Least recently used pages are
+ *  deleted once there are more than this many.
+ */
+#define PREVIEW_CACHE_SIZE 16
+
 
 enum {
   PROP_FILENAME=1,
@@ -188,12 +198,148 @@ preview_callback_button_press (GtkWidget *widget,
 }
 
 
+/*! \brief Loads symbol data into a new page of the preview.
+ *  \par Function Description
+ *  Creates a page in the TOPLEVEL of the preview and loads the
+ *  objects described by <B>buffer</B> into it.  If the data can not
+ *  be parsed, the page holds the error message instead.  The current
+ *  page of the TOPLEVEL is left unchanged.
+ *
+ *  \param [in] preview The preview widget.
+ *  \param [in] buffer  The symbol data to load.
+ *  \returns The new page.
+ */
+static PAGE *
+preview_load_buffer (Preview *preview, const gchar *buffer)
+{
+  TOPLEVEL *preview_toplevel = preview->preview_w_current->toplevel;
+  PAGE *saved_page = preview_toplevel->page_current;
+  PAGE *page;
+  GList *objects;
+  GError *err = NULL;
+
+  page = s_page_new (preview_toplevel, "preview");
+  s_page_goto (preview_toplevel, page);
+
+  objects = o_read_buffer (preview_toplevel, NULL, (char *) buffer, -1,
+                           _("Preview Buffer"), &err);
+
+  if (err == NULL) {
+    s_page_append_list (preview_toplevel, page, objects);
+  }
+  else {
+    s_page_append (preview_toplevel, page,
+                   o_text_new(preview_toplevel, OBJ_TEXT, 2, 100, 100, LOWER_MIDDLE, 0,
+                              err->message, 10, VISIBLE, SHOW_NAME_VALUE));
+    g_error_free(err);
+  }
+
+  if (saved_page != NULL) {
+    s_page_goto (preview_toplevel, saved_page);
+  }
+
+  return page;
+}
+
+/*! \brief Tests whether a page of the preview is in the page cache.
+ *  \par Function Description
+ *  \param [in] preview The preview widget.
+ *  \param [in] page    The page to look for.
+ *  \returns TRUE if <B>page</B> holds cached symbol data.
+ */
+static gboolean
+preview_page_is_cached (Preview *preview, PAGE *page)
+{
+  GList *iter;
+
+  for (iter = g_queue_peek_head_link (preview->page_lru);
+       iter != NULL; iter = g_list_next (iter)) {
+    if (g_hash_table_lookup (preview->page_cache, iter->data) == page) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/*! \brief Returns the page holding some symbol data.
+ *  \par Function Description
+ *  Looks <B>buffer</B> up in the page cache of the preview, loading
+ *  it into a new page if it is not there.  The page becomes the most
+ *  recently used one, and the least recently used pages are deleted
+ *  if the cache is full.  The current page is never deleted.
+ *
+ *  \param [in] preview The preview widget.
+ *  \param [in] buffer  The symbol data.
+ *  \returns The page holding the objects of <B>buffer</B>.
+ */
+static PAGE *
+preview_get_buffer_page (Preview *preview, const gchar *buffer)
+{
+  TOPLEVEL *preview_toplevel = preview->preview_w_current->toplevel;
+  gchar *key;
+  PAGE *page;
+  GList *oldest;
+
+  if (g_hash_table_lookup_extended (preview->page_cache, buffer,
+                                    (gpointer *) &key, (gpointer *) &page)) {
+    g_queue_remove (preview->page_lru, key);
+    g_queue_push_head (preview->page_lru, key);
+    return page;
+  }
+
+  page = preview_load_buffer (preview, buffer);
+  key = g_strdup (buffer);
+  g_hash_table_insert (preview->page_cache, key, page);
+  g_queue_push_head (preview->page_lru, key);
+
+  while (g_queue_get_length (preview->page_lru) > PREVIEW_CACHE_SIZE) {
+    oldest = g_queue_peek_tail_link (preview->page_lru);
+    if (g_hash_table_lookup (preview->page_cache, oldest->data) ==
+        preview_toplevel->page_current) {
+      oldest = g_list_previous (oldest);
+    }
+
+    key = oldest->data;
+    s_page_delete (preview_toplevel,
+                   g_hash_table_lookup (preview->page_cache, key));
+    g_queue_delete_link (preview->page_lru, oldest);
+    g_hash_table_remove (preview->page_cache, key);
+  }
+
+  return page;
+}
+
+/*! \brief Loads symbol data ahead of it being previewed.
+ *  \par Function Description
+ *  Parses <B>buffer</B> into the page cache of the preview without
+ *  changing what is displayed, so that a later preview of the same
+ *  data is immediate.
+ *
+ *  \param [in] preview The preview widget.
+ *  \param [in] buffer  The symbol data to load.
+ */
+void
+preview_prefetch (Preview *preview, const gchar *buffer)
+{
+  g_return_if_fail (IS_PREVIEW (preview));
+
+  if (buffer == NULL ||
+      preview->preview_w_current->toplevel->page_current == NULL) {
+    return;
+  }
+
+  preview_get_buffer_page (preview, buffer);
+}
+
 /*! \brief Updates the preview widget.
  *  \par Function Description
  *  This function update the preview: if the preview is active and a
  *  filename has been given, it opens the file and display
  *  it. Otherwise it display a blank page.
  *
+ *  Symbol data given as a buffer is kept in the page cache, so it is
+ *  only parsed the first time it is previewed.
+ *
  *  \param [in] preview The preview widget.
  */
 static void
@@ -203,20 +349,24 @@ preview_update (Preview *preview)
   TOPLEVEL *preview_toplevel = preview_w_current->toplevel;
   int left, top, right, bottom;
   int width, height;
-  GError * err = NULL;
 
   if (preview_toplevel->page_current == NULL) {
     return;
   }
   
-  /* delete old preview, create new page */
-  /* it would be better to just resets current page - Fix me */
-  s_page_delete (preview_toplevel, preview_toplevel->page_current);
-  s_page_goto (preview_toplevel, s_page_new (preview_toplevel, "preview"));
-  
-  if (preview->active) {
-    g_assert ((preview->filename == NULL) || (preview->buffer == NULL));
-    if (preview->filename != NULL) {
+  /* delete old preview unless it is cached */
+  if (!preview_page_is_cached (preview, preview_toplevel->page_current)) {
+    s_page_delete (preview_toplevel, preview_toplevel->page_current);
+  }
+
+  if (preview->active && preview->buffer != NULL) {
+    g_assert (preview->filename == NULL);
+    s_page_goto (preview_toplevel,
+                 preview_get_buffer_page (preview, preview->buffer));
+  } else {
+    s_page_goto (preview_toplevel, s_page_new (preview_toplevel, "preview"));
+
+    if (preview->active && preview->filename != NULL) {
       /* open up file in current page */
       f_open_flags (preview_toplevel, preview_toplevel->page_current,
                     preview->filename,
@@ -224,23 +374,6 @@ preview_update (Preview *preview)
       /* test value returned by f_open... - Fix me */
       /* we should display something if there an error occured - Fix me */
     }
-    if (preview->buffer != NULL) {
-      /* Load the data buffer */
-      GList * objects = o_read_buffer (preview_toplevel,
-                                       NULL, preview->buffer, -1,
-                                       _("Preview Buffer"), &err);
-
-      if (err == NULL) {
-        s_page_append_list (preview_toplevel, preview_toplevel->page_current,
-                            objects);
-      }
-      else {
-        s_page_append (preview_toplevel, preview_toplevel->page_current,
-                       o_text_new(preview_toplevel, OBJ_TEXT, 2, 100, 100, LOWER_MIDDLE, 0,
-                                  err->message, 10, VISIBLE, SHOW_NAME_VALUE));
-        g_error_free(err);
-      }
-    }
   }
 
   if (world_get_object_glist_bounds (preview_toplevel,
@@ -380,9 +513,8 @@ preview_init (Preview *preview)
                                    o_text_get_rendered_bounds,
                                    preview_w_current);
 
-  o_add_change_notify (preview_w_current->toplevel,
-                       (ChangeNotifyFunc) o_invalidate,
-                       (ChangeNotifyFunc) o_invalidate,
+  o_add_damage_notify (preview_w_current->toplevel,
+                       (DamageNotifyFunc) o_invalidate_world_rect,
                        preview_w_current);
 
   i_vars_set (preview_w_current);
@@ -413,6 +545,10 @@ preview_init (Preview *preview)
   preview->active   = FALSE;
   preview->filename = NULL;
   preview->buffer   = NULL;
+
+  preview->page_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                               g_free, NULL);
+  preview->page_lru   = g_queue_new ();
   
   gtk_widget_set_events (GTK_WIDGET (preview), 
                          GDK_EXPOSURE_MASK | 
@@ -506,6 +642,12 @@ preview_dispose (GObject *self)
     preview_w_current->drawing_area = NULL;
 
     x_window_free_gc (preview_w_current);
+
+    /* the cached pages are deleted along with the toplevel */
+    g_hash_table_destroy (preview->page_cache);
+    g_queue_free (preview->page_lru);
+    preview->page_cache = NULL;
+    preview->page_lru = NULL;
     
     s_toplevel_delete (preview_w_current->toplevel);
     g_free (preview_w_current);
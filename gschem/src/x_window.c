@@ -157,6 +157,7 @@ void x_window_setup_draw_events(GSCHEM_TOPLEVEL *w_current)
   gtk_widget_set_events (w_current->drawing_area,
                          GDK_EXPOSURE_MASK |
                          GDK_POINTER_MOTION_MASK |
+                         GDK_POINTER_MOTION_HINT_MASK |
                          GDK_BUTTON_PRESS_MASK   |
                          GDK_ENTER_NOTIFY_MASK |
                          GDK_KEY_PRESS_MASK |
@@ -629,6 +630,15 @@ void x_window_close(GSCHEM_TOPLEVEL *w_current)
     g_list_free(toplevel->major_changed_refdes);
   }
 
+  /* drop pointer motion still waiting for its frame */
+  if (w_current->motion_source != 0) {
+    g_source_remove (w_current->motion_source);
+    w_current->motion_source = 0;
+  }
+
+  /* finish writing autosave backups of this window's pages */
+  o_autosave_wait (w_current);
+
   /* stuff that has to be done before we free w_current */
   if (last_window) {
     /* close the log file */
@@ -1245,7 +1245,7 @@ s_check_connections (const GList *obj_list, SYMCHECK *s_current)
   for (iter = obj_list; iter != NULL; iter = g_list_next (iter)) {
     OBJECT *o_current = iter->data;
 
-    if (o_current->conn_list) {
+    if (o_current->conns) {
       message = 
         g_strdup ("Found a connection inside a symbol\n");
       s_current->error_messages = g_list_append(s_current->error_messages,
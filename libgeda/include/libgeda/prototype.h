@@ -59,6 +59,7 @@ void PAPERSIZEtoWORLD(int width, int height, int border, int *right, int *bottom
 void m_hatch_box(BOX *box, gint angle, gint pitch, GArray *lines);
 void m_hatch_circle(CIRCLE *circle, gint angle, gint pitch, GArray *lines);
 void m_hatch_path(PATH *path, gint angle, gint pitch, GArray *lines);
+GArray *m_hatch_object(OBJECT *object);
 
 /* m_polygon.c */
 void m_polygon_append_bezier(GArray *points, BEZIER *bezier, int segments);
@@ -113,8 +114,13 @@ PAGE *o_get_page (TOPLEVEL *toplevel, OBJECT *object);
 OBJECT *o_get_parent (TOPLEVEL *toplevel, OBJECT *object);
 void o_add_change_notify(TOPLEVEL *toplevel, ChangeNotifyFunc pre_change_func, ChangeNotifyFunc change_func, void *user_data);
 void o_remove_change_notify(TOPLEVEL *toplevel, ChangeNotifyFunc pre_change_func, ChangeNotifyFunc change_func, void *user_data);
+void o_add_damage_notify (TOPLEVEL *toplevel, DamageNotifyFunc damage_func, void *user_data);
+void o_remove_damage_notify (TOPLEVEL *toplevel, DamageNotifyFunc damage_func, void *user_data);
+void o_change_notify_freeze (TOPLEVEL *toplevel);
+void o_change_notify_thaw (TOPLEVEL *toplevel);
 gboolean o_is_visible (TOPLEVEL *toplevel, OBJECT *object);
 void o_set_visibility (TOPLEVEL *toplevel, OBJECT *object, int visibility);
+const gchar *o_get_name (OBJECT *object);
 OBJECT_END o_get_line_end (int capstyle);
 
 /* o_box_basic.c */
@@ -221,6 +227,7 @@ void o_picture_translate_world(TOPLEVEL *toplevel, int dx, int dy, OBJECT *objec
 OBJECT *o_picture_copy(TOPLEVEL *toplevel, OBJECT *o_current) G_GNUC_WARN_UNUSED_RESULT;
 gboolean o_picture_is_embedded (TOPLEVEL *toplevel, OBJECT *object);
 GdkPixbuf *o_picture_get_pixbuf (TOPLEVEL *toplevel, OBJECT *object) G_GNUC_WARN_UNUSED_RESULT;
+GdkPixbuf *o_picture_get_pixbuf_for_size (TOPLEVEL *toplevel, OBJECT *object, int width, int height) G_GNUC_WARN_UNUSED_RESULT;
 const char *o_picture_get_data (TOPLEVEL *toplevel, OBJECT *object,
                                 size_t *len);
 gboolean o_picture_set_from_buffer (TOPLEVEL *toplevel, OBJECT *object,
@@ -324,7 +331,10 @@ void s_color_map_from_scm (COLOR *map, SCM lst, const char *scheme_proc_name);
 /* s_conn.c */
 void s_conn_remove_object(TOPLEVEL *toplevel, OBJECT *to_remove);
 void s_conn_update_object(TOPLEVEL *toplevel, OBJECT *object);
-int s_conn_net_search(OBJECT* new_net, int whichone, GList * conn_list);
+CONN_UPDATE *s_conn_update_begin(TOPLEVEL *toplevel);
+void s_conn_update_add_object(CONN_UPDATE *update, OBJECT *object);
+void s_conn_update_end(CONN_UPDATE *update);
+int s_conn_net_search(OBJECT* new_net, int whichone, GArray * conns);
 GList *s_conn_return_others(GList *input_list, OBJECT *object);
 void s_conn_append_conns_changed_hook(TOPLEVEL *toplevel, ConnsChangedFunc func, void *data);
 void s_conn_emit_conns_changed(TOPLEVEL *toplevel, OBJECT *object);
@@ -386,6 +396,12 @@ void s_page_delete_objects (TOPLEVEL *toplevel, PAGE *page);
 const GList *s_page_objects (PAGE *page);
 GList *s_page_objects_in_region (TOPLEVEL *toplevel, PAGE *page, int min_x, int min_y, int max_x, int max_y);
 GList *s_page_objects_in_regions (TOPLEVEL *toplevel, PAGE *page, BOX *rects, int n_rects);
+gint s_page_compare_order (PAGE *page, OBJECT *object1, OBJECT *object2);
+OBJECT *s_page_find_nearest (TOPLEVEL *toplevel, PAGE *page, int x, int y, int radius, int type, gboolean (*accept) (OBJECT *, void *), void *accept_data, int *nearest_x, int *nearest_y, double *distance);
+void s_page_journal_start (PAGE *page);
+void s_page_journal_stop (PAGE *page);
+GHashTable *s_page_journal_take (PAGE *page);
+void s_page_journal_note (OBJECT *object);
 
 /* s_papersizes.c */
 int s_papersizes_add_entry(char *new_papersize, int width, int height);
@@ -429,6 +445,15 @@ void s_slib_print_dirs(void);
 char *s_slot_search_slot(OBJECT *object, OBJECT **return_found);
 void s_slot_update_object(TOPLEVEL *toplevel, OBJECT *object);
 
+/* s_string.c */
+const gchar *s_string_intern (const gchar *string);
+const gchar *s_string_intern_len (const gchar *string, gsize len);
+const gchar *s_string_lookup (const gchar *string);
+
+/* s_style.c */
+const OBJECT_STYLE *s_style_default (void);
+const OBJECT_STYLE *s_style_intern (const OBJECT_STYLE *style);
+
 /* s_tile.c */
 void s_tile_update_object(TOPLEVEL *toplevel, OBJECT *object);
 GList *s_tile_get_objectlists(TOPLEVEL *toplevel, PAGE *p_current, int world_x1, int world_y1, int world_x2, int world_y2);
@@ -438,7 +463,7 @@ UNDO *s_undo_return_tail(UNDO *head);
 UNDO *s_undo_return_head(UNDO *tail);
 UNDO *s_undo_new_head(void);
 void s_undo_destroy_head(UNDO *u_head);
-UNDO *s_undo_add(UNDO *head, int type, char *filename, GList *object_list, int left, int top, int right, int bottom, int page_control, int up);
+UNDO *s_undo_add(UNDO *head, int type, char *filename, GList *changes, int left, int top, int right, int bottom, int page_control, int up);
 void s_undo_print_all(UNDO *head);
 void s_undo_destroy_all(TOPLEVEL *toplevel, UNDO *head);
 void s_undo_remove(TOPLEVEL *toplevel, UNDO *head, UNDO *u_tos);
@@ -446,6 +471,12 @@ void s_undo_remove_rest(TOPLEVEL *toplevel, UNDO *head);
 int s_undo_levels(UNDO *head);
 void s_undo_init(PAGE *p_current);
 void s_undo_free_all(TOPLEVEL *toplevel, PAGE *p_current);
+UNDO_OBJECT *s_undo_object_new(TOPLEVEL *toplevel, OBJECT *object);
+UNDO_OBJECT *s_undo_object_ref(UNDO_OBJECT *state);
+void s_undo_object_unref(TOPLEVEL *toplevel, UNDO_OBJECT *state);
+void s_undo_free_changes(TOPLEVEL *toplevel, GList *changes);
+GList *s_undo_take_changes(TOPLEVEL *toplevel, PAGE *page);
+void s_undo_goto(TOPLEVEL *toplevel, PAGE *page, UNDO *target);
 
 /* u_basic.c */
 char *u_basic_breakup_string(char *string, char delimiter, int count);
@@ -36,20 +36,27 @@ typedef struct st_circle CIRCLE;
 typedef struct st_arc ARC;
 typedef struct st_box BOX;
 typedef struct st_picture PICTURE;
+typedef struct st_picture_image PICTURE_IMAGE;
 typedef struct st_text TEXT;
 typedef struct st_point sPOINT;
 typedef struct st_transform TRANSFORM;
 typedef struct st_bezier BEZIER;
 
 typedef struct st_object OBJECT;
+typedef struct st_object_style OBJECT_STYLE;
 typedef struct st_page PAGE;
 typedef struct st_toplevel TOPLEVEL;
 typedef struct st_color COLOR;
 typedef struct st_undo UNDO;
+typedef struct st_undo_object UNDO_OBJECT;
+typedef struct st_weak_refs WEAK_REFS;
+typedef struct st_undo_change UNDO_CHANGE;
 typedef struct st_tile TILE;
+typedef struct st_spatial_index SPATIAL_INDEX;
 typedef struct st_bounds BOUNDS;
 
 typedef struct st_conn CONN;
+typedef struct st_conn_update CONN_UPDATE;
 typedef struct st_bus_ripper BUS_RIPPER;
 
 /* netlist structures (gnetlist) */
@@ -157,9 +164,7 @@ struct st_box {
 #define BOX_LOWER_LEFT 3
 
 struct st_picture {
-  GdkPixbuf *pixbuf;
-  gchar *file_content;
-  gsize file_length;
+  PICTURE_IMAGE *image;	/* Shared image data, see o_picture.c */
 
   double ratio;
   char *filename;
@@ -184,6 +189,8 @@ struct st_text {
 
   char *string;			/* text stuff */
   char *disp_string;
+  const char *attrib_name;	/* interned name if string is name=value */
+  const char *attrib_value;	/* value part of string, or NULL */
   int length;
   int size;
   int alignment;	
@@ -201,6 +208,10 @@ struct st_complex {
   GList *prim_objs;			/* Primitive objects */
   /* objects which make up the */
   /* complex */
+
+  GList *changed_prims;			/* Primitives whose bounds changed */
+  /* since the bounds of the complex */
+  /* were found, see o_bounds_invalidate() */
 };
 
 struct st_circle {
@@ -211,12 +222,33 @@ struct st_circle {
 #define CIRCLE_CENTER 0
 #define CIRCLE_RADIUS 1
 
+/*! \brief Stroke and fill options of a graphical primitive.
+ *
+ * Depending on its nature a primitive is concerned with one or more
+ * of these fields. If not, their values must be ignored. Styles are
+ * shared between objects and must not be modified; see s_style.c.
+ */
+struct st_object_style {
+  OBJECT_END line_end;
+  OBJECT_TYPE line_type;
+  int line_width;
+  int line_space;
+  int line_length;
+
+  OBJECT_FILLING fill_type;
+  int fill_width;
+  int fill_angle1, fill_pitch1;
+  int fill_angle2, fill_pitch2;
+};
+
+/* The members used while drawing and hit-testing come first, so that
+ * a redraw or search touches as few cache lines per object as possible.
+ */
 struct st_object {
   int type;				/* Basic information */
-  int sid;
-  char *name;
-
-  PAGE *page; /* Parent page */
+  int selected;				/* object selected flag */
+  int visibility;
+  int color; 				/* Which color */
 
   int w_top;				/* Bounding box information */
   int w_left;				/* in world coords */
@@ -233,33 +265,28 @@ struct st_object {
   PICTURE *picture;
   PATH *path;
 
-  GList *tiles;			/* tiles */
+  const OBJECT_STYLE *style;		/* Shared line and fill options */
+  GArray *hatch_lines;			/* Cached hatch/mesh fill, see */
+  const OBJECT_STYLE *hatch_style;	/* m_hatch_object() */
 
-  GList *conn_list;			/* List of connections */
-  /* to and from this object */
+  PAGE *page; /* Parent page */
+  OBJECT *parent;                       /* Parent object pointer */
 
-  /* every graphical primitive have more or less the same options. */
-  /* depending on its nature a primitive is concerned with one or more */
-  /* of these fields. If not, value must be ignored. */
-  OBJECT_END line_end;
-  OBJECT_TYPE line_type;
-  int line_width;
-  int line_space;
-  int line_length;
+  int dont_redraw;			/* Flag to skip redrawing */
+  int selectable;			/* object selectable flag */
+  int show_name_value;
 
-  OBJECT_FILLING fill_type;
-  int fill_width;
-  int fill_angle1, fill_pitch1;
-  int fill_angle2, fill_pitch2;
+  int sid;
+  char *name;				/* Formatted on demand, see o_get_name() */
+
+  GPtrArray *tiles;			/* TILEs this object lies in */
+
+  GArray *conns;			/* CONNs to and from this object, */
+  /* stored by value; NULL if none */
 
   gboolean complex_embedded;                    /* is embedded component? */
   gchar *complex_basename;              /* Component Library Symbol name */
-  OBJECT *parent;                       /* Parent object pointer */
 
-  int color; 				/* Which color */
-  int dont_redraw;			/* Flag to skip redrawing */
-  int selectable;			/* object selectable flag */
-  int selected;				/* object selected flag */
   int locked_color; 			/* Locked color (used to save */
   /* the object's real color */
   /* when the object is locked) */
@@ -282,12 +309,10 @@ struct st_object {
   gboolean valid_num_connected;   /* for nets only */
 
   GList *attribs;       /* attribute stuff */
-  int show_name_value;
-  int visibility;
   OBJECT *attached_to;  /* when object is an attribute */
   OBJECT *copied_to;    /* used when copying attributes */
 
-  GList *weak_refs; /* Weak references */
+  WEAK_REFS *weak_refs; /* Weak references */
 
   /* Attribute notification handling */
   int attrib_notify_freeze_count;
@@ -345,12 +370,30 @@ struct st_transform {
   gdouble m[2][3];    /* m[row][column] */
 };
 
+/*! \brief saved state of one top-level object for in-memory undo
+ *
+ *  The copy of the object is never modified, so one UNDO_OBJECT is
+ *  shared by reference between undo levels and the page shadow.
+ */
+struct st_undo_object {
+  int ref_count;
+  OBJECT *object;   /* private copy of the object */
+  int attached_to;  /* sid of the object it was attached to, or -1 */
+};
+
+/*! \brief change to one top-level object between two undo levels */
+struct st_undo_change {
+  int sid;
+  UNDO_OBJECT *before;  /* NULL if the object did not exist */
+  UNDO_OBJECT *after;   /* NULL if the object was removed */
+};
+
 struct st_undo {
 
   /* one of these is used, depending on if you are doing in-memory */
   /* or file based undo state saving */	
   char *filename;
-  GList *object_list;
+  GList *changes;   /* UNDO_CHANGEs since the previous level */
 
   /* either UNDO_ALL or UNDO_VIEWPORT_ONLY */
   int type;
@@ -403,12 +446,21 @@ struct st_page {
 
   TILE world_tiles[MAX_TILES_X][MAX_TILES_Y];
 
+  SPATIAL_INDEX *spatial_index; /* index of objects by bounds */
+
   /* Undo/Redo Stacks and pointers */	
   /* needs to go into page mechanism actually */
   UNDO *undo_bottom;	
   UNDO *undo_current;
   UNDO *undo_tos; 	/* Top Of Stack */
 
+  /* In-memory undo: the state of each object when the page last matched
+   * undo_synced (sid -> UNDO_OBJECT), and the sids of the objects
+   * changed since then (sid -> OBJECT, or NULL if removed) */
+  GHashTable *undo_shadow;
+  UNDO *undo_synced;
+  GHashTable *journal;
+
   /* up and down the hierarchy */
   /* this holds the pid of the parent page */
   int up;
@@ -423,7 +475,7 @@ struct st_page {
   gint ops_since_last_backup;
   gchar do_autosave_backup;
 
-  GList *weak_refs; /* Weak references */
+  WEAK_REFS *weak_refs; /* Weak references */
 };
 
 /*! \brief Type of callback function for calculating text bounds */
@@ -432,6 +484,9 @@ typedef int(*RenderedBoundsFunc)(void *, OBJECT *, int *, int *, int *, int *);
 /*! \brief Type of callback function for object damage notification */
 typedef int(*ChangeNotifyFunc)(void *, OBJECT *);
 
+/*! \brief Type of callback function for damaged region notification */
+typedef void(*DamageNotifyFunc)(void *, int, int, int, int);
+
 /*! \brief Type of callback function for notification when a new TOPLEVEL is created */
 typedef void(*NewToplevelFunc)(TOPLEVEL *, void *);
 
@@ -568,6 +623,16 @@ struct st_toplevel {
   /* Callback functions for object change notification */
   GList *change_notify_funcs;
 
+  /* Callback functions for damaged region notification */
+  GList *damage_notify_funcs;
+
+  /* Coalesced change notification, see o_change_notify_freeze() */
+  int change_notify_freeze_count;
+  GHashTable *change_notify_batch;  /* set of objects changed in the batch */
+  GList *change_notify_order;       /* the same objects, newest first */
+  BOUNDS change_notify_damage;      /* merged bounds of those objects */
+  gboolean change_notify_damaged;
+
   /* Callback functions for object attribute change notification */
   GList *attribs_changed_hooks;
 
@@ -578,7 +643,7 @@ struct st_toplevel {
   LoadBackupQueryFunc load_newer_backup_func;
   void *load_newer_backup_data;
 
-  GList *weak_refs; /* Weak references */
+  WEAK_REFS *weak_refs; /* Weak references */
 };
 
 /* structures below are for gnetlist */
@@ -607,9 +672,9 @@ struct st_cpinlist {
   int plid;
   int type;                             /* PIN_TYPE_NET or PIN_TYPE_BUS */
 
-  char *pin_number;
+  char *pin_number;			/* interned, see s_string_intern() */
   char *net_name;			/* this is resolved at very end */
-  char *pin_label;
+  char *pin_label;			/* interned, see s_string_intern() */
 
   NET *nets;
 
@@ -624,7 +689,7 @@ struct st_net {
 
   int net_name_has_priority;
   char *net_name;
-  char *pin_label;
+  char *pin_label;			/* interned, see s_string_intern() */
 
   char *connected_to; /* new to replace above */
 
@@ -71,7 +71,7 @@ void m_transform_translate(TRANSFORM *transform, gdouble dx, gdouble dy);
 
 /* o_arc_basic.c */
 OBJECT *o_arc_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_arc_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_arc_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_arc_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void o_arc_print_solid(TOPLEVEL *toplevel, FILE *fp, int x, int y, int radius, int angle1, int angle2, int color, int arc_width, int capstyle, int length, int space, int origin_x, int origin_y);
 void o_arc_print_dotted(TOPLEVEL *toplevel, FILE *fp, int x, int y, int radius, int angle1, int angle2, int color, int arc_width, int capstyle, int length, int space, int origin_x, int origin_y);
@@ -91,18 +91,22 @@ GList *o_read_attribs(TOPLEVEL *toplevel,
                       unsigned int release_ver,
                       unsigned int fileformat_ver, GError **err);
 OBJECT *o_attrib_find_attrib_by_name(const GList *list, char *name, int count);
+void o_attrib_update_name_value(OBJECT *object);
 
 /* o_basic.c */
 void o_bounds_invalidate(TOPLEVEL *toplevel, OBJECT *object);
+void o_touch_object (OBJECT *object);
 double o_shortest_distance_full(OBJECT *object, int x, int y, int force_solid);
 PAGE *o_get_page_compat (TOPLEVEL *toplevel, OBJECT *object) G_GNUC_DEPRECATED;
 void o_emit_pre_change_notify(TOPLEVEL *toplevel, OBJECT *object);
 void o_emit_change_notify(TOPLEVEL *toplevel, OBJECT *object);
+void o_emit_display_change_notify(TOPLEVEL *toplevel, OBJECT *object);
+void o_change_notify_forget(TOPLEVEL *toplevel, OBJECT *object);
 int o_get_capstyle (OBJECT_END end);
 
 /* o_box_basic.c */
 OBJECT *o_box_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_box_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_box_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_box_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void o_box_print_solid(TOPLEVEL *toplevel, FILE *fp, int x, int y, int width, int height, int color, int line_width, int capstyle, int length, int space, int origin_x, int origin_y);
 void o_box_print_dotted(TOPLEVEL *toplevel, FILE *fp, int x, int y, int width, int height, int color, int line_width, int capstyle, int length, int space, int origin_x, int origin_y);
@@ -119,7 +123,7 @@ void o_box_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_bus_basic.c */
 OBJECT *o_bus_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_bus_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_bus_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_bus_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void world_get_bus_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left, int *top, int *right, int *bottom);
 gboolean o_bus_get_position(TOPLEVEL *toplevel, gint *x, gint *y, OBJECT *object);
@@ -127,7 +131,7 @@ void o_bus_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_circle_basic.c */
 OBJECT *o_circle_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_circle_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_circle_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_circle_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void o_circle_print_solid(TOPLEVEL *toplevel, FILE *fp, int x, int y, int radius, int color, int circle_width, int capstyle, int length, int space, int origin_x, int origin_y);
 void o_circle_print_dotted(TOPLEVEL *toplevel, FILE *fp, int x, int y, int radius, int color, int circle_width, int capstyle, int length, int space, int origin_x, int origin_y);
@@ -144,7 +148,7 @@ void o_circle_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_complex_basic.c */
 OBJECT *o_complex_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_complex_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_complex_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 double o_complex_shortest_distance(OBJECT *object, int x, int y, int force_soild);
 void world_get_complex_bounds(TOPLEVEL *toplevel, OBJECT *complex, int *left, int *top, int *right, int *bottom);
 gboolean o_complex_get_position(TOPLEVEL *toplevel, gint *x, gint *y, OBJECT *object);
@@ -153,7 +157,7 @@ GList *o_complex_get_promotable (TOPLEVEL *toplevel, OBJECT *object, int detach)
 
 /* o_line_basic.c */
 OBJECT *o_line_read(TOPLEVEL *toplevel, const const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_line_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_line_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_line_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void o_line_print_solid(TOPLEVEL *toplevel, FILE *fp, int x1, int y1, int x2, int y2, int color, int line_width, int capstyle, int length, int space, int origin_x, int origin_y);
 void o_line_print_dotted(TOPLEVEL *toplevel, FILE *fp, int x1, int y1, int x2, int y2, int color, int line_width, int capstyle, int length, int space, int origin_x, int origin_y);
@@ -167,7 +171,7 @@ void o_line_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_net_basic.c */
 OBJECT *o_net_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_net_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_net_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_net_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void world_get_net_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left, int *top, int *right, int *bottom);
 gboolean o_net_get_position(TOPLEVEL *toplevel, gint *x, gint *y, OBJECT *object);
@@ -175,7 +179,7 @@ void o_net_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_path_basic.c */
 OBJECT *o_path_read(TOPLEVEL *toplevel, const char *first_line, TextBuffer *tb, unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_path_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_path_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_path_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 double o_path_shortest_distance(OBJECT *object, int x, int y, int force_soild);
 void world_get_path_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left, int *top, int *right, int *bottom);
@@ -185,7 +189,7 @@ void o_path_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_picture.c */
 OBJECT *o_picture_read(TOPLEVEL *toplevel, const char *first_line, TextBuffer *tb, unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_picture_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_picture_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_picture_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
 		     int origin_x, int origin_y);
 double o_picture_shortest_distance(OBJECT *object, int x, int y, int force_soild);
@@ -194,10 +198,11 @@ gboolean o_picture_get_position(TOPLEVEL *toplevel, gint *x, gint *y, OBJECT *ob
 void o_picture_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 void o_picture_embed(TOPLEVEL *toplevel, OBJECT *object);
 void o_picture_unembed(TOPLEVEL *toplevel, OBJECT *object);
+void o_picture_image_unref(PICTURE_IMAGE *image);
 
 /* o_pin_basic.c */
 OBJECT *o_pin_read(TOPLEVEL *toplevel, const char buf[], unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_pin_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_pin_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_pin_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y);
 void world_get_pin_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left, int *top, int *right, int *bottom);
 gboolean o_pin_get_position(TOPLEVEL *toplevel, gint *x, gint *y, OBJECT *object);
@@ -205,7 +210,7 @@ void o_pin_recalc(TOPLEVEL *toplevel, OBJECT *o_current);
 
 /* o_text_basic.c */
 OBJECT *o_text_read(TOPLEVEL *toplevel, const char *first_line, TextBuffer *tb, unsigned int release_ver, unsigned int fileformat_ver, GError **err);
-char *o_text_save(TOPLEVEL *toplevel, OBJECT *object);
+void o_text_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf);
 void o_text_print_text_string(FILE *fp, char *string, int unicode_count, gunichar *unicode_table);
 void o_text_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current, int origin_x, int origin_y, int unicode_count, gunichar *unicode_table);
 double o_text_shortest_distance(OBJECT *object, int x, int y, int force_soild);
@@ -221,21 +226,33 @@ void s_color_init(void);
 gchar *s_color_ps_string(gint color);
 
 /* s_conn.c */
-CONN *s_conn_return_new(OBJECT *other_object, int type, int x, int y, int whichone, int other_whichone);
-int s_conn_uniq(GList *conn_list, CONN *input_conn);
+int s_conn_uniq(GArray *conns, CONN *input_conn);
 int s_conn_remove_other(TOPLEVEL *toplevel, OBJECT *other_object, OBJECT *to_remove);
 OBJECT *s_conn_check_midpoint(OBJECT *o_current, int x, int y);
-void s_conn_print(GList *conn_list);
+void s_conn_print(GArray *conns);
 void s_conn_init(void);
 
 /* s_encoding.c */
 gchar* s_encoding_base64_encode (gchar* src, guint srclen, guint* dstlenp, gboolean strict);
 gchar* s_encoding_base64_decode (gchar* src, guint srclen, guint* dstlenp);
 
+/* s_index.c */
+SPATIAL_INDEX *s_index_new (TOPLEVEL *toplevel);
+void s_index_free (SPATIAL_INDEX *index);
+void s_index_add_object (SPATIAL_INDEX *index, OBJECT *object);
+void s_index_replace_object (SPATIAL_INDEX *index, OBJECT *object1, OBJECT *object2);
+void s_index_remove_object (SPATIAL_INDEX *index, OBJECT *object);
+gint s_index_compare_order (SPATIAL_INDEX *index, OBJECT *object1, OBJECT *object2);
+void s_index_touch_object (OBJECT *object);
+GList *s_index_query_regions (TOPLEVEL *toplevel, SPATIAL_INDEX *index, BOX *rects, int n_rects);
+
 /* s_path.c */
 int s_path_to_polygon(PATH *path, GArray *points);
 double s_path_shortest_distance (PATH *path, int x, int y, int solid);
 
+/* s_style.c */
+void s_style_set_line_width (OBJECT *object, int width);
+
 /* s_textbuffer.c */
 TextBuffer *s_textbuffer_new (const gchar *data, const gint size);
 TextBuffer *s_textbuffer_free (TextBuffer *tb);
@@ -250,8 +267,8 @@ void s_tile_print(TOPLEVEL *toplevel, PAGE *page);
 void s_tile_free_all(PAGE *p_current);
 
 /* s_weakref.c */
-void s_weakref_notify (void *dead_ptr, GList *weak_refs);
-GList *s_weakref_add (GList *weak_refs, void (*notify_func)(void *, void *), void *user_data);
-GList *s_weakref_remove (GList *weak_refs, void (*notify_func)(void *, void *), void *user_data);
-GList *s_weakref_add_ptr (GList *weak_refs, void **weak_pointer_loc);
-GList *s_weakref_remove_ptr (GList *weak_refs, void **weak_pointer_loc);
+void s_weakref_notify (void *dead_ptr, WEAK_REFS *weak_refs);
+WEAK_REFS *s_weakref_add (WEAK_REFS *weak_refs, void (*notify_func)(void *, void *), void *user_data);
+WEAK_REFS *s_weakref_remove (WEAK_REFS *weak_refs, void (*notify_func)(void *, void *), void *user_data);
+WEAK_REFS *s_weakref_add_ptr (WEAK_REFS *weak_refs, void **weak_pointer_loc);
+WEAK_REFS *s_weakref_remove_ptr (WEAK_REFS *weak_refs, void **weak_pointer_loc);
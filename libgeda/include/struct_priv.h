@@ -22,4 +22,93 @@
 #ifndef STRUCT_PRIV_H
 #define STRUCT_PRIV_H
 
+/* Number of cells the spatial index splits the page into */
+#define INDEX_CELLS_X           64
+#define INDEX_CELLS_Y           64
+
+/* Objects touching more cells than this are kept on the overflow list */
+#define INDEX_MAX_CELL_SPAN     256
+
+typedef enum { INDEX_NOWHERE, INDEX_IN_CELLS, INDEX_IN_OVERFLOW } INDEX_LOCATION;
+
+typedef struct st_index_entry INDEX_ENTRY;
+
+/*! \brief Record of one top-level OBJECT in a SPATIAL_INDEX
+ *
+ *  See s_index.c for further information.
+ */
+struct st_index_entry {
+  OBJECT *object;
+
+  guint order;          /* position in the page's object list */
+  guint query_stamp;    /* last query which returned this entry */
+  gboolean dirty;       /* bounds changed since last placed */
+
+  INDEX_LOCATION location;
+  int x1, y1, x2, y2;   /* range of cells occupied (INDEX_IN_CELLS) */
+};
+
+/*! \brief Spatial index of the top-level OBJECTs on a PAGE
+ *
+ *  See s_index.c for further information.
+ */
+struct st_spatial_index {
+  GHashTable *entries;  /* OBJECT * -> INDEX_ENTRY * */
+
+  GPtrArray *cells[INDEX_CELLS_X][INDEX_CELLS_Y];
+  GPtrArray *overflow;
+  GPtrArray *dirty;
+
+  double cell_width, cell_height;
+
+  guint next_order;
+  guint query_stamp;
+
+  gboolean show_hidden_text;  /* toplevel setting at the last flush */
+};
+
+/* Kinds of key in the endpoint index of a CONN_UPDATE */
+typedef enum { CONN_KEY_POINT, CONN_KEY_ROW, CONN_KEY_COLUMN,
+               CONN_KEY_HLINE, CONN_KEY_VLINE } CONN_KEY_KIND;
+
+typedef struct st_conn_bucket CONN_BUCKET;
+
+/*! \brief Connectable OBJECTs sharing one key of the endpoint index
+ *
+ *  See s_conn.c for further information.
+ */
+struct st_conn_bucket {
+  CONN_KEY_KIND kind;
+  int x, y;             /* coordinate(s) used by this kind of key */
+  GList *objects;
+};
+
+/*! \brief A batch of OBJECTs waiting to be reconnected
+ *
+ *  See s_conn.c for further information.
+ */
+struct st_conn_update {
+  TOPLEVEL *toplevel;
+
+  GList *objects;       /* line OBJECTs to reconnect, in order added */
+  GHashTable *members;  /* set of the OBJECTs in objects */
+  GHashTable *frozen;   /* OBJECTs whose conns-changed hooks are held */
+};
+
+/*! \brief Image data shared by identical pictures
+ *
+ *  See o_picture.c for further information.
+ */
+struct st_picture_image {
+  int ref_count;
+  guint hash;           /* hash of the file data */
+
+  gchar *file_content;  /* raw image file data */
+  gsize file_length;
+
+  gboolean decoded;     /* decoding has been attempted */
+  GdkPixbuf *pixbuf;    /* the decoded image, or NULL */
+  GPtrArray *mipmaps;   /* successively halved copies of pixbuf */
+};
+
 #endif /* !STRUCT_PRIV_H */
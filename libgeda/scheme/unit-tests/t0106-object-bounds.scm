@@ -51,3 +51,34 @@
       (assert-equal a (fold-bounds #f a))
       (assert-equal a (fold-bounds a #f))
       (assert-equal #f (fold-bounds #f #f)))))
+
+(begin-test 'component-bounds-transform
+  (let ((C (make-component "test component" '(0 . 0) 0 #f #f))
+        (x (make-box '(0 . 1) '(1 . 0)))
+        (y (make-box '(2 . 3) '(3 . 2)))
+        (z (make-box '(1 . 2) '(2 . 1))))
+
+    (component-append! C x y z)
+    (assert-equal '((0 . 3) . (3 . 0)) (object-bounds C))
+
+    ;; Moving a primitive from inside the bounds out of them
+    (translate-objects! '(5 . 0) z)
+    (assert-equal '((0 . 3) . (7 . 0)) (object-bounds C))
+
+    ;; Moving the primitives which set the edges shrinks the bounds
+    (translate-objects! '(-5 . 0) z)
+    (assert-equal '((0 . 3) . (3 . 0)) (object-bounds C))
+    (translate-objects! '(1 . 1) x)
+    (assert-equal '((1 . 3) . (3 . 1)) (object-bounds C))
+
+    ;; Rotating a primitive
+    (rotate-objects! '(1 . 1) 90 y)
+    (assert-equal '((-1 . 3) . (0 . 2)) (object-bounds y))
+    (assert-equal '((-1 . 3) . (2 . 1)) (object-bounds C))
+
+    ;; Moving and rotating the whole component
+    (translate-objects! '(10 . 10) C)
+    (assert-equal '((9 . 13) . (12 . 11)) (object-bounds C))
+    (rotate-objects! '(0 . 0) 90 C)
+    (assert-equal '((-13 . 12) . (-11 . 9)) (object-bounds C))
+    ))
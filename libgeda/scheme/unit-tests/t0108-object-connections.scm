@@ -64,4 +64,56 @@
     (assert-equal (list b1)    (object-connections b2))
     ))
 
+;; Objects are moved on a page by taking them off it, changing them
+;; and putting them back.
+(begin-test 'object-connections-move
+  (let ((Q (make-page "/test/page/B"))
+        (C (make-component "test component" '(0 . 0) 0 #t #f))
+        (np (make-net-pin '(100 . 0) '(0 . 0)))
+        (n1 (make-net '(100 . 0) '(100 . 100)))
+        (n2 (make-net '(100 . 100) '(200 . 100)))
+        (n3 (make-net '(300 . 100) '(400 . 100))))
+
+    (component-append! C np)
+    (page-append! Q C n1 n2 n3)
+
+    (assert-equal (list np n2) (object-connections n1))
+    (assert-equal (list n1)    (object-connections n2))
+    (assert-equal '()          (object-connections n3))
+
+    ;; Move a net from one net to another
+    (page-remove! Q n2)
+    (translate-objects! '(100 . 0) n2)
+    (page-append! Q n2)
+
+    (assert-equal (list np) (object-connections n1))
+    (assert-equal (list n3) (object-connections n2))
+    (assert-equal (list n2) (object-connections n3))
+
+    ;; Move a component away from the net on its pin
+    (page-remove! Q C)
+    (translate-objects! '(0 . -50) C)
+    (page-append! Q C)
+
+    (assert-equal '() (object-connections C))
+    (assert-equal '() (object-connections np))
+    (assert-equal '() (object-connections n1))
+
+    ;; ... and back again
+    (page-remove! Q C)
+    (translate-objects! '(0 . 50) C)
+    (page-append! Q C)
+
+    (assert-equal (list n1) (object-connections np))
+    (assert-equal (list np) (object-connections n1))
+
+    ;; Delete a net
+    (page-remove! Q n3)
+
+    (assert-equal '()            (object-connections n2))
+    (assert-thrown 'object-state (object-connections n3))
+
+    (close-page! Q)
+    ))
+
 (close-page! P)
@@ -1,6 +1,7 @@
 ;; Test Scheme procedures related to picture objects.
 
-(use-modules (unit-test) (geda object))
+(use-modules (unit-test) (geda object) (geda page))
+(use-modules ((geda core object) #:select (%set-picture-data/vector!)))
 
 (define test-image
   (map char->integer (string->list
@@ -65,3 +66,45 @@ static char * test_image_xpm[] = {
                     (map char->integer (string->list "THIS IS NOT AN IMAGE"))
                     "not_an_image" '(1 . 2) '(5 . 4) 0 #f))
 ))
+
+;; The page string of a single picture, including its embedded data.
+(define (picture-string p)
+  (let ((P (make-page "/test/page/picture")))
+    (page-append! P p)
+    (let ((str (page->string P)))
+      (page-remove! P p)
+      (close-page! P)
+      str)))
+
+;; Pictures with the same data share it.  Changing one of them must
+;; not change the others.
+(begin-test 'picture-shared-data
+  (let* ((a (make-picture/vector test-image "test_image.xpm"
+                                 '(1 . 4) '(5 . 2) 0 #f))
+         (b (copy-object a))
+         (c (make-picture/vector test-image "test_image.xpm"
+                                 '(1 . 4) '(5 . 2) 0 #f))
+         (a-string (picture-string a)))
+
+    (assert-equal a-string (picture-string b))
+    (assert-equal a-string (picture-string c))
+
+    ;; Change the position of a copy
+    (set-picture! b '(2 . 4) '(6 . 2) 0 #f)
+    (assert-equal '(1 . 4) (picture-top-left a))
+    (assert-equal a-string (picture-string a))
+
+    ;; Change the data of a copy
+    (%set-picture-data/vector! b (append test-image (list 10))
+                               "other_image.xpm")
+    (assert-equal "other_image.xpm" (picture-filename b))
+    (assert-equal "test_image.xpm" (picture-filename a))
+    (assert-true (not (equal? (picture-string a) (picture-string b))))
+    (assert-equal a-string (picture-string a))
+    (assert-equal a-string (picture-string c))
+
+    ;; Change the data of the copy back
+    (%set-picture-data/vector! b test-image "test_image.xpm")
+    (set-picture! b '(1 . 4) '(5 . 2) 0 #f)
+    (assert-equal a-string (picture-string b))
+    ))
@@ -0,0 +1,130 @@
+;; Test the base64 encoding of embedded picture data when pages are
+;; converted to & from strings.
+
+(use-modules (unit-test)
+             (geda page)
+             (geda object))
+
+(define xpm-image
+  (map char->integer (string->list
+"/* XPM */
+static char * test_image_xpm[] = {
+\"2 1 1 1\",
+\" 	c None\",
+\"  \"};
+")))
+
+;; A 1x1 RGB PNG.  Most of its bytes are 0x80 or above.
+(define png-image
+  '(137 80 78 71 13 10 26 10 0 0 0 13 73 72 68 82 0 0 0 1 0 0 0 1 8 2
+    0 0 0 144 119 83 222 0 0 0 12 73 68 65 84 120 218 99 248 223 224 0
+    0 4 65 1 192 50 44 62 61 0 0 0 0 73 69 78 68 174 66 96 130))
+
+;; Picture data is passed in as signed bytes.
+(define (signed-bytes bytes)
+  (map (lambda (b) (if (> b 127) (- b 256) b)) bytes))
+
+(define base64-symbols
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/")
+
+;; Reference base64 encoder.  When strict is true, a newline follows
+;; every 18 whole groups of three bytes, as libgeda writes it.
+(define (base64-encode bytes strict)
+  (define (sym n) (string-ref base64-symbols n))
+  (let loop ((in bytes) (groups 0) (out '()))
+    (if (null? in)
+        (list->string (reverse out))
+        (let* ((n (min 3 (length in)))
+               (b (append (list-head in n) (make-list (- 3 n) 0)))
+               (word (+ (* 65536 (car b)) (* 256 (cadr b)) (caddr b)))
+               (syms (list (sym (quotient word 262144))
+                           (sym (modulo (quotient word 4096) 64))
+                           (sym (modulo (quotient word 64) 64))
+                           (sym (modulo word 64))))
+               (syms (append (list-head syms (+ n 1))
+                             (make-list (- 3 n) #\=)))
+               (groups (if (= n 3) (+ groups 1) groups))
+               (out (append (reverse syms) out)))
+          (loop (list-tail in n) groups
+                (if (and strict (= n 3) (= 0 (modulo groups 18)))
+                    (cons #\newline out)
+                    out))))))
+
+;; Split a string into pieces of at most n characters.
+(define (split-string str n)
+  (if (<= (string-length str) n)
+      (list str)
+      (cons (substring str 0 n)
+            (split-string (substring str n) n))))
+
+;; Embedded picture data as it should appear in a page string.
+(define (embedded-data filename bytes)
+  (string-append filename "\n" (base64-encode bytes #t) "\n.\n"))
+
+;; A page holding one embedded picture, with its data written out as
+;; given.
+(define (picture-page-string filename data)
+  (string-append "v 20111231 2\nG 1 2 4 2 0 0 1\n"
+                 filename "\n" data "\n.\n"))
+
+;; Check that a page holding only picture p is written with the data
+;; of bytes, and that reading it back gives a page written the same.
+(define (check-round-trip p filename bytes)
+  (let ((A (make-page "/test/page/A")))
+    (page-append! A p)
+    (let* ((str (page->string A))
+           (B (string->page "/test/page/B" str)))
+      (assert-true (string-contains str (embedded-data filename bytes)))
+      (assert-equal 1 (length (page-contents B)))
+      (assert-true (picture? (car (page-contents B))))
+      (assert-equal str (page->string B)))))
+
+;; Data of each length modulo 3, so that the last group is written
+;; with two, one and no padding symbols.  Trailing newlines don't
+;; change the image.
+(begin-test 'picture-encoding-padding
+  (for-each
+   (lambda (extra)
+     (let ((bytes (append xpm-image (make-list extra 10))))
+       (check-round-trip
+        (make-picture/vector (signed-bytes bytes) "test_image.xpm"
+                             '(1 . 4) '(5 . 2) 0 #f)
+        "test_image.xpm" bytes)))
+   '(0 1 2)))
+
+(begin-test 'picture-encoding-high-bytes
+  (check-round-trip
+   (make-picture/vector (signed-bytes png-image) "test_image.png"
+                        '(1 . 4) '(5 . 2) 0 #f)
+   "test_image.png" png-image))
+
+;; Data longer than one line is broken every 72 symbols.
+(begin-test 'picture-encoding-long-data
+  (let ((bytes (append xpm-image (make-list 100 10))))
+    (assert-true (string-index (base64-encode bytes #t) #\newline))
+    (check-round-trip
+     (make-picture/vector (signed-bytes bytes) "test_image.xpm"
+                          '(1 . 4) '(5 . 2) 0 #f)
+     "test_image.xpm" bytes)))
+
+;; Data written on a single line, without the line breaks libgeda
+;; puts in, is read back the same.
+(begin-test 'picture-decoding-unbroken-lines
+  (let* ((bytes (append xpm-image (make-list 100 10)))
+         (A (string->page "/test/page/A"
+                          (picture-page-string
+                           "test_image.xpm" (base64-encode bytes #f)))))
+    (assert-equal 1 (length (page-contents A)))
+    (assert-true (string-contains (page->string A)
+                                  (embedded-data "test_image.xpm" bytes)))))
+
+;; Whitespace and DOS line endings within the data are skipped.
+(begin-test 'picture-decoding-whitespace
+  (let* ((data (string-join (split-string (base64-encode png-image #f) 7)
+                            " \t\r\n "))
+         (A (string->page "/test/page/A"
+                          (picture-page-string "test_image.png" data))))
+    (assert-equal 1 (length (page-contents A)))
+    (assert-true (string-contains (page->string A)
+                                  (embedded-data "test_image.png"
+                                                 png-image)))))
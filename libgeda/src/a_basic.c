@@ -25,9 +25,17 @@
 #include <version.h>
 
 #include <stdio.h>
+#include <errno.h>
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <glib/gstdio.h>
 
 #include "libgeda_priv.h"
 
@@ -53,6 +61,150 @@ const gchar *o_file_format_header()
   return header;
 }
 
+/* Amount of output o_save() collects before writing it to the file */
+#define SAVE_CHUNK_SIZE (64 * 1024)
+
+/*! \brief Output of the schematic serializer */
+typedef struct {
+  GString *buffer;  /* formatted output not yet written */
+  FILE *fp;         /* file to write to, or NULL to keep the output */
+  int error;        /* errno of the first failed write, or 0 */
+} SaveStream;
+
+/*! \brief Write the buffered output of a SaveStream to its file
+ *  \par Function Description
+ *  Writes out and empties the buffer of \a stream once it holds at
+ *  least SAVE_CHUNK_SIZE bytes, or whenever \a force is TRUE.  Does
+ *  nothing if \a stream has no file.
+ *
+ *  \param [in] stream  The SaveStream to flush.
+ *  \param [in] force   Write the buffer regardless of its size.
+ */
+static void save_stream_flush (SaveStream *stream, gboolean force)
+{
+  if (stream->fp == NULL)
+    return;
+  if (!force && stream->buffer->len < SAVE_CHUNK_SIZE)
+    return;
+
+  if (stream->error == 0 &&
+      fwrite (stream->buffer->str, 1, stream->buffer->len,
+              stream->fp) != stream->buffer->len) {
+    stream->error = errno;
+  }
+  g_string_truncate (stream->buffer, 0);
+}
+
+/*! \brief Append a series of objects to a SaveStream
+ *  \par Function Description
+ *  Formats \a object_list in libgeda format into the single output
+ *  buffer of \a stream, recursing into attributes and embedded
+ *  symbols, and writes the buffer out in chunks as it fills.  Each
+ *  o_*_save() function appends its object straight to the buffer.  See
+ *  o_save_objects() for the meaning of \a save_attribs.
+ *
+ *  \param [in] toplevel      A TOPLEVEL structure.
+ *  \param [in] stream        The SaveStream to append to.
+ *  \param [in] object_list   The head of a GList of objects to save.
+ *  \param [in] save_attribs  Should attribute objects encounterd be saved?
+ *  \returns FALSE if an object could not be saved, TRUE otherwise.
+ */
+static gboolean save_objects (TOPLEVEL *toplevel, SaveStream *stream,
+                              const GList *object_list, gboolean save_attribs)
+{
+  OBJECT *o_current;
+  const GList *iter;
+  GString *acc = stream->buffer;
+
+  for (iter = object_list; iter != NULL; iter = g_list_next (iter)) {
+    o_current = (OBJECT *)iter->data;
+
+    if (!save_attribs && o_current->attached_to != NULL)
+      continue;
+
+    switch (o_current->type) {
+
+      case(OBJ_LINE):
+        o_line_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_NET):
+        o_net_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_BUS):
+        o_bus_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_BOX):
+        o_box_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_CIRCLE):
+        o_circle_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_COMPLEX):
+      case(OBJ_PLACEHOLDER):  /* new type by SDB 1.20.2005 */
+        o_complex_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_TEXT):
+        o_text_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_PATH):
+        o_path_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_PIN):
+        o_pin_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_ARC):
+        o_arc_save(toplevel, o_current, acc);
+        break;
+
+      case(OBJ_PICTURE):
+        o_picture_save(toplevel, o_current, acc);
+        break;
+
+      default:
+        /*! \todo Maybe we can continue instead of just failing
+         *  completely? In any case, failing gracefully is better
+         *  than killing the program, which is what this used to
+         *  do... */
+        g_critical (_("o_save_objects: object %p has unknown type '%c'\n"),
+                    o_current, o_current->type);
+        return FALSE;
+    }
+
+    /* end the line */
+    g_string_append_c (acc, '\n');
+
+    if (o_current->type == OBJ_COMPLEX &&
+        o_complex_is_embedded (o_current)) {
+      g_string_append (acc, "[\n");
+      if (!save_objects (toplevel, stream,
+                         o_current->complex->prim_objs, FALSE))
+        return FALSE;
+      g_string_append (acc, "]\n");
+    }
+
+    /* save any attributes */
+    if (o_current->attribs != NULL) {
+      g_string_append (acc, "{\n");
+      if (!save_objects (toplevel, stream, o_current->attribs, TRUE))
+        return FALSE;
+      g_string_append (acc, "}\n");
+    }
+
+    save_stream_flush (stream, FALSE);
+  }
+
+  return TRUE;
+}
+
 /*! \brief "Save" a file into a string buffer
  *  \par Function Description
  *  This function saves a whole schematic into a buffer in libgeda
@@ -64,18 +216,17 @@ const gchar *o_file_format_header()
  */
 gchar *o_save_buffer (TOPLEVEL *toplevel, const GList *object_list)
 {
-  GString *acc;
-  gchar *buffer;
+  SaveStream stream = { NULL, NULL, 0 };
 
   if (toplevel == NULL) return NULL;
 
-  acc = g_string_new (o_file_format_header());
+  stream.buffer = g_string_new (o_file_format_header());
 
-  buffer = o_save_objects (toplevel, object_list, FALSE);
-  g_string_append (acc, buffer);
-  g_free (buffer);
+  if (!save_objects (toplevel, &stream, object_list, FALSE)) {
+    g_string_truncate (stream.buffer, strlen (o_file_format_header()));
+  }
 
-  return g_string_free (acc, FALSE);
+  return g_string_free (stream.buffer, FALSE);
 }
 
 /*! \brief Save a series of objects into a string buffer
@@ -96,126 +247,27 @@ gchar *o_save_buffer (TOPLEVEL *toplevel, const GList *object_list)
  */
 gchar *o_save_objects (TOPLEVEL *toplevel, const GList *object_list, gboolean save_attribs)
 {
-  OBJECT *o_current;
-  const GList *iter;
-  gchar *out;
-  GString *acc;
-  gboolean already_wrote = FALSE;
-
-  acc = g_string_new("");
-
-  iter = object_list;
-
-  while ( iter != NULL ) {
-    o_current = (OBJECT *)iter->data;
-
-    if (save_attribs || o_current->attached_to == NULL) {
-
-      switch (o_current->type) {
-
-        case(OBJ_LINE):
-          out = o_line_save(toplevel, o_current);
-          break;
-
-        case(OBJ_NET):
-          out = o_net_save(toplevel, o_current);
-          break;
-
-        case(OBJ_BUS):
-          out = o_bus_save(toplevel, o_current);
-          break;
-
-        case(OBJ_BOX):
-          out = o_box_save(toplevel, o_current);
-          break;
+  SaveStream stream = { NULL, NULL, 0 };
 
-        case(OBJ_CIRCLE):
-          out = o_circle_save(toplevel, o_current);
-          break;
+  stream.buffer = g_string_new ("");
 
-        case(OBJ_COMPLEX):
-          out = o_complex_save(toplevel, o_current);
-          g_string_append_printf(acc, "%s\n", out);
-          already_wrote = TRUE;
-          g_free(out); /* need to free here because of the above flag */
-
-          if (o_complex_is_embedded(o_current)) {
-            g_string_append(acc, "[\n");
-
-            out = o_save_objects(toplevel, o_current->complex->prim_objs, FALSE);
-            g_string_append (acc, out);
-            g_free(out);
-
-            g_string_append(acc, "]\n");
-          }
-          break;
-
-        case(OBJ_PLACEHOLDER):  /* new type by SDB 1.20.2005 */
-          out = o_complex_save(toplevel, o_current);
-          break;
-
-        case(OBJ_TEXT):
-          out = o_text_save(toplevel, o_current);
-          break;
-
-        case(OBJ_PATH):
-          out = o_path_save(toplevel, o_current);
-          break;
-
-        case(OBJ_PIN):
-          out = o_pin_save(toplevel, o_current);
-          break;
-
-        case(OBJ_ARC):
-          out = o_arc_save(toplevel, o_current);
-          break;
-
-        case(OBJ_PICTURE):
-          out = o_picture_save(toplevel, o_current);
-          break;
-
-        default:
-          /*! \todo Maybe we can continue instead of just failing
-           *  completely? In any case, failing gracefully is better
-           *  than killing the program, which is what this used to
-           *  do... */
-          g_critical (_("o_save_objects: object %p has unknown type '%c'\n"),
-                      o_current, o_current->type);
-          /* Dump string built so far */
-          g_string_free (acc, TRUE);
-          return NULL;
-      }
-
-      /* output the line */
-      if (!already_wrote) {
-        g_string_append_printf(acc, "%s\n", out);
-        g_free(out);
-      } else {
-        already_wrote = FALSE;
-      }
-
-      /* save any attributes */
-      if (o_current->attribs != NULL) {
-        g_string_append (acc, "{\n");
-
-        out = o_save_objects (toplevel, o_current->attribs, TRUE);
-        g_string_append (acc, out);
-        g_free(out);
-
-        g_string_append (acc, "}\n");
-      }
-    }
-
-    iter = g_list_next (iter);
+  if (!save_objects (toplevel, &stream, object_list, save_attribs)) {
+    g_string_free (stream.buffer, TRUE);
+    return NULL;
   }
 
-  return g_string_free (acc, FALSE);
+  return g_string_free (stream.buffer, FALSE);
 }
 
 /*! \brief Save a file
  *  \par Function Description
  *  This function saves the data in a libgeda format to a file
  *
+ *  The objects are formatted into one reusable buffer which is
+ *  written out in chunks, so the whole file is never held in memory.
+ *  The data is written to a temporary file in the same directory,
+ *  which is synced to disk and then replaces \a filename.
+ *
  *  \bug g_access introduces a race condition in certain cases, but
  *  solves bug #698565 in the normal use-case
  *
@@ -228,7 +280,11 @@ gchar *o_save_objects (TOPLEVEL *toplevel, const GList *object_list, gboolean sa
 int o_save (TOPLEVEL *toplevel, const GList *object_list,
             const char *filename, GError **err)
 {
-  char *buffer;
+  SaveStream stream = { NULL, NULL, 0 };
+  gchar *tmp_filename;
+  gboolean saved;
+  mode_t saved_umask;
+  int fd;
 
   /* Check to see if real filename is writable; if file doesn't exists
      we assume all is well */
@@ -239,13 +295,73 @@ int o_save (TOPLEVEL *toplevel, const GList *object_list,
     return 0;      
   }
 
-  buffer = o_save_buffer (toplevel, object_list);
-  if (!g_file_set_contents (filename, buffer, strlen(buffer), err)) {
-    g_free (buffer);
+  tmp_filename = g_strdup_printf ("%s.XXXXXX", filename);
+  fd = g_mkstemp (tmp_filename);
+  if (fd == -1 || (stream.fp = fdopen (fd, "wb")) == NULL) {
+    int errsv = errno;
+    g_set_error (err, G_FILE_ERROR, g_file_error_from_errno (errsv),
+                 _("Failed to create file '%s': %s"),
+                 tmp_filename, g_strerror (errsv));
+    if (fd != -1) {
+      close (fd);
+      g_unlink (tmp_filename);
+    }
+    g_free (tmp_filename);
+    return 0;
+  }
+
+  /* Give the file the permissions a newly created file would have */
+  saved_umask = umask (0);
+  umask (saved_umask);
+  g_chmod (tmp_filename, 0666 & ~saved_umask);
+
+  stream.buffer = g_string_sized_new (SAVE_CHUNK_SIZE);
+  g_string_append (stream.buffer, o_file_format_header());
+
+  saved = save_objects (toplevel, &stream, object_list, FALSE);
+  save_stream_flush (&stream, TRUE);
+  g_string_free (stream.buffer, TRUE);
+
+  /* Make sure the data is on disk before the file replaces the old
+   * one, so a crash cannot leave an empty schematic behind. */
+  if (stream.error == 0 && fflush (stream.fp) != 0) {
+    stream.error = errno;
+  }
+#ifdef HAVE_FSYNC
+  if (stream.error == 0 && fsync (fileno (stream.fp)) != 0) {
+    stream.error = errno;
+  }
+#endif
+
+  if (fclose (stream.fp) != 0 && stream.error == 0) {
+    stream.error = errno;
+  }
+
+  if (saved && stream.error == 0) {
+#ifdef G_OS_WIN32
+    /* Renaming does not replace an existing file on Windows */
+    g_unlink (filename);
+#endif
+    if (g_rename (tmp_filename, filename) != 0) {
+      stream.error = errno;
+    }
+  }
+
+  if (!saved || stream.error != 0) {
+    if (stream.error != 0) {
+      g_set_error (err, G_FILE_ERROR, g_file_error_from_errno (stream.error),
+                   _("Failed to write file '%s': %s"),
+                   filename, g_strerror (stream.error));
+    } else {
+      g_set_error (err, G_FILE_ERROR, G_FILE_ERROR_FAILED,
+                   _("Failed to save file '%s'"), filename);
+    }
+    g_unlink (tmp_filename);
+    g_free (tmp_filename);
     return 0;
   }
-  g_free (buffer);
 
+  g_free (tmp_filename);
   return 1;
 }
 
@@ -0,0 +1,117 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#include <config.h>
+
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+
+#include "libgeda_priv.h"
+
+/*!
+ * \file bench_encoding.c
+ * \brief Benchmark of the base64 functions of s_encoding.c.
+ *
+ * Encodes and decodes a buffer of random bytes a number of times, and
+ * prints the time and throughput of each.  It is built by "make
+ * check" but not run by it:
+ *
+ *   ./bench_encoding [megabytes [rounds]]
+ *
+ * The buffer is 8 MiB and each function runs 10 times by default.  The
+ * random data is the same on every run.  Exits with a failure status
+ * if decoding does not give back the original data.
+ */
+
+/* Print the time a function took, and its throughput on \a bytes. */
+static void
+report (const gchar *what, gdouble seconds, gsize bytes, int rounds)
+{
+  printf ("%-7s %8.3f s  %8.1f MiB/s\n", what, seconds,
+          (gdouble) bytes * rounds / (1024 * 1024) / seconds);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gsize size = 8;
+  int rounds = 10;
+  gchar *data;
+  gchar *encoded = NULL;
+  gchar *decoded = NULL;
+  guint encoded_len = 0;
+  guint decoded_len = 0;
+  GTimer *timer;
+  gdouble encode_time, decode_time;
+  gsize i;
+  int r;
+
+  if (argc > 1) size = atoi (argv[1]);
+  if (argc > 2) rounds = atoi (argv[2]);
+  if (size == 0 || rounds <= 0) {
+    fprintf (stderr, "Usage: %s [megabytes [rounds]]\n", argv[0]);
+    return 1;
+  }
+  size *= 1024 * 1024;
+
+  g_random_set_seed (1);
+  data = g_malloc (size);
+  for (i = 0; i < size; i++) {
+    data[i] = g_random_int_range (0, 256);
+  }
+
+  timer = g_timer_new ();
+
+  g_timer_start (timer);
+  for (r = 0; r < rounds; r++) {
+    g_free (encoded);
+    encoded = s_encoding_base64_encode (data, size, &encoded_len, TRUE);
+  }
+  encode_time = g_timer_elapsed (timer, NULL);
+
+  g_timer_start (timer);
+  for (r = 0; r < rounds; r++) {
+    g_free (decoded);
+    decoded = s_encoding_base64_decode (encoded, encoded_len - 1,
+                                        &decoded_len);
+  }
+  decode_time = g_timer_elapsed (timer, NULL);
+
+  g_timer_destroy (timer);
+
+  printf ("%lu bytes, %d rounds\n", (unsigned long) size, rounds);
+  report ("encode", encode_time, size, rounds);
+  report ("decode", decode_time, size, rounds);
+
+  if (decoded == NULL || decoded_len != size ||
+      memcmp (decoded, data, size) != 0) {
+    fprintf (stderr, "Decoded data differs from the original\n");
+    return 1;
+  }
+
+  g_free (data);
+  g_free (encoded);
+  g_free (decoded);
+  return 0;
+}
@@ -219,6 +219,74 @@ void m_hatch_path (PATH *path, gint angle, gint pitch, GArray *lines)
   g_array_free (points, TRUE);
 }
 
+/*! \brief Get the hatch line segments filling an object.
+ *
+ *  Returns the line segments for the hatch or mesh fill of a box, circle
+ *  or path object.  The segments are computed on first use and kept with
+ *  the object until its geometry or its fill options change, so redrawing
+ *  an unchanged object does not repeat the sweep.
+ *
+ *  \param object [in] The object to hatch.
+ *  \return A GArray of LINE owned by the object, or NULL if the object is
+ *  not hatched.  The array must not be modified or freed by the caller.
+ */
+GArray *m_hatch_object (OBJECT *object)
+{
+  const OBJECT_STYLE *style;
+
+  g_return_val_if_fail (object != NULL, NULL);
+
+  style = object->style;
+
+  if (style->fill_type != FILLING_HATCH && style->fill_type != FILLING_MESH)
+    return NULL;
+
+  /* a zero pitch would never advance the sweep line */
+  if (style->fill_pitch1 <= 0 ||
+      (style->fill_type == FILLING_MESH && style->fill_pitch2 <= 0))
+    return NULL;
+
+  if (object->hatch_lines != NULL && object->hatch_style == style)
+    return object->hatch_lines;
+
+  if (object->hatch_lines == NULL)
+    object->hatch_lines = g_array_new (FALSE, FALSE, sizeof (LINE));
+  else
+    g_array_set_size (object->hatch_lines, 0);
+
+  switch (object->type) {
+    case OBJ_BOX:
+      m_hatch_box (object->box, style->fill_angle1, style->fill_pitch1,
+                   object->hatch_lines);
+      if (style->fill_type == FILLING_MESH)
+        m_hatch_box (object->box, style->fill_angle2, style->fill_pitch2,
+                     object->hatch_lines);
+      break;
+
+    case OBJ_CIRCLE:
+      m_hatch_circle (object->circle, style->fill_angle1, style->fill_pitch1,
+                      object->hatch_lines);
+      if (style->fill_type == FILLING_MESH)
+        m_hatch_circle (object->circle, style->fill_angle2, style->fill_pitch2,
+                        object->hatch_lines);
+      break;
+
+    case OBJ_PATH:
+      m_hatch_path (object->path, style->fill_angle1, style->fill_pitch1,
+                    object->hatch_lines);
+      if (style->fill_type == FILLING_MESH)
+        m_hatch_path (object->path, style->fill_angle2, style->fill_pitch2,
+                      object->hatch_lines);
+      break;
+
+    default:
+      return NULL;
+  }
+
+  object->hatch_style = style;
+  return object->hatch_lines;
+}
+
 /*! \brief Calculates line segments to hatch an arbitrary polygon.
  *
  *  This function appends new line segments to the lines GArray.  For creating
@@ -72,7 +72,6 @@ OBJECT *o_arc_new(TOPLEVEL *toplevel,
 
   new_node->color = color;
 
-  new_node->arc = (ARC *) g_malloc(sizeof(ARC));
 
   /*! \note
    *  The ARC structure is initialized with the parameters.
@@ -134,9 +133,9 @@ OBJECT *o_arc_copy(TOPLEVEL *toplevel, OBJECT *o_current)
                        o_current->arc->start_angle,
                        o_current->arc->end_angle);
   o_set_line_options(toplevel, new_obj,
-                     o_current->line_end, o_current->line_type,
-                     o_current->line_width,
-                     o_current->line_length, o_current->line_space);
+                     o_current->style->line_end, o_current->style->line_type,
+                     o_current->style->line_width,
+                     o_current->style->line_length, o_current->style->line_space);
   o_set_fill_options(toplevel, new_obj,
                      FILLING_HOLLOW, -1, -1, -1, -1, -1);
 
@@ -297,22 +296,19 @@ OBJECT *o_arc_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief create the string representation of an arc object
+/*! \brief append the string representation of an arc object
  *  \par Function Description
- *  This function formats a string in the buffer <B>*buf</B> to describe
+ *  This function appends a string to the buffer <B>*buf</B> to describe
  *  the arc object <B>*object</B>.
- *  A pointer to the new allocated and formated string is returned.
- *  The string must be freed at some point.
  *
  *  \param [in] toplevel
  *  \param [in] object
- *  \return the string representation of the arc object
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_arc_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_arc_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x, y, radius, start_angle, end_angle;
   int arc_width, arc_length, arc_space;
-  char *buf;
   OBJECT_END arc_end;
   OBJECT_TYPE arc_type;
 
@@ -324,18 +320,16 @@ char *o_arc_save(TOPLEVEL *toplevel, OBJECT *object)
   end_angle   = object->arc->end_angle;
 
   /* line type parameters */
-  arc_width  = object->line_width;
-  arc_end    = object->line_end;
-  arc_type   = object->line_type;
-  arc_length = object->line_length;
-  arc_space  = object->line_space;
+  arc_width  = object->style->line_width;
+  arc_end    = object->style->line_end;
+  arc_type   = object->style->line_type;
+  arc_length = object->style->line_length;
+  arc_space  = object->style->line_space;
 
   /* Describe a circle with post-20000704 file format */
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d %d %d %d %d", object->type,
-			x, y, radius, start_angle, end_angle, object->color,
-			arc_width, arc_end, arc_type, arc_length, arc_space);
-
-  return(buf);
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d %d %d %d %d %d", object->type,
+                         x, y, radius, start_angle, end_angle, object->color,
+                         arc_width, arc_end, arc_type, arc_length, arc_space);
 }
 
 /*! \brief
@@ -490,6 +484,7 @@ void o_arc_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right  = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 
@@ -519,7 +514,7 @@ void world_get_arc_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left,
   int i, angle;
   int halfwidth;
 
-  halfwidth = object->line_width / 2;
+  halfwidth = object->style->line_width / 2;
 
   radius      = object->arc->width / 2;
   start_angle = object->arc->start_angle;
@@ -624,7 +619,7 @@ void o_arc_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
   start_angle = o_current->arc->start_angle;
   end_angle   = o_current->arc->end_angle;
   color  = o_current->color;
-  capstyle = o_get_capstyle (o_current->line_end);
+  capstyle = o_get_capstyle (o_current->style->line_end);
 
   /*! \note
    *  Depending on the type of the line for this particular arc, the
@@ -640,13 +635,13 @@ void o_arc_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
 
 #if 0  /* was causing arcs which are solid to be much thinner compared to */
   /* lines, boxes, also of zero width */
-  if (o_current->line_width > 0) {
-    arc_width = o_current->line_width;
+  if (o_current->style->line_width > 0) {
+    arc_width = o_current->style->line_width;
   } else {
     arc_width = 1;
   }
 #endif
-  arc_width = o_current->line_width;	/* Added instead of above */
+  arc_width = o_current->style->line_width;	/* Added instead of above */
   if(arc_width <=2) {
     if(toplevel->line_style == THICK) {
       arc_width=LINE_WIDTH;
@@ -655,10 +650,10 @@ void o_arc_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
     }
   }
 
-  length = o_current->line_length;
-  space  = o_current->line_space;
+  length = o_current->style->line_length;
+  space  = o_current->style->line_space;
 	
-  switch(o_current->line_type) {
+  switch(o_current->style->line_type) {
     case(TYPE_SOLID):
       length = -1; space = -1;
       outl_func = o_arc_print_solid;
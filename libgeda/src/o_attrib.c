@@ -70,6 +70,7 @@ void o_attrib_add(TOPLEVEL *toplevel, OBJECT *object, OBJECT *item)
   /* Add link from item to attrib listing */
   item->attached_to = object;
   object->attribs = g_list_append (object->attribs, item);
+  s_page_journal_note (item);
 
   o_attrib_emit_attribs_changed (toplevel, object);
 }
@@ -200,7 +201,7 @@ void o_attrib_print(GList *attributes)
 
   while (a_iter != NULL) {
     a_current = a_iter->data;
-    printf("Attribute points to: %s\n", a_current->name);
+    printf("Attribute points to: %s\n", o_get_name (a_current));
     if (a_current->text) {
       printf("\tText is: %s\n", a_current->text->string);
     }
@@ -229,6 +230,7 @@ void o_attrib_remove(TOPLEVEL *toplevel, GList **list, OBJECT *remove)
   remove->attached_to = NULL;
 
   *list = g_list_remove (*list, remove);
+  s_page_journal_note (remove);
 
   o_attrib_emit_attribs_changed (toplevel, attached_to);
 }
@@ -353,6 +355,35 @@ error:
 }
 
 
+/*! \brief Find the equals sign of an attribute string
+ *  \par Function Description
+ *  Returns the '=' which splits \a string into an attribute name and
+ *  value, or NULL if \a string is not a valid attribute. See
+ *  o_attrib_string_get_name_value() for the rules.
+ *
+ *  \param [in] string  String to split into name/value pair.
+ *  \return Pointer to the '=' in \a string, or NULL.
+ */
+static const gchar *o_attrib_string_find_equals (const gchar *string)
+{
+  const gchar *ptr, *prev_char, *next_char;
+
+  ptr = g_utf8_strchr (string, -1, g_utf8_get_char ("="));
+  if (ptr == NULL) {
+    return NULL;
+  }
+
+  prev_char = g_utf8_find_prev_char (string, ptr);
+  next_char = g_utf8_find_next_char (ptr, NULL);
+  if (prev_char == NULL || *prev_char == ' ' ||
+      next_char == NULL || *next_char == ' ' || *next_char == '\0' ) {
+    return NULL;
+  }
+
+  return ptr;
+}
+
+
 /*! \brief Get name and value from an attribute 'name=value' string.
  *  \par Function Description
  *  This function parses the character string \a string expected to be
@@ -378,7 +409,7 @@ error:
 gboolean
 o_attrib_string_get_name_value (const gchar *string, gchar **name_ptr, gchar **value_ptr)
 {
-  gchar *ptr, *prev_char, *next_char;
+  const gchar *ptr;
 
   if (name_ptr != NULL)
     *name_ptr = NULL;
@@ -387,33 +418,59 @@ o_attrib_string_get_name_value (const gchar *string, gchar **name_ptr, gchar **v
 
   g_return_val_if_fail (string != NULL, FALSE);
 
-  ptr = g_utf8_strchr (string, -1, g_utf8_get_char ("="));
+  ptr = o_attrib_string_find_equals (string);
   if (ptr == NULL) {
     return FALSE;
   }
 
-  prev_char = g_utf8_find_prev_char (string, ptr);
-  next_char = g_utf8_find_next_char (ptr, NULL);
-  if (prev_char == NULL || *prev_char == ' ' ||
-      next_char == NULL || *next_char == ' ' || *next_char == '\0' ) {
-    return FALSE;
-  }
-
   if (name_ptr != NULL) {
     *name_ptr = g_strndup (string, (ptr - string));
   }
 
   if (value_ptr != NULL) {
-    *value_ptr = g_strdup (next_char);
+    *value_ptr = g_strdup (ptr + 1);
   }
 
   return TRUE;
 }
 
 
+/*! \brief Update the cached name and value of a text OBJECT
+ *  \par Function Description
+ *  Splits the string of the text \a object the way
+ *  o_attrib_string_get_name_value() does and remembers the result in
+ *  the TEXT, so that attribute lookups need not parse or allocate.
+ *  The name is interned, so names compare by pointer; the value points
+ *  into the string itself.
+ *
+ *  Must be called whenever the string of the text changes.
+ *
+ *  \param [in] object  The text OBJECT whose string was set.
+ */
+void
+o_attrib_update_name_value (OBJECT *object)
+{
+  TEXT *text = object->text;
+  const gchar *ptr;
+
+  text->attrib_name = NULL;
+  text->attrib_value = NULL;
+
+  ptr = o_attrib_string_find_equals (text->string);
+  if (ptr == NULL)
+    return;
+
+  text->attrib_name = s_string_intern_len (text->string,
+                                           (ptr - text->string));
+  text->attrib_value = ptr + 1;
+}
+
+
 /*! \brief Get name and value from an attribute OBJECT
  *  \par Function Description
- *  See o_attrib_string_get_name_value() for more details
+ *  See o_attrib_string_get_name_value() for more details. The split
+ *  cached by o_attrib_update_name_value() is used, so only the
+ *  returned strings are allocated.
  *
  *  \param [in]  attrib     The attribute OBJECT whos name/value to return.
  *  \param [out] name_ptr   The return location for the name, or NULL.
@@ -423,10 +480,25 @@ o_attrib_string_get_name_value (const gchar *string, gchar **name_ptr, gchar **v
 gboolean
 o_attrib_get_name_value (OBJECT *attrib, gchar **name_ptr, gchar **value_ptr)
 {
+  TEXT *text;
+
+  if (name_ptr != NULL)
+    *name_ptr = NULL;
+  if (value_ptr != NULL)
+    *value_ptr = NULL;
+
   g_return_val_if_fail (attrib->type == OBJ_TEXT, FALSE);
 
-  return o_attrib_string_get_name_value (attrib->text->string,
-                                         name_ptr, value_ptr);
+  text = attrib->text;
+  if (text->attrib_name == NULL)
+    return FALSE;
+
+  if (name_ptr != NULL)
+    *name_ptr = g_strdup (text->attrib_name);
+  if (value_ptr != NULL)
+    *value_ptr = g_strdup (text->attrib_value);
+
+  return TRUE;
 }
 
 
@@ -464,6 +536,44 @@ GList *o_attrib_find_floating_attribs (const GList *list)
 }
 
 
+/*! \brief Find an attribute with an interned name in a list.
+ *  \par Function Description
+ *  Walks \a list for the attribute whose cached name is \a interned,
+ *  comparing names by pointer. \a *count is the number of matches
+ *  still to skip, and is decremented for every match skipped, so that
+ *  a search can continue in a second list.
+ *
+ *  \param [in]     list           GList of OBJECTs to search.
+ *  \param [in]     interned       Interned attribute name to search for.
+ *  \param [in]     floating_only  Whether to skip attached attributes.
+ *  \param [in,out] count          Which occurance to return.
+ *  \return The matching attribute OBJECT, or NULL.
+ */
+static OBJECT *o_attrib_find_interned (const GList *list,
+                                       const gchar *interned,
+                                       gboolean floating_only, int *count)
+{
+  const GList *iter;
+
+  for (iter = list; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *a_current = iter->data;
+
+    if (a_current->type != OBJ_TEXT ||
+        a_current->text->attrib_name != interned)
+      continue;
+
+    if (floating_only && a_current->attached_to != NULL)
+      continue;
+
+    if (*count == 0)
+      return a_current;
+    (*count)--;
+  }
+
+  return NULL;
+}
+
+
 /*! \brief Find an attribute in a list.
  *  \par Function Description
  *  Search for attribute by name.
@@ -478,31 +588,14 @@ GList *o_attrib_find_floating_attribs (const GList *list)
  */
 OBJECT *o_attrib_find_attrib_by_name (const GList *list, char *name, int count)
 {
-  OBJECT *a_current;
-  const GList *iter;
-  char *found_name;
-  int internal_counter = 0;
-
-  for (iter = list; iter != NULL; iter = g_list_next (iter)) {
-    a_current = iter->data;
+  const gchar *interned;
 
-    g_return_val_if_fail (a_current->type == OBJ_TEXT, NULL);
+  /* no text has this name if it was never interned */
+  interned = s_string_lookup (name);
+  if (interned == NULL)
+    return NULL;
 
-    if (!o_attrib_get_name_value (a_current, &found_name, NULL))
-      continue;
-
-    if (strcmp (name, found_name) == 0) {
-      if (internal_counter == count) {
-        g_free (found_name);
-        return a_current;
-      }
-      internal_counter++;
-    }
-
-    g_free (found_name);
-  }
-
-  return NULL;
+  return o_attrib_find_interned (list, interned, FALSE, &count);
 }
 
 
@@ -526,7 +619,7 @@ static char *o_attrib_search_attrib_list_by_name (const GList *list, char *name,
   attrib = o_attrib_find_attrib_by_name (list, name, counter);
 
   if (attrib != NULL)
-    o_attrib_get_name_value (attrib, NULL, &value);
+    value = g_strdup (attrib->text->attrib_value);
 
   return value;
 }
@@ -549,14 +642,15 @@ static char *o_attrib_search_attrib_list_by_name (const GList *list, char *name,
  */
 char *o_attrib_search_floating_attribs_by_name (const GList *list, char *name, int counter)
 {
-  char *result;
-  GList *attributes;
+  const gchar *interned;
+  OBJECT *attrib;
 
-  attributes = o_attrib_find_floating_attribs (list);
-  result = o_attrib_search_attrib_list_by_name (attributes, name, counter);
-  g_list_free (attributes);
+  interned = s_string_lookup (name);
+  if (interned == NULL)
+    return NULL;
 
-  return result;
+  attrib = o_attrib_find_interned (list, interned, TRUE, &counter);
+  return (attrib != NULL) ? g_strdup (attrib->text->attrib_value) : NULL;
 }
 
 
@@ -622,14 +716,24 @@ char *o_attrib_search_inherited_attribs_by_name (OBJECT *object, char *name, int
  */
 char *o_attrib_search_object_attribs_by_name (OBJECT *object, char *name, int counter)
 {
-  char *result;
-  GList *attributes;
+  const gchar *interned;
+  OBJECT *attrib;
 
-  attributes = o_attrib_return_attribs (object);
-  result = o_attrib_search_attrib_list_by_name (attributes, name, counter);
-  g_list_free (attributes);
+  interned = s_string_lookup (name);
+  if (interned == NULL)
+    return NULL;
+
+  /* attached attributes first, then the inherited ones, as
+   * o_attrib_return_attribs() orders them */
+  attrib = o_attrib_find_interned (object->attribs, interned,
+                                   FALSE, &counter);
+  if (attrib == NULL && (object->type == OBJ_COMPLEX ||
+                         object->type == OBJ_PLACEHOLDER)) {
+    attrib = o_attrib_find_interned (object->complex->prim_objs, interned,
+                                     TRUE, &counter);
+  }
 
-  return result;
+  return (attrib != NULL) ? g_strdup (attrib->text->attrib_value) : NULL;
 }
 
 
@@ -184,6 +184,8 @@ void o_set_line_options(TOPLEVEL *toplevel, OBJECT *o_current,
 			OBJECT_END end, OBJECT_TYPE type,
 			int width, int length, int space) 
 {
+  OBJECT_STYLE style;
+
   if(o_current == NULL) {
     return;
   }
@@ -215,12 +217,16 @@ void o_set_line_options(TOPLEVEL *toplevel, OBJECT *o_current,
   
   o_emit_pre_change_notify (toplevel, o_current);
 
-  o_current->line_width = width;
-  o_current->line_end   = end;
-  o_current->line_type  = type;
+  style = *o_current->style;
+
+  style.line_width = width;
+  style.line_end   = end;
+  style.line_type  = type;
+
+  style.line_length = length;
+  style.line_space  = space;
 
-  o_current->line_length = length;
-  o_current->line_space  = space;
+  o_current->style = s_style_intern (&style);
 
   /* Recalculate the object's bounding box */
   o_recalc_single_object( toplevel, o_current );
@@ -254,11 +260,11 @@ gboolean o_get_line_options(OBJECT *object,
       && object->type != OBJ_PATH)
     return FALSE;
 
-  *end = object->line_end;
-  *type = object->line_type;
-  *width = object->line_width;
-  *length = object->line_length;
-  *space = object->line_space;
+  *end = object->style->line_end;
+  *type = object->style->line_type;
+  *width = object->style->line_width;
+  *length = object->style->line_length;
+  *space = object->style->line_space;
 
   return TRUE;
 }
@@ -283,20 +289,26 @@ void o_set_fill_options(TOPLEVEL *toplevel, OBJECT *o_current,
 			int pitch1, int angle1,
 			int pitch2, int angle2) 
 {
+  OBJECT_STYLE style;
+
   if(o_current == NULL) {
     return;
   }
 
   o_emit_pre_change_notify (toplevel, o_current);
 
-  o_current->fill_type = type;
-  o_current->fill_width = width;
+  style = *o_current->style;
+
+  style.fill_type = type;
+  style.fill_width = width;
+
+  style.fill_pitch1 = pitch1;
+  style.fill_angle1 = angle1;
 
-  o_current->fill_pitch1 = pitch1;
-  o_current->fill_angle1 = angle1;
+  style.fill_pitch2 = pitch2;
+  style.fill_angle2 = angle2;
 
-  o_current->fill_pitch2 = pitch2;
-  o_current->fill_angle2 = angle2;
+  o_current->style = s_style_intern (&style);
 
   o_emit_change_notify (toplevel, o_current);
 }
@@ -326,12 +338,12 @@ gboolean o_get_fill_options(OBJECT *object,
       && object->type != OBJ_PATH)
     return FALSE;
 
-  *type = object->fill_type;
-  *width = object->fill_width;
-  *pitch1 = object->fill_pitch1;
-  *angle1 = object->fill_angle1;
-  *pitch2 = object->fill_pitch2;
-  *angle2 = object->fill_angle2;
+  *type = object->style->fill_type;
+  *width = object->style->fill_width;
+  *pitch1 = object->style->fill_pitch1;
+  *angle1 = object->style->fill_angle1;
+  *pitch2 = object->style->fill_pitch2;
+  *angle2 = object->style->fill_angle2;
 
   return TRUE;
 }
@@ -550,22 +562,102 @@ double o_shortest_distance_full (OBJECT *object, int x, int y, int force_solid)
   return shortest_distance;
 }
 
+/*! \brief Check whether an object's last bounds are still usable
+ *  \par Function Description
+ *  The bounds stored in an object are usable as a starting point if
+ *  they are valid, or if the object is a complex that is only waiting
+ *  to grow them by some changed primitives.
+ *
+ *  \param [in] obj  The OBJECT to check.
+ *  \return TRUE if the stored bounds are still usable.
+ */
+static gboolean o_bounds_known (OBJECT *obj)
+{
+  return obj->w_bounds_valid ||
+         (obj->complex != NULL && obj->complex->changed_prims != NULL);
+}
+
+/*! \brief Check whether a child's bounds lie inside its parent's
+ *  \par Function Description
+ *  Returns TRUE if the bounds of \a child do not reach any edge of
+ *  the bounds of \a parent, in which case some other primitive
+ *  defines every edge of the parent.
+ */
+static gboolean o_bounds_inside (OBJECT *child, OBJECT *parent)
+{
+  return (child->w_left   > parent->w_left  &&
+          child->w_top    > parent->w_top   &&
+          child->w_right  < parent->w_right &&
+          child->w_bottom < parent->w_bottom);
+}
+
 /*! \brief Mark an OBJECT's cached bounds as invalid
  *  \par Function Description
- *  Recursively marks the cached bounds of the given OBJECT and its
- *  parents as having been invalidated and in need of an update. They
- *  will be recalculated next time the OBJECT's bounds are requested
+ *  Marks the cached bounds of the given OBJECT and its parents as
+ *  having been invalidated and in need of an update. They will be
+ *  recalculated next time the OBJECT's bounds are requested
  *  (e.g. via world_get_single_object_bounds() ).
+ *
+ *  The OBJECT itself is measured again from scratch.  If its old bounds
+ *  lay strictly inside those of its parent, it did not define any edge
+ *  of the parent, so the parent keeps its bounds and only records the
+ *  changed child; o_complex_recalc() then grows the old bounds by the
+ *  new bounds of its changed children instead of measuring all of its
+ *  primitives again.  The same test is applied further up the chain.
+ *
  *  \param [in] toplevel
  *  \param [in] obj
- *
- *  \todo Turn this into a macro?
  */
 void o_bounds_invalidate(TOPLEVEL *toplevel, OBJECT *obj)
 {
-  do {
-      obj->w_bounds_valid = FALSE;
-  } while ((obj = obj->parent) != NULL);
+  OBJECT *parent;
+  gboolean known;
+
+  o_touch_object (obj);
+
+  known = o_bounds_known (obj);
+
+  obj->w_bounds_valid = FALSE;
+  if (obj->complex != NULL) {
+    g_list_free (obj->complex->changed_prims);
+    obj->complex->changed_prims = NULL;
+  }
+
+  for (; (parent = obj->parent) != NULL; obj = parent) {
+    gboolean parent_known = o_bounds_known (parent);
+    COMPLEX *complex = parent->complex;
+
+    if (known && parent_known && o_bounds_inside (obj, parent)) {
+      if (g_list_find (complex->changed_prims, obj) == NULL)
+        complex->changed_prims = g_list_prepend (complex->changed_prims, obj);
+    } else {
+      g_list_free (complex->changed_prims);
+      complex->changed_prims = NULL;
+    }
+    parent->w_bounds_valid = FALSE;
+
+    known = parent_known;
+  }
+}
+
+
+/*! \brief Record that an object's geometry changed
+ *
+ *  \par Function Description
+ *  Queues \a object to be placed again in its page's spatial index,
+ *  and records it in the page's journal for undo.  This should be
+ *  called whenever an object's bounds are recalculated or
+ *  invalidated.
+ *
+ *  \param [in] object  The OBJECT which changed.
+ */
+void o_touch_object (OBJECT *object)
+{
+  s_index_touch_object (object);
+  s_page_journal_note (object);
+
+  /* Any cached hatch lines no longer match the geometry */
+  object->hatch_style = NULL;
 }
 
 
@@ -587,6 +679,8 @@ void o_set_color (TOPLEVEL *toplevel, OBJECT *object, int color)
   if (object->type == OBJ_COMPLEX ||
       object->type == OBJ_PLACEHOLDER)
     o_glist_set_color (toplevel, object->complex->prim_objs, color);
+
+  s_page_journal_note (object);
 }
 
 
@@ -672,6 +766,13 @@ struct change_notify_entry {
   void *user_data;
 };
 
+/* Structure for each entry in a TOPLEVEL's list of registered damage
+ * notification handlers */
+struct damage_notify_entry {
+  DamageNotifyFunc damage_func;
+  void *user_data;
+};
+
 /*! \brief Add change notification handlers to a TOPLEVEL.
  * \par Function Description
  * Adds a set of change notification handlers to a #TOPLEVEL instance.
@@ -737,6 +838,287 @@ o_remove_change_notify (TOPLEVEL *toplevel,
     g_list_remove_all (toplevel->change_notify_funcs, NULL);
 }
 
+/*! \brief Add a damage notification handler to a TOPLEVEL.
+ * \par Function Description
+ * Adds a damage notification handler to a #TOPLEVEL instance.
+ * \a damage_func is called with the world coordinates of a rectangle
+ * which needs to be redrawn, and the given \a user_data: once with the
+ * old bounds of an object before it is modified, and once with its new
+ * bounds afterwards.  Between o_change_notify_freeze() and
+ * o_change_notify_thaw() the rectangles are merged instead, and \a
+ * damage_func is called once for the whole batch.
+ *
+ * \param toplevel #TOPLEVEL structure to add the handler to.
+ * \param damage_func Function to be called with damaged regions.
+ * \param user_data User data to be passed to the callback function.
+ */
+void
+o_add_damage_notify (TOPLEVEL *toplevel,
+                     DamageNotifyFunc damage_func,
+                     void *user_data)
+{
+  struct damage_notify_entry *entry = g_new0 (struct damage_notify_entry, 1);
+  entry->damage_func = damage_func;
+  entry->user_data = user_data;
+  toplevel->damage_notify_funcs =
+    g_list_prepend (toplevel->damage_notify_funcs, entry);
+}
+
+/*! \brief Remove a damage notification handler from a TOPLEVEL.
+ * \par Function Description
+ * Removes a damage notification handler and its associated \a
+ * user_data from \a toplevel.  If no registered handler matches the
+ * given \a damage_func and \a user_data, does nothing.
+ *
+ * \see o_add_damage_notify()
+ *
+ * \param toplevel #TOPLEVEL structure to remove the handler from.
+ * \param damage_func Function called with damaged regions.
+ * \param user_data User data passed to the callback function.
+ */
+void
+o_remove_damage_notify (TOPLEVEL *toplevel,
+                        DamageNotifyFunc damage_func,
+                        void *user_data)
+{
+  GList *iter;
+  for (iter = toplevel->damage_notify_funcs;
+       iter != NULL; iter = g_list_next (iter)) {
+
+    struct damage_notify_entry *entry =
+      (struct damage_notify_entry *) iter->data;
+
+    if ((entry != NULL)
+        && (entry->damage_func == damage_func)
+        && (entry->user_data == user_data)) {
+      g_free (entry);
+      iter->data = NULL;
+    }
+  }
+  toplevel->damage_notify_funcs =
+    g_list_remove_all (toplevel->damage_notify_funcs, NULL);
+}
+
+/*! \brief Merge the bounds of an object into the damage of a batch.
+ * \par Function Description
+ * Extends the damaged region of the batch started by
+ * o_change_notify_freeze() to include the bounds of \a object.
+ *
+ * \param toplevel #TOPLEVEL structure holding the batch.
+ * \param object   #OBJECT whose bounds are damaged.
+ */
+static void
+o_change_notify_damage_add (TOPLEVEL *toplevel, OBJECT *object)
+{
+  BOUNDS *damage = &toplevel->change_notify_damage;
+  int left, top, right, bottom;
+
+  if (toplevel->damage_notify_funcs == NULL)
+    return;
+
+  if (!world_get_single_object_bounds (toplevel, object,
+                                       &left, &top, &right, &bottom))
+    return;
+
+  if (!toplevel->change_notify_damaged) {
+    damage->min_x = left;
+    damage->min_y = top;
+    damage->max_x = right;
+    damage->max_y = bottom;
+    toplevel->change_notify_damaged = TRUE;
+  } else {
+    damage->min_x = MIN (damage->min_x, left);
+    damage->min_y = MIN (damage->min_y, top);
+    damage->max_x = MAX (damage->max_x, right);
+    damage->max_y = MAX (damage->max_y, bottom);
+  }
+}
+
+/*! \brief Report damage to the bounds of an object.
+ * \par Function Description
+ * Calls each damage callback function registered with \a toplevel
+ * with the bounds of \a object, or while change notification is
+ * frozen, merges them into the damage of the current batch.
+ *
+ * \param toplevel #TOPLEVEL structure to emit notifications from.
+ * \param object   #OBJECT whose bounds are damaged.
+ */
+static void
+o_emit_damage (TOPLEVEL *toplevel, OBJECT *object)
+{
+  GList *iter;
+  int left, top, right, bottom;
+
+  if (toplevel->change_notify_freeze_count > 0) {
+    o_change_notify_damage_add (toplevel, object);
+    return;
+  }
+
+  if (toplevel->damage_notify_funcs == NULL)
+    return;
+
+  if (!world_get_single_object_bounds (toplevel, object,
+                                       &left, &top, &right, &bottom))
+    return;
+
+  for (iter = toplevel->damage_notify_funcs;
+       iter != NULL; iter = g_list_next (iter)) {
+
+    struct damage_notify_entry *entry =
+      (struct damage_notify_entry *) iter->data;
+
+    if (entry != NULL) {
+      entry->damage_func (entry->user_data, left, top, right, bottom);
+    }
+  }
+}
+
+/*! \brief Add an object to the current batch of changes.
+ * \par Function Description
+ * Records \a object as changed in the batch started by
+ * o_change_notify_freeze().
+ *
+ * \param toplevel #TOPLEVEL structure holding the batch.
+ * \param object   #OBJECT which has changed.
+ * \return TRUE if \a object was not yet part of the batch.
+ */
+static gboolean
+o_change_notify_batch_add (TOPLEVEL *toplevel, OBJECT *object)
+{
+  if (toplevel->change_notify_batch == NULL)
+    toplevel->change_notify_batch = g_hash_table_new (NULL, NULL);
+
+  if (g_hash_table_lookup (toplevel->change_notify_batch, object) != NULL)
+    return FALSE;
+
+  g_hash_table_insert (toplevel->change_notify_batch, object, object);
+  toplevel->change_notify_order =
+    g_list_prepend (toplevel->change_notify_order, object);
+  return TRUE;
+}
+
+/*! \brief Start a batch of object changes.
+ * \par Function Description
+ * Until the matching call to o_change_notify_thaw(), change
+ * notifications for \a toplevel are coalesced: a pre-change handler
+ * is called only the first time each object is modified, change
+ * handlers are called once per modified object when the batch ends,
+ * and damage handlers are called once with the merged bounds of
+ * everything modified.  Use this around bulk operations, such as
+ * transforming or editing every object in a selection.
+ *
+ * Calls may be nested; only the outermost thaw emits notifications.
+ *
+ * \param toplevel #TOPLEVEL structure to freeze notifications for.
+ */
+void
+o_change_notify_freeze (TOPLEVEL *toplevel)
+{
+  g_return_if_fail (toplevel != NULL);
+
+  toplevel->change_notify_freeze_count++;
+}
+
+/*! \brief End a batch of object changes.
+ * \par Function Description
+ * Ends a batch started by o_change_notify_freeze().  When the
+ * outermost batch ends, the change handlers are called for each
+ * object modified during the batch, and the damage handlers are
+ * called once with the merged bounds of those objects before and
+ * after the changes.
+ *
+ * \param toplevel #TOPLEVEL structure to thaw notifications for.
+ */
+void
+o_change_notify_thaw (TOPLEVEL *toplevel)
+{
+  GHashTable *batch;
+  GList *order, *obj_iter, *iter;
+
+  g_return_if_fail (toplevel != NULL);
+  g_return_if_fail (toplevel->change_notify_freeze_count > 0);
+
+  if (--toplevel->change_notify_freeze_count > 0)
+    return;
+
+  /* Take ownership of the batch, in case a handler starts another */
+  batch = toplevel->change_notify_batch;
+  order = g_list_reverse (toplevel->change_notify_order);
+  toplevel->change_notify_batch = NULL;
+  toplevel->change_notify_order = NULL;
+
+  for (obj_iter = order; obj_iter != NULL; obj_iter = g_list_next (obj_iter)) {
+    OBJECT *object = (OBJECT *) obj_iter->data;
+
+    /* Skip objects freed during the batch */
+    if (g_hash_table_lookup (batch, object) == NULL)
+      continue;
+    g_hash_table_remove (batch, object);
+
+    /* Merge in the new bounds of the object */
+    o_change_notify_damage_add (toplevel, object);
+
+    for (iter = toplevel->change_notify_funcs;
+         iter != NULL; iter = g_list_next (iter)) {
+
+      struct change_notify_entry *entry =
+        (struct change_notify_entry *) iter->data;
+
+      if ((entry != NULL) && (entry->change_func != NULL)) {
+        entry->change_func (entry->user_data, object);
+      }
+    }
+  }
+  g_list_free (order);
+
+  /* Keep the emptied set for the next batch */
+  if (batch != NULL) {
+    if (toplevel->change_notify_batch == NULL) {
+      g_hash_table_remove_all (batch);
+      toplevel->change_notify_batch = batch;
+    } else {
+      g_hash_table_destroy (batch);
+    }
+  }
+
+  if (toplevel->change_notify_damaged) {
+    BOUNDS damage = toplevel->change_notify_damage;
+    toplevel->change_notify_damaged = FALSE;
+
+    for (iter = toplevel->damage_notify_funcs;
+         iter != NULL; iter = g_list_next (iter)) {
+
+      struct damage_notify_entry *entry =
+        (struct damage_notify_entry *) iter->data;
+
+      if (entry != NULL) {
+        entry->damage_func (entry->user_data,
+                            damage.min_x, damage.min_y,
+                            damage.max_x, damage.max_y);
+      }
+    }
+  }
+}
+
+/*! \brief Drop an object from the current batch of changes.
+ * \par Function Description
+ * Called when \a object is about to be freed, so that the end of the
+ * current batch does not notify about it.  Damage already recorded
+ * for it is kept.
+ *
+ * \param toplevel #TOPLEVEL structure holding the batch.
+ * \param object   #OBJECT being freed.
+ */
+void
+o_change_notify_forget (TOPLEVEL *toplevel, OBJECT *object)
+{
+  if (toplevel == NULL || toplevel->change_notify_batch == NULL)
+    return;
+
+  /* Its entry in the batch order is skipped when the batch ends */
+  g_hash_table_remove (toplevel->change_notify_batch, object);
+}
+
 /*! \brief Emit an object pre-change notification.
  * \par Function Description
  * Calls each pre-change callback function registered with #TOPLEVEL
@@ -751,6 +1133,14 @@ void
 o_emit_pre_change_notify (TOPLEVEL *toplevel, OBJECT *object)
 {
   GList *iter;
+
+  /* Within a batch, only the state before the first change matters */
+  if (toplevel->change_notify_freeze_count > 0 &&
+      !o_change_notify_batch_add (toplevel, object))
+    return;
+
+  o_emit_damage (toplevel, object);
+
   for (iter = toplevel->change_notify_funcs;
        iter != NULL; iter = g_list_next (iter)) {
 
@@ -775,8 +1165,34 @@ o_emit_pre_change_notify (TOPLEVEL *toplevel, OBJECT *object)
  */
 void
 o_emit_change_notify (TOPLEVEL *toplevel, OBJECT *object)
+{
+  s_page_journal_note (object);
+  o_emit_display_change_notify (toplevel, object);
+}
+
+/*! \brief Emit an object change notification for its display only.
+ * \par Function Description
+ * Like o_emit_change_notify(), but for changes which only affect how
+ * \a object is displayed, such as its selection state or connection
+ * cues, and so are not recorded in the page's journal for undo.
+ *
+ * \param toplevel #TOPLEVEL structure to emit notifications from.
+ * \param object   #OBJECT structure to emit notifications for.
+ */
+void
+o_emit_display_change_notify (TOPLEVEL *toplevel, OBJECT *object)
 {
   GList *iter;
+
+  /* Within a batch, handlers are called when it ends */
+  if (toplevel->change_notify_freeze_count > 0) {
+    if (o_change_notify_batch_add (toplevel, object))
+      o_change_notify_damage_add (toplevel, object);
+    return;
+  }
+
+  o_emit_damage (toplevel, object);
+
   for (iter = toplevel->change_notify_funcs;
        iter != NULL; iter = g_list_next (iter)) {
 
@@ -823,6 +1239,47 @@ o_set_visibility (TOPLEVEL *toplevel, OBJECT *object, int visibility)
   }
 }
 
+/*! \brief Get the session-unique name of an object.
+ *  \par Function Description
+ *  Returns a name of the form "<prefix>.<sid>", where the prefix is
+ *  derived from the object type (e.g. "net.42").  The name is only
+ *  used for diagnostics, so it is formatted the first time it is
+ *  requested and cached in the object rather than built for every
+ *  object on creation.
+ *
+ *  \param [in] object  The #OBJECT to name.
+ *  \return The object's name, owned by the object.
+ */
+const gchar *
+o_get_name (OBJECT *object)
+{
+  const gchar *prefix;
+
+  g_return_val_if_fail (object != NULL, NULL);
+
+  if (object->name != NULL)
+    return object->name;
+
+  switch (object->type) {
+    case OBJ_LINE:        prefix = "line";    break;
+    case OBJ_PATH:        prefix = "path";    break;
+    case OBJ_BOX:         prefix = "box";     break;
+    case OBJ_PICTURE:     prefix = "picture"; break;
+    case OBJ_CIRCLE:      prefix = "circle";  break;
+    case OBJ_NET:         prefix = "net";     break;
+    case OBJ_BUS:         prefix = "bus";     break;
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER: prefix = "complex"; break;
+    case OBJ_TEXT:        prefix = "text";    break;
+    case OBJ_PIN:         prefix = "pin";     break;
+    case OBJ_ARC:         prefix = "arc";     break;
+    default:              prefix = "object";  break;
+  }
+
+  object->name = g_strdup_printf ("%s.%d", prefix, object->sid);
+  return object->name;
+}
+
 /*! \brief Get capstyle for printing of an object.
  *  \par Function Description
  *  This function gets the object's capstyle for printing from its line end.
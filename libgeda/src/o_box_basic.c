@@ -68,8 +68,7 @@ OBJECT *o_box_new(TOPLEVEL *toplevel,
   new_node = s_basic_new_object(type, "box");
   new_node->color = color;
 
-  box = (BOX *) g_malloc(sizeof(BOX));
-  new_node->box   = box;
+  box = new_node->box;
 
   /* describe the box with its upper left and lower right corner */
   box->upper_x = x1;
@@ -119,13 +118,13 @@ OBJECT *o_box_copy(TOPLEVEL *toplevel, OBJECT *o_current)
   new_obj->box->lower_x = o_current->box->lower_x;
   new_obj->box->lower_y = o_current->box->lower_y;
 
-  o_set_line_options(toplevel, new_obj, o_current->line_end,
-		     o_current->line_type, o_current->line_width,
-		     o_current->line_length, o_current->line_space);
+  o_set_line_options(toplevel, new_obj, o_current->style->line_end,
+		     o_current->style->line_type, o_current->style->line_width,
+		     o_current->style->line_length, o_current->style->line_space);
   o_set_fill_options(toplevel, new_obj,
-		     o_current->fill_type, o_current->fill_width,
-		     o_current->fill_pitch1, o_current->fill_angle1,
-		     o_current->fill_pitch2, o_current->fill_angle2);
+		     o_current->style->fill_type, o_current->style->fill_width,
+		     o_current->style->fill_pitch1, o_current->style->fill_angle1,
+		     o_current->style->fill_pitch2, o_current->style->fill_angle2);
 
   o_box_recalc(toplevel, new_obj);
 
@@ -361,21 +360,18 @@ OBJECT *o_box_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a character string representation of a BOX.
+/*! \brief Append a character string representation of a BOX.
  *  \par Function Description
- *  This function formats a string in the buffer <B>*buff</B> to describe the
+ *  This function appends a string to the buffer <B>*buf</B> to describe the
  *  box object <B>*object</B>.
  *  It follows the post-20000704 release file format that handle the line type
  *  and fill options.
  *
  *  \param [in] toplevel  The TOPLEVEL structure.
  *  \param [in] object  The BOX OBJECT to create string from.
- *  \return A pointer to the BOX character string.
- *
- *  \warning
- *  Caller must g_free returned character string.
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_box_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_box_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x1, y1; 
   int width, height;
@@ -384,7 +380,6 @@ char *o_box_save(TOPLEVEL *toplevel, OBJECT *object)
   OBJECT_END box_end;
   OBJECT_TYPE box_type;
   OBJECT_FILLING box_fill;
-  char *buf;
 
   /*! \note
    *  A box is internally represented by its lower right and upper left corner
@@ -405,28 +400,26 @@ char *o_box_save(TOPLEVEL *toplevel, OBJECT *object)
 #endif
 
   /* description of the line type for the outline */
-  box_end    = object->line_end;
-  box_width  = object->line_width;
-  box_type   = object->line_type;
-  box_length = object->line_length;
-  box_space  = object->line_space;
+  box_end    = object->style->line_end;
+  box_width  = object->style->line_width;
+  box_type   = object->style->line_type;
+  box_length = object->style->line_length;
+  box_space  = object->style->line_space;
   
   /* description of the filling of the box */
-  box_fill   = object->fill_type;
-  fill_width = object->fill_width;
-  angle1     = object->fill_angle1;
-  pitch1     = object->fill_pitch1;
-  angle2     = object->fill_angle2;
-  pitch2     = object->fill_pitch2;
-
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d", 
-			object->type,
-			x1, y1, width, height, object->color,
-			box_width, box_end, box_type, box_length, box_space, 
-			box_fill,
-			fill_width, angle1, pitch1, angle2, pitch2);
-			
-  return(buf);
+  box_fill   = object->style->fill_type;
+  fill_width = object->style->fill_width;
+  angle1     = object->style->fill_angle1;
+  pitch1     = object->style->fill_pitch1;
+  angle2     = object->style->fill_angle2;
+  pitch2     = object->style->fill_pitch2;
+
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+                         object->type,
+                         x1, y1, width, height, object->color,
+                         box_width, box_end, box_type, box_length, box_space,
+                         box_fill,
+                         fill_width, angle1, pitch1, angle2, pitch2);
 }
 
 /*! \brief Translate a BOX position in WORLD coordinates by a delta.
@@ -589,6 +582,7 @@ void o_box_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right  = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief Get BOX bounding rectangle in WORLD coordinates.
@@ -609,7 +603,7 @@ void world_get_box_bounds(TOPLEVEL *toplevel, OBJECT *object,
 {
   int halfwidth;
 
-  halfwidth = object->line_width / 2;
+  halfwidth = object->style->line_width / 2;
 
   *left   = min(object->box->upper_x, object->box->lower_x);
   *top    = min(object->box->upper_y, object->box->lower_y);
@@ -685,7 +679,7 @@ void o_box_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
   width  = abs(o_current->box->lower_x - o_current->box->upper_x);
   height = abs(o_current->box->lower_y - o_current->box->upper_y);
   color  = o_current->color;
-  capstyle = o_get_capstyle (o_current->line_end);
+  capstyle = o_get_capstyle (o_current->style->line_end);
 
   /*! \note
    *  Depending on the type of the line for this particular box, the
@@ -701,7 +695,7 @@ void o_box_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    *  solid to avoid and endless loop produced by other functions in such a
    *  case.
    */
-  line_width = o_current->line_width;
+  line_width = o_current->style->line_width;
   
   if(line_width <=2) {
     if(toplevel->line_style == THICK) {
@@ -710,10 +704,10 @@ void o_box_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
       line_width=2;
     }
   }
-  length = o_current->line_length;
-  space  = o_current->line_space;
+  length = o_current->style->line_length;
+  space  = o_current->style->line_space;
 
-  switch(o_current->line_type) {
+  switch(o_current->style->line_type) {
     case(TYPE_SOLID):
       length = -1; space  = -1;
       outl_func = o_box_print_solid;
@@ -767,14 +761,14 @@ void o_box_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    *  In such a case, the box is printed filled. Unused parameters for each of
    *  these functions are set to -1 or any passive value.
    */
-  if(o_current->fill_type != FILLING_HOLLOW) {
-    fill_width = o_current->fill_width;
-    angle1     = o_current->fill_angle1;
-    pitch1     = o_current->fill_pitch1;
-    angle2     = o_current->fill_angle2;
-    pitch2     = o_current->fill_pitch2;
+  if(o_current->style->fill_type != FILLING_HOLLOW) {
+    fill_width = o_current->style->fill_width;
+    angle1     = o_current->style->fill_angle1;
+    pitch1     = o_current->style->fill_pitch1;
+    angle2     = o_current->style->fill_angle2;
+    pitch2     = o_current->style->fill_pitch2;
 	
-    switch(o_current->fill_type) {
+    switch(o_current->style->fill_type) {
       case(FILLING_FILL):
 	angle1 = -1; pitch1 = 1;
 	angle2 = -1; pitch2 = 1;
@@ -1335,7 +1329,7 @@ double o_box_shortest_distance (OBJECT *object, int x, int y, int force_solid)
 
   g_return_val_if_fail (object->box != NULL, G_MAXDOUBLE);
 
-  solid = force_solid || object->fill_type != FILLING_HOLLOW;
+  solid = force_solid || object->style->fill_type != FILLING_HOLLOW;
 
   return m_box_shortest_distance (object->box, x, y, solid);
 }
@@ -89,14 +89,13 @@ OBJECT *o_bus_new(TOPLEVEL *toplevel,
   new_node = s_basic_new_object(type, "bus");
   new_node->color = color;
 
-  new_node->line = (LINE *) g_malloc(sizeof(LINE));
   /* check for null */	
 
   new_node->line->x[0] = x1;
   new_node->line->y[0] = y1;
   new_node->line->x[1] = x2;
   new_node->line->y[1] = y2;
-  new_node->line_width = BUS_WIDTH;
+  s_style_set_line_width (new_node, BUS_WIDTH);
 
   new_node->bus_ripper_direction = bus_ripper_direction;
 
@@ -131,6 +130,7 @@ void o_bus_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief read a bus object from a char buffer
@@ -195,28 +195,26 @@ OBJECT *o_bus_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a string representation of the bus object
+/*! \brief Append a string representation of the bus object
  *  \par Function Description
- *  This function takes a bus \a object and return a string
- *  according to the file format definition.
+ *  This function takes a bus \a object and appends a string
+ *  according to the file format definition to \a buf.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  a bus OBJECT
- *  \return the string representation of the bus OBJECT
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_bus_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_bus_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x1, x2, y1, y2;
-  char *buf;
 
   x1 = object->line->x[0];
   y1 = object->line->y[0];
   x2 = object->line->x[1];
   y2 = object->line->y[1];
 
-  buf = g_strdup_printf("%c %d %d %d %d %d %d", object->type,
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d", object->type,
           x1, y1, x2, y2, object->color, object->bus_ripper_direction);
-  return(buf);
 }
        
 /*! \brief move a bus object
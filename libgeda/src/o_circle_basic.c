@@ -84,7 +84,6 @@ OBJECT *o_circle_new(TOPLEVEL *toplevel,
   new_node = s_basic_new_object(type, "circle");
   new_node->color  = color;
   
-  new_node->circle = (CIRCLE *) g_malloc(sizeof(CIRCLE));
   
   /* describe the circle with its center and radius */
   new_node->circle->center_x = x;
@@ -133,13 +132,13 @@ OBJECT *o_circle_copy(TOPLEVEL *toplevel, OBJECT *o_current)
   new_obj->circle->center_y = o_current->circle->center_y;
   new_obj->circle->radius   = o_current->circle->radius;
   
-  o_set_line_options(toplevel, new_obj, o_current->line_end,
-		     o_current->line_type, o_current->line_width,
-		     o_current->line_length, o_current->line_space);
+  o_set_line_options(toplevel, new_obj, o_current->style->line_end,
+		     o_current->style->line_type, o_current->style->line_width,
+		     o_current->style->line_length, o_current->style->line_space);
   o_set_fill_options(toplevel, new_obj,
-		     o_current->fill_type, o_current->fill_width,
-		     o_current->fill_pitch1, o_current->fill_angle1,
-		     o_current->fill_pitch2, o_current->fill_angle2);
+		     o_current->style->fill_type, o_current->style->fill_width,
+		     o_current->style->fill_pitch1, o_current->style->fill_angle1,
+		     o_current->style->fill_pitch2, o_current->style->fill_angle2);
   
   o_circle_recalc(toplevel, new_obj);
 
@@ -308,28 +307,23 @@ OBJECT *o_circle_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a character string representation of a circle OBJECT.
+/*! \brief Append a character string representation of a circle OBJECT.
  *  \par Function Description
- *  This function formats a string in the buffer <B>*buff</B> to describe the
+ *  This function appends a string to the buffer <B>*buf</B> to describe the
  *  circle object <B>*object</B>.
  *  It follows the post-20000704 release file format that handle the line
  *  type and fill options.
  *
  *  \param [in] toplevel  a TOPLEVEL structure.
  *  \param [in] object  Circle OBJECT to create string from.
- *  \return A pointer to the circle OBJECT character string.
- *
- *  \note
- *  Caller must g_free returned character string.
- *
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_circle_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_circle_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x,y;
   int radius;
   int circle_width, circle_space, circle_length;
   int fill_width, angle1, pitch1, angle2, pitch2;
-  char *buf;
   OBJECT_END circle_end;
   OBJECT_TYPE circle_type;
   OBJECT_FILLING circle_fill;
@@ -340,26 +334,25 @@ char *o_circle_save(TOPLEVEL *toplevel, OBJECT *object)
   radius = object->circle->radius;
   
   /* line type parameters */
-  circle_width = object->line_width;
-  circle_end   = object->line_end;
-  circle_type  = object->line_type;
-  circle_length= object->line_length;
-  circle_space = object->line_space;
+  circle_width = object->style->line_width;
+  circle_end   = object->style->line_end;
+  circle_type  = object->style->line_type;
+  circle_length= object->style->line_length;
+  circle_space = object->style->line_space;
   
   /* filling parameters */
-  circle_fill  = object->fill_type;
-  fill_width   = object->fill_width;
-  angle1       = object->fill_angle1;
-  pitch1       = object->fill_pitch1;
-  angle2       = object->fill_angle2;
-  pitch2       = object->fill_pitch2;
+  circle_fill  = object->style->fill_type;
+  fill_width   = object->style->fill_width;
+  angle1       = object->style->fill_angle1;
+  pitch1       = object->style->fill_pitch1;
+  angle2       = object->style->fill_angle2;
+  pitch2       = object->style->fill_pitch2;
   
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d", 
-			object->type, x, y, radius, object->color,
-			circle_width, circle_end, circle_type, circle_length, 
-			circle_space, circle_fill,
-			fill_width, angle1, pitch1, angle2, pitch2);
-  return(buf);
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+                         object->type, x, y, radius, object->color,
+                         circle_width, circle_end, circle_type, circle_length,
+                         circle_space, circle_fill,
+                         fill_width, angle1, pitch1, angle2, pitch2);
 }
            
 /*! \brief Translate a circle position in WORLD coordinates by a delta.
@@ -497,6 +490,7 @@ void o_circle_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right  = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief Get circle bounding rectangle in WORLD coordinates.
@@ -517,7 +511,7 @@ void world_get_circle_bounds(TOPLEVEL *toplevel, OBJECT *object, int *left,
 {
   int halfwidth;
 
-  halfwidth = object->line_width / 2;
+  halfwidth = object->style->line_width / 2;
 
   *left   = object->circle->center_x - object->circle->radius;
   *top    = object->circle->center_y - object->circle->radius;
@@ -593,7 +587,7 @@ void o_circle_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
   radius = o_current->circle->radius;
 
   color  = o_current->color;
-  capstyle = o_get_capstyle (o_current->line_end);
+  capstyle = o_get_capstyle (o_current->style->line_end);
 
   /*
    * Depending on the type of the line for this particular circle, the
@@ -609,7 +603,7 @@ void o_circle_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    * printed solid to avoid and endless loop produced by other functions
    * in such a case.
    */
-  circle_width = o_current->line_width;
+  circle_width = o_current->style->line_width;
   if(circle_width <=2) {
     if(toplevel->line_style == THICK) {
       circle_width=LINE_WIDTH;
@@ -617,10 +611,10 @@ void o_circle_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
       circle_width=2;
     }
   }
-  length       = o_current->line_length;
-  space        = o_current->line_space;
+  length       = o_current->style->line_length;
+  space        = o_current->style->line_space;
 
-  switch(o_current->line_type) {
+  switch(o_current->style->line_type) {
     case(TYPE_SOLID):
       length = -1; space  = -1;
       outl_func = o_circle_print_solid;
@@ -673,14 +667,14 @@ void o_circle_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    * In such a case, the circle is printed filled. Unused parameters for
    * each of these functions are set to -1 or any passive value.
    */
-  if(o_current->fill_type != FILLING_HOLLOW) {
-    fill_width = o_current->fill_width;
-    angle1     = o_current->fill_angle1;
-    pitch1     = o_current->fill_pitch1;
-    angle2     = o_current->fill_angle2;
-    pitch2     = o_current->fill_pitch2;
+  if(o_current->style->fill_type != FILLING_HOLLOW) {
+    fill_width = o_current->style->fill_width;
+    angle1     = o_current->style->fill_angle1;
+    pitch1     = o_current->style->fill_pitch1;
+    angle2     = o_current->style->fill_angle2;
+    pitch2     = o_current->style->fill_pitch2;
 		
-    switch(o_current->fill_type) {
+    switch(o_current->style->fill_type) {
       case(FILLING_FILL):
         angle1 = -1; pitch1 = 1;
         angle2 = -1; pitch2 = 1;
@@ -1126,7 +1120,7 @@ double o_circle_shortest_distance (OBJECT *object, int x, int y,
 
   g_return_val_if_fail (object->circle != NULL, G_MAXDOUBLE);
 
-  solid = force_solid || object->fill_type != FILLING_HOLLOW;
+  solid = force_solid || object->style->fill_type != FILLING_HOLLOW;
 
   return m_circle_shortest_distance (object->circle, x, y, solid);
 }
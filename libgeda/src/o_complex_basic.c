@@ -502,7 +502,6 @@ OBJECT *o_complex_new(TOPLEVEL *toplevel,
   new_node->color = color;
   new_node->selectable = selectable;
 
-  new_node->complex = (COMPLEX *) g_malloc(sizeof(COMPLEX));
   new_node->complex->prim_objs = NULL;
   new_node->complex->angle = angle;
   new_node->complex->mirror = mirror;
@@ -573,7 +572,6 @@ OBJECT *o_complex_new_embedded(TOPLEVEL *toplevel,
 
   new_node = s_basic_new_object(type, "complex");
 
-  new_node->complex = (COMPLEX *) g_malloc(sizeof(COMPLEX));
   new_node->complex->x = x;
   new_node->complex->y = y;
 
@@ -597,6 +595,10 @@ OBJECT *o_complex_new_embedded(TOPLEVEL *toplevel,
 /*! \brief update the visual boundaries of the complex object
  *  \par Function Description
  *  This function updates the boundaries of the object \a o_current.
+ *  If only some of its primitives changed since the bounds were last
+ *  found (see o_bounds_invalidate()), the old bounds are grown by the
+ *  bounds of those primitives; otherwise all of the primitives are
+ *  measured.
  *
  *  \param [in]  toplevel  The TOPLEVEL object
  *  \param [in]  o_current The OBJECT to update
@@ -604,6 +606,8 @@ OBJECT *o_complex_new_embedded(TOPLEVEL *toplevel,
 void o_complex_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
 {
   int left, right, top, bottom;
+  int rleft, rtop, rright, rbottom;
+  GList *iter;
 
   /* realc routine Add this somewhere */
   /* libhack */
@@ -615,12 +619,41 @@ void o_complex_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   if (o_current->complex->prim_objs == NULL)
     return;
 
-  world_get_complex_bounds(toplevel, o_current, &left, &top, &right, &bottom);
+  if (o_current->complex->changed_prims != NULL) {
+    left = o_current->w_left;
+    top = o_current->w_top;
+    right = o_current->w_right;
+    bottom = o_current->w_bottom;
+
+    for (iter = o_current->complex->changed_prims;
+         iter != NULL; iter = g_list_next (iter)) {
+      OBJECT *o_prim = iter->data;
+
+      /* It may have been taken out of the complex since */
+      if (o_prim->parent != o_current)
+        continue;
+
+      if (world_get_single_object_bounds (toplevel, o_prim,
+                                          &rleft, &rtop, &rright, &rbottom)) {
+        left = min (left, rleft);
+        top = min (top, rtop);
+        right = max (right, rright);
+        bottom = max (bottom, rbottom);
+      }
+    }
+
+    g_list_free (o_current->complex->changed_prims);
+    o_current->complex->changed_prims = NULL;
+  } else {
+    world_get_complex_bounds(toplevel, o_current, &left, &top, &right, &bottom);
+  }
+
   o_current->w_left = left;
   o_current->w_top = top;
   o_current->w_right = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief read a complex object from a char buffer
@@ -706,39 +739,33 @@ OBJECT *o_complex_read (TOPLEVEL *toplevel,
   return new_obj;
 }
 
-/*! \brief Create a string representation of the complex object
+/*! \brief Append a string representation of the complex object
  *  \par Function Description
- *  This function takes a complex \a object and return a string
- *  according to the file format definition.
+ *  This function takes a complex \a object and appends a string
+ *  according to the file format definition to \a buf.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  a complex OBJECT
- *  \return the string representation of the complex OBJECT
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_complex_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_complex_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int selectable;
-  char *buf = NULL;
-  char *basename;
 
-  g_return_val_if_fail (object != NULL, NULL);
+  g_return_if_fail (object != NULL);
 
   selectable = (object->selectable) ? 1 : 0;
 
   if ((object->type == OBJ_COMPLEX) || (object->type == OBJ_PLACEHOLDER)) {
-    basename = g_strdup_printf ("%s%s",
-				object->complex_embedded ? "EMBEDDED" : "",
-				object->complex_basename);
     /* We force the object type to be output as OBJ_COMPLEX for both
      * these object types. */
-    buf = g_strdup_printf("%c %d %d %d %d %d %s", OBJ_COMPLEX,
-                          object->complex->x, object->complex->y,
-                          selectable, object->complex->angle,
-                          object->complex->mirror, basename);
-    g_free (basename);
+    g_string_append_printf(buf, "%c %d %d %d %d %d %s%s", OBJ_COMPLEX,
+                           object->complex->x, object->complex->y,
+                           selectable, object->complex->angle,
+                           object->complex->mirror,
+                           object->complex_embedded ? "EMBEDDED" : "",
+                           object->complex_basename);
   }
-
-  return(buf);
 }
 
 /*! \brief move a complex object
@@ -760,6 +787,10 @@ void o_complex_translate_world(TOPLEVEL *toplevel, int dx, int dy,
   object->complex->x = object->complex->x + dx;
   object->complex->y = object->complex->y + dy;
 
+  /* Every primitive moves, so all of them are measured again below */
+  g_list_free (object->complex->changed_prims);
+  object->complex->changed_prims = NULL;
+
   o_glist_translate_world (toplevel, dx, dy, object->complex->prim_objs);
 
   o_complex_recalc (toplevel, object);
@@ -786,7 +817,6 @@ OBJECT *o_complex_copy(TOPLEVEL *toplevel, OBJECT *o_current)
   o_new->complex_basename = g_strdup(o_current->complex_basename);
   o_new->complex_embedded = o_current->complex_embedded;
 
-  o_new->complex = g_malloc0(sizeof(COMPLEX));
   o_new->complex->x = o_current->complex->x;
   o_new->complex->y = o_current->complex->y;
   o_new->complex->angle = o_current->complex->angle;
@@ -1022,7 +1052,7 @@ o_complex_check_symversion(TOPLEVEL* toplevel, OBJECT* object)
   }
 
 #if DEBUG
-  printf("%s:\n\tinside: %.1f outside: %.1f\n\n", object->name,
+  printf("%s:\n\tinside: %.1f outside: %.1f\n\n", o_get_name (object),
          inside_value, outside_value);
 #endif
   
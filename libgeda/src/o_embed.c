@@ -71,6 +71,7 @@ void o_embed(TOPLEVEL *toplevel, OBJECT *o_current)
   if (page_modified && page != NULL) {
     /* page content has been modified */
     page->CHANGED = 1;
+    s_page_journal_note (o_current);
   }
 }
 
@@ -124,5 +125,6 @@ void o_unembed(TOPLEVEL *toplevel, OBJECT *o_current)
 
   if (page_modified && page != NULL) {
     page->CHANGED = 1;
+    s_page_journal_note (o_current);
   }
 }
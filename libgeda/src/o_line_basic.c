@@ -71,7 +71,6 @@ OBJECT *o_line_new(TOPLEVEL *toplevel,
   new_node = s_basic_new_object(type, "line");
   new_node->color = color;
   
-  new_node->line  = (LINE *) g_malloc(sizeof(LINE));
   
   /* describe the line with its two ends */
   new_node->line->x[0] = x1;
@@ -120,13 +119,13 @@ OBJECT *o_line_copy(TOPLEVEL *toplevel, OBJECT *o_current)
    */
 
   /* copy the line type and filling options */
-  o_set_line_options(toplevel, new_obj, o_current->line_end,
-		     o_current->line_type, o_current->line_width,
-		     o_current->line_length, o_current->line_space);
+  o_set_line_options(toplevel, new_obj, o_current->style->line_end,
+		     o_current->style->line_type, o_current->style->line_width,
+		     o_current->style->line_length, o_current->style->line_space);
   o_set_fill_options(toplevel, new_obj,
-		     o_current->fill_type, o_current->fill_width,
-		     o_current->fill_pitch1, o_current->fill_angle1,
-		     o_current->fill_pitch2, o_current->fill_angle2);
+		     o_current->style->fill_type, o_current->style->fill_width,
+		     o_current->style->fill_pitch1, o_current->style->fill_angle1,
+		     o_current->style->fill_pitch2, o_current->style->fill_angle2);
   
   /* calc the bounding box */
   o_line_recalc(toplevel, o_current);
@@ -284,26 +283,21 @@ OBJECT *o_line_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a character string representation of a line OBJECT.
+/*! \brief Append a character string representation of a line OBJECT.
  *  \par Function Description
- *  The function formats a string in the buffer <B>*buff</B> to describe
- *  the box object <B>*object</B>.
+ *  The function appends a string to the buffer <B>*buf</B> to describe
+ *  the line object <B>*object</B>.
  *  It follows the post-20000704 release file format that handle the
  *  line type and fill options - filling is irrelevant here.
  *
  *  \param [in] toplevel  a TOPLEVEL structure.
  *  \param [in] object  Line OBJECT to create string from.
- *  \return A pointer to the line OBJECT character string.
- *
- *  \note
- *  Caller must g_free returned character string.
- *
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_line_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_line_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x1, x2, y1, y2;
   int line_width, line_space, line_length;
-  char *buf;
   OBJECT_END line_end;
   OBJECT_TYPE line_type;
 
@@ -314,18 +308,16 @@ char *o_line_save(TOPLEVEL *toplevel, OBJECT *object)
   y2 = object->line->y[1];
   
   /* description of the line type */
-  line_width = object->line_width;
-  line_end   = object->line_end;
-  line_type  = object->line_type;
-  line_length= object->line_length;
-  line_space = object->line_space;
+  line_width = object->style->line_width;
+  line_end   = object->style->line_end;
+  line_type  = object->style->line_type;
+  line_length= object->style->line_length;
+  line_space = object->style->line_space;
   
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d %d %d %d", object->type,
-			x1, y1, x2, y2, object->color,
-			line_width, line_end, line_type,
-			line_length, line_space);
-
-  return(buf);
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d %d %d %d %d", object->type,
+                         x1, y1, x2, y2, object->color,
+                         line_width, line_end, line_type,
+                         line_length, line_space);
 }
 
 /*! \brief Translate a line position in WORLD coordinates by a delta.
@@ -457,6 +449,7 @@ void o_line_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right  = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief Get line bounding rectangle in WORLD coordinates.
@@ -477,7 +470,7 @@ void world_get_line_bounds(TOPLEVEL *toplevel, OBJECT *object,
 {
   int halfwidth;
 
-  halfwidth = object->line_width / 2;
+  halfwidth = object->style->line_width / 2;
 
   *left = min( object->line->x[0], object->line->x[1] );
   *top = min( object->line->y[0], object->line->y[1] );
@@ -544,7 +537,7 @@ void o_line_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
   x2    = o_current->line->x[1];
   y2    = o_current->line->y[1];
   color = o_current->color;
-  capstyle = o_get_capstyle (o_current->line_end);
+  capstyle = o_get_capstyle (o_current->style->line_end);
 
   /*
    * Depending on the type of the line for this particular line, the
@@ -559,7 +552,7 @@ void o_line_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    * In the eventuality of a length and/or space null, the line is printed
    * solid to avoid and endless loop produced by other functions.
    */
-  line_width = o_current->line_width;
+  line_width = o_current->style->line_width;
   if(line_width <=2) {
     if(toplevel->line_style == THICK) {
       line_width=LINE_WIDTH;
@@ -568,10 +561,10 @@ void o_line_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
     }
   }
 
-  length = o_current->line_length;
-  space  = o_current->line_space;
+  length = o_current->style->line_length;
+  space  = o_current->style->line_space;
   
-  switch(o_current->line_type) {
+  switch(o_current->style->line_type) {
     case(TYPE_SOLID):
       length = -1; space = -1;
       outl_func = o_line_print_solid;
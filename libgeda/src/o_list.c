@@ -230,11 +230,15 @@ void o_glist_translate_world(TOPLEVEL *toplevel, int dx, int dy, const GList *li
   const GList *iter = list;
   OBJECT *o_current;
 
+  o_change_notify_freeze (toplevel);
+
   while ( iter != NULL ) {
     o_current = (OBJECT *)iter->data;
     o_translate_world(toplevel, dx, dy, o_current);
     iter = g_list_next (iter);
   }
+
+  o_change_notify_thaw (toplevel);
 }
 
 
@@ -247,11 +251,15 @@ void o_glist_rotate_world (TOPLEVEL *toplevel, int x, int y, int angle, const GL
   const GList *iter = list;
   OBJECT *o_current;
 
+  o_change_notify_freeze (toplevel);
+
   while ( iter != NULL ) {
     o_current = (OBJECT *)iter->data;
     o_rotate_world (toplevel, x, y, angle, o_current);
     iter = g_list_next (iter);
   }
+
+  o_change_notify_thaw (toplevel);
 }
 
 
@@ -264,11 +272,15 @@ void o_glist_mirror_world (TOPLEVEL *toplevel, int x, int y, const GList *list)
   const GList *iter = list;
   OBJECT *o_current;
 
+  o_change_notify_freeze (toplevel);
+
   while ( iter != NULL ) {
     o_current = (OBJECT *)iter->data;
     o_mirror_world (toplevel, x, y, o_current);
     iter = g_list_next (iter);
   }
+
+  o_change_notify_thaw (toplevel);
 }
 
 
@@ -285,6 +297,10 @@ void o_glist_set_color (TOPLEVEL *toplevel, const GList *list, int color)
 {
   const GList *iter;
 
+  o_change_notify_freeze (toplevel);
+
   for (iter = list; iter != NULL; iter = g_list_next (iter))
     o_set_color (toplevel, iter->data, color);
+
+  o_change_notify_thaw (toplevel);
 }
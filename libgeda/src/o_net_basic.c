@@ -86,14 +86,13 @@ OBJECT *o_net_new(TOPLEVEL *toplevel, char type,
   new_node = s_basic_new_object(type, "net");
   new_node->color = color;
 
-  new_node->line = (LINE *) g_malloc(sizeof(LINE));
   /* check for null */
 
   new_node->line->x[0] = x1;
   new_node->line->y[0] = y1;
   new_node->line->x[1] = x2;
   new_node->line->y[1] = y2;
-  new_node->line_width = NET_WIDTH;
+  s_style_set_line_width (new_node, NET_WIDTH);
 
   o_net_recalc (toplevel, new_node);
 
@@ -128,6 +127,7 @@ void o_net_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief read a net object from a char buffer
@@ -178,27 +178,25 @@ OBJECT *o_net_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a string representation of the net object
+/*! \brief Append a string representation of the net object
  *  \par Function Description
- *  This function takes a net \a object and return a string
- *  according to the file format definition.
+ *  This function takes a net \a object and appends a string
+ *  according to the file format definition to \a buf.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  a net OBJECT
- *  \return the string representation of the net OBJECT
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_net_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_net_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x1, x2, y1, y2;
-  char *buf;
 
   x1 = object->line->x[0];
   y1 = object->line->y[0];
   x2 = object->line->x[1];
   y2 = object->line->y[1];
 
-  buf = g_strdup_printf("%c %d %d %d %d %d", object->type, x1, y1, x2, y2, object->color);
-  return (buf);
+  g_string_append_printf(buf, "%c %d %d %d %d %d", object->type, x1, y1, x2, y2, object->color);
 }
 
 /*! \brief move a net object
@@ -473,24 +471,21 @@ static void o_net_consolidate_lowlevel (OBJECT *object,
  */
 static int o_net_consolidate_nomidpoint (OBJECT *object, int x, int y)
 {
-  GList *c_current;
+  guint i;
   CONN *conn;
 
-  c_current = object->conn_list;
-  while(c_current != NULL) {
-    conn = (CONN *) c_current->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+    conn = &g_array_index (object->conns, CONN, i);
     if (conn->other_object) {
       if (conn->other_object->sid != object->sid &&
           conn->x == x && conn->y == y &&
           conn->type == CONN_MIDPOINT) {
 #if DEBUG        
-        printf("Found one! %s\n", conn->other_object->name); 
+        printf("Found one! %s\n", o_get_name (conn->other_object)); 
 #endif         
         return(FALSE);
       }
     }
-    
-    c_current = g_list_next(c_current);
   }
 
   return(TRUE);
@@ -510,7 +505,7 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
 {
   int object_orient;
   int other_orient;
-  GList *c_current;
+  guint i;
   CONN *conn;
   OBJECT *other_object;
   PAGE *page;
@@ -526,9 +521,8 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
 
   object_orient = o_net_orientation(object);
 
-  c_current = object->conn_list;
-  while(c_current != NULL) {
-    conn = (CONN *) c_current->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+    conn = &g_array_index (object->conns, CONN, i);
     other_object = conn->other_object;
 
     /* only look at end points which have a valid end on the other side */
@@ -546,7 +540,7 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
             other_orient != NEITHER) {
 
 #if DEBUG
-          printf("consolidating %s to %s\n", object->name, other_object->name);
+          printf("consolidating %s to %s\n", o_get_name (object), o_get_name (other_object));
 #endif
 
           o_net_consolidate_lowlevel(object, other_object, other_orient);
@@ -572,8 +566,6 @@ static int o_net_consolidate_segments (TOPLEVEL *toplevel, OBJECT *object)
       }
       
     }
-
-    c_current = g_list_next (c_current);
   }
 
   return(0);
@@ -663,8 +655,10 @@ void o_net_refresh_conn_cache(TOPLEVEL *toplevel, OBJECT *o_current)
   gint            num_conns = 0;
   GHashTable     *visited;
   GHashTableIter  iter;
-  GList          *stack = NULL;
+  GPtrArray      *stack;
+  OBJECT         *net;
   OBJECT         *obj;
+  guint           i;
   gpointer       key;
 
   g_return_if_fail (toplevel);
@@ -690,62 +684,49 @@ void o_net_refresh_conn_cache(TOPLEVEL *toplevel, OBJECT *o_current)
     num_conns += 1;
   }
 
-  /* Keep track of connections to search at each net segment in a stack.
-   * Each stack entry points to an entry in obj->conn_list.
-   * Pop the stack when we have no more connections to check.
-   * Push next entry on the stack if we encounter a net segment.
+  /* Keep track of the net segments whose connections are still to be
+   * searched in a stack.  Push a net segment when we first encounter it,
+   * and search all of its connections when it is popped.
    */
 
-  /* Initialise the stack for the starting net segment. */
-  stack = g_list_prepend (stack, o_current->conn_list);
-
-  while (stack != NULL) {
-    /* At start of the loop, take a new connection from the stack. */
-    GList *conn_list = (GList*) stack->data;
-    CONN *conn;
-
-    if (conn_list == NULL) {
-      /* No more connections to check at this level. Pop the stack. */
-      stack = g_list_delete_link (stack, stack);
-      continue;
-    }
-
-    /* Extract the next connected object and advance the connection list. */
-    conn = (CONN*) conn_list->data;
-    stack->data = (gpointer) g_list_next (conn_list);
-
-    if (conn == NULL)
-        /* should not happen */
-        continue;
-    obj = conn->other_object;
-    if (obj == NULL)
-        /* should not happen */
-        continue;
-
-    /* Act upon the object that is connected to the segment. */
-    switch (obj->type) {
-      case OBJ_PIN:
-      case OBJ_BUS:
-        if (NULL == g_hash_table_lookup (visited, obj)) {
-          g_hash_table_insert (visited, obj, obj);
-          num_conns += 1;
-        }
-        break;
-      case OBJ_NET:
-        if (NULL == g_hash_table_lookup (visited, obj)) {
-          g_hash_table_insert (visited, obj, obj);
-          /* Check if a netname= is attached to this net segment */
-          if (NULL != o_attrib_search_object_attribs_by_name (obj,
-                                                              "netname",
-                                                              0)) {
+  /* Initialise the stack with the starting net segment. */
+  stack = g_ptr_array_new ();
+  g_ptr_array_add (stack, o_current);
+
+  while (stack->len > 0) {
+    net = g_ptr_array_remove_index_fast (stack, stack->len - 1);
+
+    for (i = 0; net->conns != NULL && i < net->conns->len; i++) {
+      obj = g_array_index (net->conns, CONN, i).other_object;
+      if (obj == NULL)
+          /* should not happen */
+          continue;
+
+      /* Act upon the object that is connected to the segment. */
+      switch (obj->type) {
+        case OBJ_PIN:
+        case OBJ_BUS:
+          if (NULL == g_hash_table_lookup (visited, obj)) {
+            g_hash_table_insert (visited, obj, obj);
             num_conns += 1;
           }
-          /* Push new list of connections to check onto the stack */
-          stack = g_list_prepend (stack, obj->conn_list);
-        }
-        break;
-      default:
-        break;
+          break;
+        case OBJ_NET:
+          if (NULL == g_hash_table_lookup (visited, obj)) {
+            g_hash_table_insert (visited, obj, obj);
+            /* Check if a netname= is attached to this net segment */
+            if (NULL != o_attrib_search_object_attribs_by_name (obj,
+                                                                "netname",
+                                                                0)) {
+              num_conns += 1;
+            }
+            /* Push the net segment to search its connections later */
+            g_ptr_array_add (stack, obj);
+          }
+          break;
+        default:
+          break;
+      }
     }
   }
 
@@ -761,7 +742,7 @@ void o_net_refresh_conn_cache(TOPLEVEL *toplevel, OBJECT *o_current)
   }
 
   g_hash_table_destroy (visited);
-  g_list_free (stack);
+  g_ptr_array_free (stack, TRUE);
 }
 
 /*! \brief Check if net is fully connected.
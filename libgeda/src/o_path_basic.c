@@ -116,13 +116,13 @@ OBJECT *o_path_copy (TOPLEVEL *toplevel, OBJECT *o_current)
   g_free (path_string);
 
   /* copy the path type and filling options */
-  o_set_line_options (toplevel, new_obj, o_current->line_end,
-                      o_current->line_type, o_current->line_width,
-                      o_current->line_length, o_current->line_space);
+  o_set_line_options (toplevel, new_obj, o_current->style->line_end,
+                      o_current->style->line_type, o_current->style->line_width,
+                      o_current->style->line_length, o_current->style->line_space);
   o_set_fill_options (toplevel, new_obj,
-                      o_current->fill_type, o_current->fill_width,
-                      o_current->fill_pitch1, o_current->fill_angle1,
-                      o_current->fill_pitch2, o_current->fill_angle2);
+                      o_current->style->fill_type, o_current->style->fill_width,
+                      o_current->style->fill_pitch1, o_current->style->fill_angle1,
+                      o_current->style->fill_pitch2, o_current->style->fill_angle2);
 
   /* calc the bounding box */
   o_path_recalc (toplevel, o_current);
@@ -230,23 +230,18 @@ OBJECT *o_path_read (TOPLEVEL *toplevel,
 }
 
 
-/*! \brief Create a character string representation of a path OBJECT.
+/*! \brief Append a character string representation of a path OBJECT.
  *  \par Function Description
- *  The function formats a string in the buffer <B>*buff</B> to describe
+ *  The function appends a string to the buffer <B>*buf</B> to describe
  *  the path object <B>*object</B>.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  path OBJECT to create string from.
- *  \return A pointer to the path OBJECT character string.
- *
- *  \note
- *  Caller must g_free returned character string.
- *
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_path_save (TOPLEVEL *toplevel, OBJECT *object)
+void o_path_save (TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int line_width, line_space, line_length;
-  char *buf;
   int num_lines;
   OBJECT_END line_end;
   OBJECT_TYPE line_type;
@@ -255,30 +250,29 @@ char *o_path_save (TOPLEVEL *toplevel, OBJECT *object)
   char *path_string;
 
   /* description of the line type */
-  line_width  = object->line_width;
-  line_end    = object->line_end;
-  line_type   = object->line_type;
-  line_length = object->line_length;
-  line_space  = object->line_space;
+  line_width  = object->style->line_width;
+  line_end    = object->style->line_end;
+  line_type   = object->style->line_type;
+  line_length = object->style->line_length;
+  line_space  = object->style->line_space;
 
   /* filling parameters */
-  fill_type    = object->fill_type;
-  fill_width   = object->fill_width;
-  angle1       = object->fill_angle1;
-  pitch1       = object->fill_pitch1;
-  angle2       = object->fill_angle2;
-  pitch2       = object->fill_pitch2;
+  fill_type    = object->style->fill_type;
+  fill_width   = object->style->fill_width;
+  angle1       = object->style->fill_angle1;
+  pitch1       = object->style->fill_pitch1;
+  angle2       = object->style->fill_angle2;
+  pitch2       = object->style->fill_pitch2;
 
   path_string = s_path_string_from_path (object->path);
   num_lines = o_text_num_lines (path_string);
-  buf = g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d %d %d %d %d\n%s",
-                         object->type, object->color, line_width, line_end,
-                         line_type, line_length, line_space, fill_type,
-                         fill_width, angle1, pitch1, angle2, pitch2,
-                         num_lines, path_string);
+  g_string_append_printf (buf, "%c %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
+                          object->type, object->color, line_width, line_end,
+                          line_type, line_length, line_space, fill_type,
+                          fill_width, angle1, pitch1, angle2, pitch2,
+                          num_lines);
+  g_string_append (buf, path_string);
   g_free (path_string);
-
-  return buf;
 }
 
 
@@ -496,6 +490,7 @@ void o_path_recalc (TOPLEVEL *toplevel, OBJECT *o_current)
   } else {
     o_current->w_bounds_valid = FALSE;
   }
+  o_touch_object (o_current);
 }
 
 
@@ -556,7 +551,7 @@ void world_get_path_bounds (TOPLEVEL *toplevel, OBJECT *object,
 
   if (found_bound) {
     /* This isn't strictly correct, but a 1st order approximation */
-    halfwidth = object->line_width / 2;
+    halfwidth = object->style->line_width / 2;
     *left   -= halfwidth;
     *top    -= halfwidth;
     *right  += halfwidth;
@@ -926,7 +921,7 @@ void o_path_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    *  solid to avoid and endless loop produced by other functions in such a
    *  case.
    */
-  line_width = o_current->line_width;
+  line_width = o_current->style->line_width;
 
   if (line_width <= 2) {
     if (toplevel->line_style == THICK) {
@@ -935,10 +930,10 @@ void o_path_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
       line_width=2;
     }
   }
-  length = o_current->line_length;
-  space  = o_current->line_space;
+  length = o_current->style->line_length;
+  space  = o_current->style->line_space;
 
-  switch(o_current->line_type) {
+  switch(o_current->style->line_type) {
     case TYPE_SOLID:
       length = -1; space  = -1;
       outl_func = o_path_print_solid;
@@ -991,14 +986,14 @@ void o_path_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
    *  In such a case, the path is printed filled. Unused parameters for each of
    *  these functions are set to -1 or any passive value.
    */
-  if(o_current->fill_type != FILLING_HOLLOW) {
-    fill_width = o_current->fill_width;
-    angle1     = o_current->fill_angle1;
-    pitch1     = o_current->fill_pitch1;
-    angle2     = o_current->fill_angle2;
-    pitch2     = o_current->fill_pitch2;
-
-    switch(o_current->fill_type) {
+  if(o_current->style->fill_type != FILLING_HOLLOW) {
+    fill_width = o_current->style->fill_width;
+    angle1     = o_current->style->fill_angle1;
+    pitch1     = o_current->style->fill_pitch1;
+    angle2     = o_current->style->fill_angle2;
+    pitch2     = o_current->style->fill_pitch2;
+
+    switch(o_current->style->fill_type) {
       case FILLING_FILL:
         angle1 = -1; pitch1 = 1;
         angle2 = -1; pitch2 = 1;
@@ -1056,7 +1051,7 @@ double o_path_shortest_distance (OBJECT *object, int x, int y, int force_solid)
 {
   int solid;
 
-  solid = force_solid || object->fill_type != FILLING_HOLLOW;
+  solid = force_solid || object->style->fill_type != FILLING_HOLLOW;
 
   return s_path_shortest_distance (object->path, x, y, solid);
 }
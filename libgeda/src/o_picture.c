@@ -35,6 +35,164 @@
 
 #include "libgeda_priv.h"
 
+/*! \section picture-images Shared Picture Images
+ *
+ *  The file data of each picture is kept in a #PICTURE_IMAGE, which is
+ *  shared by all pictures with identical data, e.g. a logo embedded
+ *  in the title block of every sheet of a design.  The image is only
+ *  decoded into a #GdkPixbuf when it is first needed for drawing or
+ *  printing, so tools which never render pictures never decode them.
+ *  For drawing at a small scale, successively halved copies of the
+ *  decoded image are kept as well.
+ */
+
+/*! Smallest size, in pixels, to which an image is halved. */
+#define PICTURE_MIPMAP_MIN_SIZE 16
+
+/*! Table of all live images, keyed by their file data. */
+static GHashTable *picture_images = NULL;
+
+/*! \brief Hash the file data of a picture image. */
+static guint
+o_picture_image_hash (gconstpointer key)
+{
+  return ((const PICTURE_IMAGE *) key)->hash;
+}
+
+/*! \brief Compare the file data of two picture images. */
+static gboolean
+o_picture_image_equal (gconstpointer a, gconstpointer b)
+{
+  const PICTURE_IMAGE *ia = a;
+  const PICTURE_IMAGE *ib = b;
+
+  return (ia->hash == ib->hash &&
+          ia->file_length == ib->file_length &&
+          memcmp (ia->file_content, ib->file_content, ia->file_length) == 0);
+}
+
+/*! \brief Get the shared image for some picture file data.
+ *  \par Function Description
+ *  Returns the #PICTURE_IMAGE holding a copy of \a data, creating it
+ *  if no picture uses identical data yet.  The data is not decoded.
+ *  The caller owns a reference to the result, to be released with
+ *  o_picture_image_unref().
+ *
+ *  \param [in] data  Raw data of the image file.
+ *  \param [in] len   Length of \a data.
+ *  \return The shared image.
+ */
+static PICTURE_IMAGE *
+o_picture_image_get (const gchar *data, gsize len)
+{
+  PICTURE_IMAGE key;
+  PICTURE_IMAGE *image;
+  guint hash = 2166136261u;
+  gsize i;
+
+  /* FNV-1a */
+  for (i = 0; i < len; i++) {
+    hash = (hash ^ (guchar) data[i]) * 16777619u;
+  }
+
+  if (picture_images == NULL) {
+    picture_images = g_hash_table_new (o_picture_image_hash,
+                                       o_picture_image_equal);
+  }
+
+  key.hash = hash;
+  key.file_content = (gchar *) data;
+  key.file_length = len;
+
+  image = g_hash_table_lookup (picture_images, &key);
+  if (image != NULL) {
+    image->ref_count++;
+    return image;
+  }
+
+  image = g_new0 (PICTURE_IMAGE, 1);
+  image->ref_count = 1;
+  image->hash = hash;
+  image->file_content = g_memdup (data, len);
+  image->file_length = len;
+  g_hash_table_insert (picture_images, image, image);
+
+  return image;
+}
+
+/*! \brief Release a reference to a shared picture image.
+ *  \par Function Description
+ *  Decrements the reference count of \a image, freeing it and its
+ *  decoded pixbufs when no picture uses it any more.
+ *
+ *  \param [in] image  The image to release, or NULL.
+ */
+void
+o_picture_image_unref (PICTURE_IMAGE *image)
+{
+  if (image == NULL) return;
+
+  g_return_if_fail (image->ref_count > 0);
+
+  if (--image->ref_count > 0) return;
+
+  g_hash_table_remove (picture_images, image);
+
+  if (image->mipmaps != NULL) {
+    g_ptr_array_foreach (image->mipmaps, (GFunc) g_object_unref, NULL);
+    g_ptr_array_free (image->mipmaps, TRUE);
+  }
+  if (image->pixbuf != NULL) {
+    g_object_unref (image->pixbuf);
+  }
+  g_free (image->file_content);
+  g_free (image);
+}
+
+/*! \brief Decode the image of a picture object.
+ *  \par Function Description
+ *  Decodes the shared image of \a object if that has not been tried
+ *  yet, and updates the width/height ratio of \a object from it.
+ *  A failure is only reported the first time.
+ *
+ *  \param [in] toplevel  The current #TOPLEVEL.
+ *  \param [in] object    The picture #OBJECT.
+ *  \return The decoded image, or NULL.  No reference is added.
+ */
+static GdkPixbuf *
+o_picture_decode (TOPLEVEL *toplevel, OBJECT *object)
+{
+  PICTURE_IMAGE *image = object->picture->image;
+
+  if (image == NULL) return NULL;
+
+  if (!image->decoded) {
+    GInputStream *stream;
+    GError *error = NULL;
+
+    image->decoded = TRUE;
+
+    stream = G_INPUT_STREAM (
+      g_memory_input_stream_new_from_data (image->file_content,
+                                           image->file_length, NULL));
+    image->pixbuf = gdk_pixbuf_new_from_stream (stream, NULL, &error);
+    g_object_unref (stream);
+
+    if (image->pixbuf == NULL) {
+      s_log_message (_("Failed to load buffer image [%s]: %s\n"),
+                     object->picture->filename, error->message);
+      g_error_free (error);
+    }
+  }
+
+  if (image->pixbuf != NULL) {
+    object->picture->ratio = ((double) gdk_pixbuf_get_width (image->pixbuf) /
+                              gdk_pixbuf_get_height (image->pixbuf));
+  }
+
+  return image->pixbuf;
+}
+
 /*! \brief Create picture OBJECT from character string.
  *  \par Function Description
  *  Parses \a first_line and subsequent lines from \a tb, and returns
@@ -164,24 +322,19 @@ OBJECT *o_picture_read (TOPLEVEL *toplevel,
   return new_obj;
 }
 
-/*! \brief Create a character string representation of a picture OBJECT.
+/*! \brief Append a character string representation of a picture OBJECT.
  *  \par Function Description
- *  This function formats a string in the buffer <B>*buff</B> to describe
+ *  This function appends a string to the buffer <B>*buf</B> to describe
  *  the picture object <B>*object</B>.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  Picture OBJECT to create string from.
- *  \return A pointer to the picture OBJECT character string.
- *
- *  \note
- *  Caller must g_free returned character string.
- *
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_picture_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_picture_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int width, height, x1, y1;
   gchar *encoded_picture=NULL;
-  gchar *out=NULL;
   guint encoded_picture_length;
   const gchar *filename = NULL;
 
@@ -198,10 +351,11 @@ char *o_picture_save(TOPLEVEL *toplevel, OBJECT *object)
 #endif
 
   /* Encode the picture if it's embedded */
-  if (o_picture_is_embedded (toplevel, object)) {
+  if (o_picture_is_embedded (toplevel, object) &&
+      object->picture->image != NULL) {
     encoded_picture =
-      s_encoding_base64_encode( (char *)object->picture->file_content,
-                                object->picture->file_length,
+      s_encoding_base64_encode( object->picture->image->file_content,
+                                object->picture->image->file_length,
                                 &encoded_picture_length,
                                 TRUE);
     if (encoded_picture == NULL) {
@@ -213,32 +367,21 @@ char *o_picture_save(TOPLEVEL *toplevel, OBJECT *object)
   filename = o_picture_get_filename (toplevel, object);
   if (filename == NULL) filename = "";
 
-  if (o_picture_is_embedded (toplevel, object) &&
-      encoded_picture != NULL) {
-    out = g_strdup_printf("%c %d %d %d %d %d %c %c\n%s\n%s\n%s", 
-			  object->type,
-			  x1, y1, width, height,
-			  object->picture->angle,
-			  /* Convert the (0,1) chars to ASCII */
-			  (object->picture->mirrored)+0x30, 
-			  '1', 
-			  filename,
-			  encoded_picture,
-			  ".");
-  }
-  else {
-    out = g_strdup_printf("%c %d %d %d %d %d %c %c\n%s", 
-			  object->type,
-			  x1, y1, width, height,
-			  object->picture->angle,
-			  /* Convert the (0,1) chars to ASCII */
-			  (object->picture->mirrored)+0x30, 
-			  '0', 
-			  filename);
+  g_string_append_printf(buf, "%c %d %d %d %d %d %c %c\n",
+                         object->type,
+                         x1, y1, width, height,
+                         object->picture->angle,
+                         /* Convert the (0,1) chars to ASCII */
+                         (object->picture->mirrored)+0x30,
+                         encoded_picture != NULL ? '1' : '0');
+  g_string_append(buf, filename);
+
+  if (encoded_picture != NULL) {
+    g_string_append_c(buf, '\n');
+    g_string_append(buf, encoded_picture);
+    g_string_append(buf, "\n.");
   }
   g_free(encoded_picture);
-
-  return(out);
 }
 
 
@@ -251,10 +394,11 @@ char *o_picture_save(TOPLEVEL *toplevel, OBJECT *object)
  *  must be equal to #OBJ_PICTURE.
  *
  *  If \a file_content is non-NULL, it must be a pointer to a buffer
- *  containing raw image data.  If loading data from \a file_content
- *  is unsuccessful, and \a filename is non-NULL, an image will
- *  attempt to be loaded from \a filename.  Otherwise, the picture
- *  object will be initially empty.
+ *  containing raw image data.  Otherwise, if \a filename is non-NULL,
+ *  the image data is read from \a filename, and if that fails the
+ *  picture object will be initially empty.  The data is shared with
+ *  other pictures with identical data, and only decoded when the
+ *  picture is first drawn.
  *
  *  \param [in]     toplevel      The TOPLEVEL object.
  *  \param [in]     file_content  Raw data of the image file, or NULL.
@@ -282,8 +426,7 @@ OBJECT *o_picture_new (TOPLEVEL *toplevel,
   /* create the object */
   new_node = s_basic_new_object(type, "picture");
 
-  picture = (PICTURE *) g_malloc0 (sizeof(PICTURE));
-  new_node->picture = picture;
+  picture = new_node->picture;
 
   /* describe the picture with its upper left and lower right corner */
   picture->upper_x = (x1 > x2) ? x2 : x1;
@@ -291,9 +434,7 @@ OBJECT *o_picture_new (TOPLEVEL *toplevel,
   picture->lower_x = (x1 > x2) ? x1 : x2;
   picture->lower_y = (y1 > y2) ? y2 : y1;
 
-  picture->pixbuf = NULL;
-  picture->file_content = NULL;
-  picture->file_length = 0;
+  picture->image = NULL;
 
   picture->ratio = abs ((double) (x1 - x2) / (y1 - y2));
   picture->filename = g_strdup (filename);
@@ -302,22 +443,16 @@ OBJECT *o_picture_new (TOPLEVEL *toplevel,
   picture->embedded = embedded;
 
   if (file_content != NULL) {
+    picture->image = o_picture_image_get (file_content, file_length);
+  } else if (filename != NULL) {
     GError *error = NULL;
-    if (!o_picture_set_from_buffer (toplevel, new_node, filename,
-                                    file_content, file_length, &error)) {
-      s_log_message (_("Failed to load buffer image [%s]: %s\n"),
-                     filename, error->message);
-      g_error_free (error);
+    gchar *buf;
+    gsize len;
 
-      /* Force the data into the object anyway, so as to prevent data
-       * loss of embedded images. */
-      picture->file_content = g_memdup (file_content, file_length);
-      picture->file_length = file_length;
-    }
-  }
-  if (picture->pixbuf == NULL && filename != NULL) {
-    GError *error = NULL;
-    if (!o_picture_set_from_file (toplevel, new_node, filename, &error)) {
+    if (g_file_get_contents (filename, &buf, &len, &error)) {
+      picture->image = o_picture_image_get (buf, len);
+      g_free (buf);
+    } else {
       s_log_message (_("Failed to load image from [%s]: %s\n"),
                      filename, error->message);
       g_error_free (error);
@@ -354,6 +489,7 @@ void o_picture_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right  = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief Get picture bounding rectangle in WORLD coordinates.
@@ -414,6 +550,9 @@ o_picture_get_ratio (TOPLEVEL *toplevel, OBJECT *object)
   g_return_val_if_fail (object != NULL, 1);
   g_return_val_if_fail (object->picture != NULL, 1);
 
+  /* The ratio of the image itself is known once it is decoded. */
+  o_picture_decode (toplevel, object);
+
   /* The effective ratio varies depending on the rotation of the
    * image. */
   switch (object->picture->angle) {
@@ -719,8 +858,7 @@ OBJECT *o_picture_copy(TOPLEVEL *toplevel, OBJECT *object)
   /* create the object */
   new_node = s_basic_new_object(object->type, "picture");
 
-  picture = g_malloc(sizeof(PICTURE));
-  new_node->picture = picture;
+  picture = new_node->picture;
 
   new_node->color = object->color;
   new_node->selectable = object->selectable;
@@ -731,23 +869,18 @@ OBJECT *o_picture_copy(TOPLEVEL *toplevel, OBJECT *object)
   picture->lower_x = object->picture->lower_x;
   picture->lower_y = object->picture->lower_y;
 
-  if (object->picture->file_content != NULL) {
-    picture->file_content = g_memdup (object->picture->file_content,
-                                      object->picture->file_length);
-  } else {
-    picture->file_content = NULL;
+  /* Share the image data */
+  picture->image = object->picture->image;
+  if (picture->image != NULL) {
+    picture->image->ref_count++;
   }
 
-  picture->file_length = object->picture->file_length;
   picture->filename    = g_strdup (object->picture->filename);
   picture->ratio       = object->picture->ratio;
   picture->angle       = object->picture->angle;
   picture->mirrored    = object->picture->mirrored;
   picture->embedded    = object->picture->embedded;
 
-  /* Get the picture data */
-  picture->pixbuf = o_picture_get_pixbuf (toplevel, object);
-
   /* compute the bounding picture */
   o_picture_recalc(toplevel, new_node);
 
@@ -953,7 +1086,7 @@ void o_picture_embed (TOPLEVEL *toplevel, OBJECT *object)
 
   if (o_picture_is_embedded (toplevel, object)) return;
 
-  if (object->picture->file_content == NULL) {
+  if (object->picture->image == NULL) {
     s_log_message (_("Picture [%s] has no image data.\n"), filename);
     s_log_message (_("Falling back to file loading. Picture is still unembedded.\n"));
     object->picture->embedded = 0;
@@ -1069,16 +1202,75 @@ o_picture_is_embedded (TOPLEVEL *toplevel, OBJECT *object)
 GdkPixbuf *
 o_picture_get_pixbuf (TOPLEVEL *toplevel, OBJECT *object)
 {
+  GdkPixbuf *pixbuf;
+
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->picture != NULL, NULL);
 
-  if (object->picture->pixbuf != NULL) {
-    return g_object_ref (object->picture->pixbuf);
+  pixbuf = o_picture_decode (toplevel, object);
+  if (pixbuf != NULL) {
+    return g_object_ref (pixbuf);
   } else {
     return NULL;
   }
 }
 
+/*! \brief Get a pixel buffer for drawing a picture at a given size.
+ * \par Function Description
+ * Like o_picture_get_pixbuf(), but when the picture is drawn much
+ * smaller than its image, returns a downscaled copy of the image
+ * which is still at least \a width by \a height pixels.  The copies
+ * are made on demand and shared by all pictures with the same image.
+ *
+ * The returned value should have its reference count decremented with
+ * g_object_unref() when no longer needed.
+ *
+ * \param toplevel  The current #TOPLEVEL.
+ * \param object    The picture #OBJECT to inspect.
+ * \param width     Width the image will be drawn at, in pixels.
+ * \param height    Height the image will be drawn at, in pixels.
+ * \return A #GdkPixbuf for the picture.
+ */
+GdkPixbuf *
+o_picture_get_pixbuf_for_size (TOPLEVEL *toplevel, OBJECT *object,
+                               int width, int height)
+{
+  PICTURE_IMAGE *image;
+  GdkPixbuf *pixbuf;
+  guint level;
+
+  g_return_val_if_fail (object != NULL, NULL);
+  g_return_val_if_fail (object->picture != NULL, NULL);
+
+  pixbuf = o_picture_decode (toplevel, object);
+  if (pixbuf == NULL) return NULL;
+
+  image = object->picture->image;
+  width = MAX (width, PICTURE_MIPMAP_MIN_SIZE);
+  height = MAX (height, PICTURE_MIPMAP_MIN_SIZE);
+
+  for (level = 0; ; level++) {
+    int half_width = gdk_pixbuf_get_width (pixbuf) / 2;
+    int half_height = gdk_pixbuf_get_height (pixbuf) / 2;
+
+    /* Stop at the smallest copy which is still large enough */
+    if (half_width < width || half_height < height) break;
+
+    if (image->mipmaps == NULL) {
+      image->mipmaps = g_ptr_array_new ();
+    }
+    if (level == image->mipmaps->len) {
+      g_ptr_array_add (image->mipmaps,
+                       gdk_pixbuf_scale_simple (pixbuf, half_width,
+                                                half_height,
+                                                GDK_INTERP_BILINEAR));
+    }
+    pixbuf = g_ptr_array_index (image->mipmaps, level);
+  }
+
+  return g_object_ref (pixbuf);
+}
+
 /*! \brief Get the raw image data from a picture object.
  * \par Function Description
  * Returns the raw image file data underlying the picture \a object,
@@ -1096,8 +1288,13 @@ o_picture_get_data (TOPLEVEL *toplevel, OBJECT *object,
   g_return_val_if_fail (object != NULL, NULL);
   g_return_val_if_fail (object->picture != NULL, NULL);
 
-  *len = object->picture->file_length;
-  return object->picture->file_content;
+  if (object->picture->image == NULL) {
+    *len = 0;
+    return NULL;
+  }
+
+  *len = object->picture->image->file_length;
+  return object->picture->image->file_content;
 }
 
 /*! \brief Set a picture object's contents from a buffer.
@@ -1121,6 +1318,7 @@ o_picture_set_from_buffer (TOPLEVEL *toplevel, OBJECT *object,
 {
   GdkPixbuf *pixbuf;
   GInputStream *stream;
+  PICTURE_IMAGE *image;
   gchar *tmp;
 
   g_return_val_if_fail (toplevel != NULL, FALSE);
@@ -1135,28 +1333,27 @@ o_picture_set_from_buffer (TOPLEVEL *toplevel, OBJECT *object,
   g_object_unref (stream);
   if (pixbuf == NULL) return FALSE;
 
+  /* The data may belong to the current image of the object, so get
+   * the new image before releasing the old one. */
+  image = o_picture_image_get (data, len);
+  if (!image->decoded) {
+    image->decoded = TRUE;
+    image->pixbuf = g_object_ref (pixbuf);
+  }
+
   o_emit_pre_change_notify (toplevel, object);
 
-  if (object->picture->pixbuf != NULL) {
-    g_object_unref (object->picture->pixbuf);
-  }
-  object->picture->pixbuf = pixbuf;
+  o_picture_image_unref (object->picture->image);
+  object->picture->image = image;
 
   object->picture->ratio = ((double) gdk_pixbuf_get_width(pixbuf) /
                             gdk_pixbuf_get_height(pixbuf));
+  g_object_unref (pixbuf);
 
   tmp = g_strdup (filename);
   g_free (object->picture->filename);
   object->picture->filename = tmp;
 
-  gchar *buf = g_realloc (object->picture->file_content,
-                          len);
-  /* It's possible that these buffers might overlap, because the
-   * library user hates us. */
-  memmove (buf, data, len);
-  object->picture->file_content = buf;
-  object->picture->file_length = len;
-
   o_emit_change_notify (toplevel, object);
   return TRUE;
 }
@@ -91,7 +91,6 @@ OBJECT *o_pin_new(TOPLEVEL *toplevel,
   new_node = s_basic_new_object(type, "pin");
   new_node->color = color;
 
-  new_node->line = (LINE *) g_malloc(sizeof(LINE));
 
   new_node->line->x[0] = x1;
   new_node->line->y[0] = y1;
@@ -130,6 +129,7 @@ void o_pin_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief read a pin object from a char buffer
@@ -195,20 +195,19 @@ OBJECT *o_pin_read (TOPLEVEL *toplevel, const char buf[],
   return new_obj;
 }
 
-/*! \brief Create a string representation of the pin object
+/*! \brief Append a string representation of the pin object
  *  \par Function Description
- *  This function takes a pin \a object and return a string
- *  according to the file format definition.
+ *  This function takes a pin \a object and appends a string
+ *  according to the file format definition to \a buf.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  a pin OBJECT
- *  \return the string representation of the pin OBJECT
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_pin_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_pin_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x1, x2, y1, y2;
   int pin_type, whichend;
-  char *buf;
   
   x1 = object->line->x[0];
   y1 = object->line->y[0];
@@ -218,9 +217,8 @@ char *o_pin_save(TOPLEVEL *toplevel, OBJECT *object)
   pin_type = object->pin_type;
   whichend = object->whichend;
   
-  buf = g_strdup_printf("%c %d %d %d %d %d %d %d", object->type,
-		   x1, y1, x2, y2, object->color, pin_type, whichend);
-  return(buf);
+  g_string_append_printf(buf, "%c %d %d %d %d %d %d %d", object->type,
+                         x1, y1, x2, y2, object->color, pin_type, whichend);
 }
 
 /*! \brief move a pin object
@@ -297,7 +295,7 @@ void o_pin_print(TOPLEVEL *toplevel, FILE *fp, OBJECT *o_current,
   y2 = o_current->line->y[1] - origin_y;
   pin_width = 2;
   if(toplevel->pin_style == THICK) {
-    pin_width = o_current->line_width;
+    pin_width = o_current->style->line_width;
   }
 
   fprintf(fp, "%d %d %d %d %d %d line\n",x1,y1,x2,y2,pin_width,toplevel->print_output_capstyle);
@@ -565,11 +563,11 @@ void o_pin_set_type (TOPLEVEL *toplevel, OBJECT *o_current, int pin_type)
       g_critical ("o_pin_set_type: Got invalid pin type %i\n", pin_type);
       /* Fall through */
     case PIN_TYPE_NET:
-      o_current->line_width = PIN_WIDTH_NET;
+      s_style_set_line_width (o_current, PIN_WIDTH_NET);
       o_current->pin_type = PIN_TYPE_NET;
       break;
     case PIN_TYPE_BUS:
-      o_current->line_width = PIN_WIDTH_BUS;
+      s_style_set_line_width (o_current, PIN_WIDTH_BUS);
       o_current->pin_type = PIN_TYPE_BUS;
       break;
   }
@@ -118,7 +118,7 @@ void o_selection_select(TOPLEVEL *toplevel, OBJECT *object)
 
   o_emit_pre_change_notify (toplevel, object);
   object->selected = TRUE;
-  o_emit_change_notify (toplevel, object);
+  o_emit_display_change_notify (toplevel, object);
 }
 
 /*! \brief Unselects the given object.
@@ -136,6 +136,6 @@ void o_selection_unselect (TOPLEVEL *toplevel, OBJECT *object)
 
   o_emit_pre_change_notify (toplevel, object);
   object->selected = FALSE;
-  o_emit_change_notify (toplevel, object);
+  o_emit_display_change_notify (toplevel, object);
 }
 
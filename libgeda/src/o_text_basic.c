@@ -262,7 +262,7 @@ OBJECT *o_text_new(TOPLEVEL *toplevel,
 
   new_node = s_basic_new_object(type, "text");
 
-  text = (TEXT *) g_malloc(sizeof(TEXT));
+  text = new_node->text;
 
   text->string = g_strdup (string);
   text->disp_string = NULL; /* We'll fix this up later */
@@ -273,7 +273,7 @@ OBJECT *o_text_new(TOPLEVEL *toplevel,
   text->y = y;
   text->angle = angle;
 
-  new_node->text = text;
+  o_attrib_update_name_value (new_node);
 
   new_node->color = color;
   o_set_visibility (toplevel, new_node, visibility);
@@ -311,6 +311,7 @@ void o_text_recalc(TOPLEVEL *toplevel, OBJECT *o_current)
   o_current->w_right = right;
   o_current->w_bottom = bottom;
   o_current->w_bounds_valid = TRUE;
+  o_touch_object (o_current);
 }
 
 /*! \brief read a text object from a char buffer
@@ -473,21 +474,20 @@ OBJECT *o_text_read (TOPLEVEL *toplevel,
 }
 
 
-/*! \brief Create a string representation of the text object
+/*! \brief Append a string representation of the text object
  *  \par Function Description
- *  This function takes a text \a object and return a string
- *  according to the file format definition.
+ *  This function takes a text \a object and appends a string
+ *  according to the file format definition to \a buf.
  *
  *  \param [in] toplevel  a TOPLEVEL structure
  *  \param [in] object  a text OBJECT
- *  \return the string representation of the text OBJECT
+ *  \param [in,out] buf  The GString to append to.
  */
-char *o_text_save(TOPLEVEL *toplevel, OBJECT *object)
+void o_text_save(TOPLEVEL *toplevel, OBJECT *object, GString *buf)
 {
   int x, y;
   int size;
   char *string;
-  char *buf;
   int num_lines;
 
   x = object->text->x;
@@ -499,13 +499,12 @@ char *o_text_save(TOPLEVEL *toplevel, OBJECT *object)
   /* string can have multiple lines (seperated by \n's) */
   num_lines = o_text_num_lines(string);
 
-  buf = g_strdup_printf ("%c %d %d %d %d %d %d %d %d %d\n%s", object->type,
-                         x, y, object->color, size,
-                         o_is_visible (toplevel, object) ? VISIBLE : INVISIBLE,
-                         object->show_name_value, object->text->angle,
-                         object->text->alignment, num_lines, string);
-
-  return(buf);
+  g_string_append_printf (buf, "%c %d %d %d %d %d %d %d %d %d\n", object->type,
+                          x, y, object->color, size,
+                          o_is_visible (toplevel, object) ? VISIBLE : INVISIBLE,
+                          object->show_name_value, object->text->angle,
+                          object->text->alignment, num_lines);
+  g_string_append (buf, string);
 }
 
 /*! \brief recreate the graphics of a text object
@@ -520,7 +519,7 @@ void o_text_recreate(TOPLEVEL *toplevel, OBJECT *o_current)
 {
   o_emit_pre_change_notify (toplevel, o_current);
   update_disp_string (o_current);
-  o_current->w_bounds_valid = FALSE;
+  o_bounds_invalidate (toplevel, o_current);
   o_emit_change_notify (toplevel, o_current);
 }
 
@@ -541,6 +540,7 @@ void o_text_translate_world(TOPLEVEL *toplevel,
 
   /* Update bounding box */
   o_current->w_bounds_valid = FALSE;
+  o_touch_object (o_current);
 }
 
 /*! \brief create a copy of a text object
@@ -969,6 +969,7 @@ void o_text_set_string (TOPLEVEL *toplevel, OBJECT *obj,
 
   g_free (obj->text->string);
   obj->text->string = g_strdup (new_string);
+  o_attrib_update_name_value (obj);
 
   o_text_recreate (toplevel, obj);
 
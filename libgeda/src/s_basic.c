@@ -47,13 +47,68 @@
 /*! this is modified here and in o_list.c */
 int global_sid=0;
 
+/*! \brief An OBJECT allocated together with its geometry
+ *
+ *  s_basic_new_object() allocates each OBJECT in one block with the
+ *  LINE, BOX, TEXT, ... structure its type needs, cut from GLib's slice
+ *  allocator. Objects of a type share a block size, so they are carved
+ *  from the same slabs, and an object costs one allocation instead of
+ *  two. Only the part of the union the type uses is allocated.
+ */
+typedef struct st_object_block OBJECT_BLOCK;
+
+struct st_object_block {
+  OBJECT object;
+  union {
+    LINE line;
+    BOX box;
+    CIRCLE circle;
+    ARC arc;
+    TEXT text;
+    COMPLEX complex;
+    PICTURE picture;
+  } payload;
+};
+
+/*! \brief Get the size of the block holding an OBJECT
+ *  \par Function Description
+ *  Returns the size of the OBJECT_BLOCK allocated for objects of
+ *  \a type: the OBJECT followed by the structure for its geometry.
+ *  Paths keep their PATH separately, as it is built by s_path_parse().
+ *
+ *  \param [in] type  The object type; one of the OBJ_* constants.
+ *  \return The size of the block in bytes.
+ */
+static gsize s_basic_block_size (int type)
+{
+  gsize payload;
+
+  switch (type) {
+    case OBJ_LINE:
+    case OBJ_NET:
+    case OBJ_BUS:
+    case OBJ_PIN:         payload = sizeof (LINE);    break;
+    case OBJ_BOX:         payload = sizeof (BOX);     break;
+    case OBJ_CIRCLE:      payload = sizeof (CIRCLE);  break;
+    case OBJ_ARC:         payload = sizeof (ARC);     break;
+    case OBJ_TEXT:        payload = sizeof (TEXT);    break;
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER: payload = sizeof (COMPLEX); break;
+    case OBJ_PICTURE:     payload = sizeof (PICTURE); break;
+    default:              payload = 0;                break;
+  }
+
+  return G_STRUCT_OFFSET (OBJECT_BLOCK, payload) + payload;
+}
+
 /*! \brief Initialize an already-allocated object.
  *  \par Function Description
  *  Initializes the members of the OBJECT structure.
  *
  *  \param [in] new_node  A pointer to an allocated OBJECT
  *  \param [in] type      The object type; one of the OBJ_* constants.
- *  \param [in] name      A prefix for the object's session-unique name.
+ *  \param [in] name      Unused; the object's name is derived from its
+ *                        type and sid on demand by o_get_name().
  *  \return A pointer to the initialized object.
  */
 OBJECT *s_basic_init_object(OBJECT *new_node, int type, char const *name)
@@ -62,8 +117,8 @@ OBJECT *s_basic_init_object(OBJECT *new_node, int type, char const *name)
   new_node->sid = global_sid++;
   new_node->type = type;
 
-  /* Setup the name */
-  new_node->name = g_strdup_printf("%s.%d", name, new_node->sid);
+  /* The name is formatted lazily by o_get_name() */
+  new_node->name = NULL;
 
   /* Don't associate with a page, initially */
   new_node->page = NULL;
@@ -87,7 +142,7 @@ OBJECT *s_basic_init_object(OBJECT *new_node, int type, char const *name)
 
   new_node->tiles = NULL;
 
-  new_node->conn_list = NULL;
+  new_node->conns = NULL;
 
   new_node->complex_basename = NULL;
   new_node->parent = NULL;
@@ -101,16 +156,9 @@ OBJECT *s_basic_init_object(OBJECT *new_node, int type, char const *name)
 
   new_node->bus_ripper_direction = 0;
 
-  new_node->line_end = END_NONE;
-  new_node->line_type = TYPE_SOLID;
-  new_node->line_width = 0;
-  new_node->line_space = 0;
-  new_node->line_length = 0;
-  new_node->fill_width = 0;
-  new_node->fill_angle1 = 0;
-  new_node->fill_angle2 = 0;
-  new_node->fill_pitch1 = 0;
-  new_node->fill_pitch2 = 0;
+  new_node->style = s_style_default ();
+  new_node->hatch_lines = NULL;
+  new_node->hatch_style = NULL;
 	
   new_node->attribs = NULL;
   new_node->attached_to = NULL;
@@ -140,14 +188,34 @@ OBJECT *s_basic_init_object(OBJECT *new_node, int type, char const *name)
  *
  *  \par Function Description
  *  Allocates memory for an OBJECT and then calls s_basic_init_object() on it.
+ *  The zeroed structure for the geometry of \a type is allocated in the
+ *  same block, and the matching member of the OBJECT points to it.
+ *  The object must be freed with s_delete_object().
  *
  *  \param [in] type      The sub-type of the object to create; one of the OBJ_* constants.
- *  \param [in] prefix    The name prefix for the session-unique object name.
+ *  \param [in] prefix    Unused; see o_get_name().
  *  \return A pointer to the fully constructed OBJECT.
  */
 OBJECT *s_basic_new_object(int type, char const *prefix)
 {
-  return s_basic_init_object(g_malloc(sizeof (OBJECT)), type, prefix);
+  OBJECT_BLOCK *block = g_slice_alloc0 (s_basic_block_size (type));
+  OBJECT *new_node = s_basic_init_object (&block->object, type, prefix);
+
+  switch (type) {
+    case OBJ_LINE:
+    case OBJ_NET:
+    case OBJ_BUS:
+    case OBJ_PIN:         new_node->line    = &block->payload.line;    break;
+    case OBJ_BOX:         new_node->box     = &block->payload.box;     break;
+    case OBJ_CIRCLE:      new_node->circle  = &block->payload.circle;  break;
+    case OBJ_ARC:         new_node->arc     = &block->payload.arc;     break;
+    case OBJ_TEXT:        new_node->text    = &block->payload.text;    break;
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER: new_node->complex = &block->payload.complex; break;
+    case OBJ_PICTURE:     new_node->picture = &block->payload.picture; break;
+  }
+
+  return new_node;
 }
 
 
@@ -165,7 +233,7 @@ void print_struct_forw (GList *list)
   printf("TRYING to PRINT\n");
   while (iter != NULL) {
     o_current = (OBJECT *)iter->data;
-    printf("Name: %s\n", o_current->name);
+    printf("Name: %s\n", o_get_name (o_current));
     printf("Type: %d\n", o_current->type);
     printf("Sid: %d\n", o_current->sid);
 
@@ -192,7 +260,7 @@ void print_struct(OBJECT *ptr)
   o_current = ptr;
 
   if (o_current != NULL) {
-    printf("Name: %s\n", o_current->name);
+    printf("Name: %s\n", o_get_name (o_current));
     printf("Type: %d\n", o_current->type);
     printf("Sid: %d\n", o_current->sid);
     if (o_current->line != NULL) {
@@ -224,6 +292,10 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
 
     s_conn_remove_object (toplevel, o_current);
 
+    if (o_current->tiles != NULL)
+      g_ptr_array_free (o_current->tiles, TRUE);
+    o_current->tiles = NULL;
+
     if (o_current->attached_to != NULL) {
       /* do the actual remove */
       o_attrib_remove(toplevel, &o_current->attached_to->attribs, o_current);
@@ -235,10 +307,15 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
     o_attrib_freeze_hooks (toplevel, o_current);
     o_attrib_detach_all (toplevel, o_current);
 
-    if (o_current->line) {
-      /*	printf("sdeleting line\n");*/
-      g_free(o_current->line);
+    o_change_notify_forget (toplevel, o_current);
+
+    /* Don't leave the parent growing its bounds by a dead object */
+    if (o_current->parent != NULL && o_current->parent->complex != NULL) {
+      o_current->parent->complex->changed_prims =
+        g_list_remove (o_current->parent->complex->changed_prims, o_current);
     }
+
+    /* the geometry lives in the block of the object itself */
     o_current->line = NULL;
 
     if (o_current->path) {
@@ -246,27 +323,16 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
     }
     o_current->path = NULL;
 
-    /*	printf("sdeleting circle\n");*/
-    g_free(o_current->circle);
     o_current->circle = NULL;
-
-    /*	printf("sdeleting arc\n");*/
-    g_free(o_current->arc);
     o_current->arc = NULL;
-
-    /*	printf("sdeleting box\n");*/
-    g_free(o_current->box);
     o_current->box = NULL;
 
     if (o_current->picture) {
       /*	printf("sdeleting picture\n");*/
 
-      g_free(o_current->picture->file_content);
-      if (o_current->picture->pixbuf)
-        g_object_unref (o_current->picture->pixbuf);
+      o_picture_image_unref (o_current->picture->image);
 
       g_free(o_current->picture->filename);
-      g_free(o_current->picture);
     }
     o_current->picture = NULL;
 
@@ -275,8 +341,6 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
       g_free(o_current->text->string); 
       o_current->text->string = NULL;
       g_free(o_current->text->disp_string);
-      /*	printf("sdeleting text\n");*/
-      g_free(o_current->text);
     }
     o_current->text = NULL;
 
@@ -284,6 +348,10 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
     g_free(o_current->name);
     o_current->name = NULL;
 
+    if (o_current->hatch_lines != NULL)
+      g_array_free (o_current->hatch_lines, TRUE);
+    o_current->hatch_lines = NULL;
+
 
     /*	printf("sdeleting complex_basename\n");*/
     g_free(o_current->complex_basename); 
@@ -291,19 +359,21 @@ s_delete_object(TOPLEVEL *toplevel, OBJECT *o_current)
 
     if (o_current->complex) {
 
+      g_list_free (o_current->complex->changed_prims);
+      o_current->complex->changed_prims = NULL;
+
       if (o_current->complex->prim_objs) {
         /* printf("sdeleting complex->primitive_objects\n");*/
         s_delete_object_glist (toplevel, o_current->complex->prim_objs);
         o_current->complex->prim_objs = NULL;
       }
 
-      g_free(o_current->complex);
       o_current->complex = NULL;
     }
 
     s_weakref_notify (o_current, o_current->weak_refs);
 
-    g_free(o_current);	/* assuming it is not null */
+    g_slice_free1 (s_basic_block_size (o_current->type), o_current);
 
     o_current=NULL;		/* misc clean up */
   }
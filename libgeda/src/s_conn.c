@@ -49,58 +49,27 @@
  */
 
 
-/*! \brief create a new connection object
- *  \par Function Description
- *  create a single st_conn object and initialize it with the 
- *  given parameters.
- *  
- *  \return The new connection object
- */
-CONN *s_conn_return_new(OBJECT * other_object, int type, int x, int y,
-			int whichone, int other_whichone)
-{
-  CONN *new_conn;
-
-  new_conn = (CONN *) g_malloc(sizeof(CONN));
-
-#if DEBUG
-  printf("** creating: %s %d %d\n", other_object->name, x, y);
-#endif
-
-  new_conn->other_object = other_object;
-  new_conn->type = type;
-  new_conn->x = x;
-  new_conn->y = y;
-  new_conn->whichone = whichone;
-  new_conn->other_whichone = other_whichone;
-
-  return (new_conn);
-}
-
 /*! \brief check if a connection is uniq in a list
  *  \par Function Description
  *  This function checks if there's no identical connection
- *  in the list of connections.
- *  \param conn_list list of connection objects
+ *  in the array of connections.
+ *  \param conns array of connections, or NULL
  *  \param input_conn single connection object.
  *  \return TRUE if the CONN structure is unique, FALSE otherwise.
  */
-int s_conn_uniq(GList * conn_list, CONN * input_conn)
+int s_conn_uniq(GArray * conns, CONN * input_conn)
 {
-  GList *c_current;
   CONN *conn;
+  guint i;
 
-  c_current = conn_list;
-  while (c_current != NULL) {
-    conn = (CONN *) c_current->data;
+  for (i = 0; conns != NULL && i < conns->len; i++) {
+    conn = &g_array_index (conns, CONN, i);
 
     if (conn->other_object == input_conn->other_object &&
         conn->x == input_conn->x && conn->y == input_conn->y &&
         conn->type == input_conn->type) {
       return (FALSE);
     }
-
-    c_current = g_list_next(c_current);
   }
 
   return (TRUE);
@@ -118,35 +87,34 @@ int s_conn_uniq(GList * conn_list, CONN * input_conn)
 int s_conn_remove_other (TOPLEVEL *toplevel, OBJECT *other_object,
                          OBJECT *to_remove)
 {
-    GList *c_current = NULL;
     CONN *conn = NULL;
+    guint i;
 
     o_emit_pre_change_notify (toplevel, other_object);
 
-    c_current = other_object->conn_list;
-    while (c_current != NULL) {
-	conn = (CONN *) c_current->data;
+    for (i = 0; other_object->conns != NULL &&
+                i < other_object->conns->len; i++) {
+	conn = &g_array_index (other_object->conns, CONN, i);
 
 	if (conn->other_object == to_remove) {
-	    other_object->conn_list =
-		g_list_remove(other_object->conn_list, conn);
 
 #if DEBUG
 	    printf("Found other_object in remove_other\n");
-	    printf("Freeing other: %s %d %d\n", conn->other_object->name,
+	    printf("Freeing other: %s %d %d\n", o_get_name (conn->other_object),
 		   conn->x, conn->y);
 #endif
 
-	    /* Do not write modify c_current like this, since this will cause */
-	    /* very nasty data corruption and upset glib's memory slice */
-	    /* allocator. */
-	    /* c_current->data = NULL;   Do not comment in */
+	    /* Keep the order, traversals depend on it */
+	    g_array_remove_index (other_object->conns, i);
 
-	    g_free(conn);
+	    if (other_object->conns->len == 0) {
+	      g_array_free (other_object->conns, TRUE);
+	      other_object->conns = NULL;
+	    }
 
 #if 0 /* this does not work right */
             if (other_object->type == OBJ_BUS &&
-                other_object->conn_list == NULL) {
+                other_object->conns == NULL) {
               other_object->bus_ripper_direction = 0;
             }
 #endif
@@ -154,11 +122,9 @@ int s_conn_remove_other (TOPLEVEL *toplevel, OBJECT *other_object,
             
 	    return (TRUE);
 	}
-
-	c_current = g_list_next(c_current);
     }
 
-    o_emit_change_notify (toplevel, other_object);
+    o_emit_display_change_notify (toplevel, other_object);
 
     return (FALSE);
 }
@@ -192,31 +158,27 @@ static void s_conn_remove_glist (TOPLEVEL *toplevel, GList *obj_list)
  */
 void s_conn_remove_object (TOPLEVEL *toplevel, OBJECT *to_remove)
 {
-  GList *c_iter;
-  CONN *conn;
+  OBJECT *other_object;
+  guint i;
 
   switch (to_remove->type) {
     case OBJ_PIN:
     case OBJ_NET:
     case OBJ_BUS:
-      for (c_iter = to_remove->conn_list;
-           c_iter != NULL;
-           c_iter = g_list_next (c_iter)) {
-        conn = c_iter->data;
-
+      for (i = 0; to_remove->conns != NULL && i < to_remove->conns->len; i++) {
+        other_object = g_array_index (to_remove->conns, CONN, i).other_object;
 
-        s_conn_freeze_hooks (toplevel, conn->other_object);
+        s_conn_freeze_hooks (toplevel, other_object);
         /* keep calling this till it returns false (all refs removed) */
         /* there is NO body to this while loop */
-        while (s_conn_remove_other (toplevel, conn->other_object, to_remove));
+        while (s_conn_remove_other (toplevel, other_object, to_remove));
 
-        c_iter->data = NULL;
-        s_conn_thaw_hooks (toplevel, conn->other_object);
-        g_free (conn);
+        s_conn_thaw_hooks (toplevel, other_object);
       }
 
-      g_list_free (to_remove->conn_list);
-      to_remove->conn_list = NULL;
+      if (to_remove->conns != NULL)
+        g_array_free (to_remove->conns, TRUE);
+      to_remove->conns = NULL;
       break;
 
     case OBJ_COMPLEX:
@@ -338,16 +300,134 @@ static void add_connection (TOPLEVEL *toplevel,
                             int type, int x, int y,
                             int whichone, int other_whichone)
 {
+  CONN new_conn;
+
   /* Describe the connection */
-  CONN *new_conn = s_conn_return_new (other_object, type, x, y,
-                                      whichone, other_whichone);
+  new_conn.other_object = other_object;
+  new_conn.type = type;
+  new_conn.x = x;
+  new_conn.y = y;
+  new_conn.whichone = whichone;
+  new_conn.other_whichone = other_whichone;
+
   /* Do uniqness check */
-  if (s_conn_uniq (object->conn_list, new_conn)) {
-    object->conn_list = g_list_append (object->conn_list, new_conn);
+  if (s_conn_uniq (object->conns, &new_conn)) {
+    if (object->conns == NULL)
+      object->conns = g_array_sized_new (FALSE, FALSE, sizeof (CONN), 2);
+    g_array_append_val (object->conns, new_conn);
     s_conn_emit_conns_changed (toplevel, object);
     s_conn_emit_conns_changed (toplevel, other_object);
-  } else {
-    g_free (new_conn);
+  }
+}
+
+/*! \brief connect two line OBJECTs which touch each other
+ *  \par Function Description
+ *  This function checks the endpoints of <b>object</b> and
+ *  <b>other_object</b> against each other and against the midpoints
+ *  of the other OBJECT, and adds connections in both directions for
+ *  every contact found.
+ *  \param toplevel (currently not used)
+ *  \param object first net, pin or bus OBJECT
+ *  \param other_object second net, pin or bus OBJECT
+ */
+static void s_conn_connect_pair (TOPLEVEL *toplevel,
+                                 OBJECT *object, OBJECT *other_object)
+{
+  OBJECT *found;
+  int j, k;
+
+  /* Here is where you check the end points */
+  /* Check both end points of the other object */
+  for (k = 0; k < 2; k++) {
+
+    /* If the other object is a pin, only check the correct end */
+    if (other_object->type == OBJ_PIN && other_object->whichend != k)
+      continue;
+
+    /* Check both end points of the object */
+    for (j = 0; j < 2; j++) {
+
+      /* If the object is a pin, only check the correct end */
+      if (object->type == OBJ_PIN && object->whichend != j)
+        continue;
+
+      /* Check for coincidence and compatability between
+         the objects being tested. */
+      if (object->line->x[j] == other_object->line->x[k] &&
+          object->line->y[j] == other_object->line->y[k] &&
+          check_direct_compat (object, other_object)) {
+
+        o_emit_pre_change_notify (toplevel, other_object);
+
+        add_connection (toplevel, object, other_object, CONN_ENDPOINT,
+                        other_object->line->x[k],
+                        other_object->line->y[k], j, k);
+
+        add_connection (toplevel, other_object, object, CONN_ENDPOINT,
+                        object->line->x[j],
+                        object->line->y[j], k, j);
+
+        o_emit_display_change_notify (toplevel, other_object);
+      }
+    }
+  }
+
+  /* Check both end points of the object against midpoints of the other */
+  for (k = 0; k < 2; k++) {
+
+    /* If the object is a pin, only check the correct end */
+    if (object->type == OBJ_PIN && object->whichend != k)
+      continue;
+
+    /* check for midpoint of other object, k endpoint of current obj*/
+    found = s_conn_check_midpoint (other_object, object->line->x[k],
+                                                 object->line->y[k]);
+
+    /* Pins are not allowed midpoint connections onto them. */
+    /* Allow nets to connect to the middle of buses. */
+    /* Allow compatible objects to connect. */
+    if (found && other_object->type != OBJ_PIN &&
+        ((object->type == OBJ_NET && other_object->type == OBJ_BUS) ||
+          check_direct_compat (object, other_object))) {
+
+      add_connection (toplevel, object, other_object, CONN_MIDPOINT,
+                      object->line->x[k],
+                      object->line->y[k], k, -1);
+
+      add_connection (toplevel, other_object, object, CONN_MIDPOINT,
+                      object->line->x[k],
+                      object->line->y[k], -1, k);
+
+    }
+  }
+
+  /* Check both end points of the other object against midpoints of the first */
+  for (k = 0; k < 2; k++) {
+
+    /* If the other object is a pin, only check the correct end */
+    if (other_object->type == OBJ_PIN && other_object->whichend != k)
+      continue;
+
+    /* do object's endpoints cross the middle of other_object? */
+    /* check for midpoint of other object, k endpoint of current obj*/
+    found = s_conn_check_midpoint (object, other_object->line->x[k],
+                                           other_object->line->y[k]);
+
+    /* Pins are not allowed midpoint connections onto them. */
+    /* Allow nets to connect to the middle of buses. */
+    /* Allow compatible objects to connect. */
+    if (found && object->type != OBJ_PIN &&
+         ((object->type == OBJ_BUS && other_object->type == OBJ_NET) ||
+           check_direct_compat (object, other_object))) {
+
+      add_connection (toplevel, object, other_object, CONN_MIDPOINT,
+                      other_object->line->x[k],
+                      other_object->line->y[k], -1, k);
+
+      add_connection (toplevel, other_object, object, CONN_MIDPOINT,
+                      other_object->line->x[k],
+                      other_object->line->y[k], k, -1);
+    }
   }
 }
 
@@ -363,19 +443,15 @@ static void add_connection (TOPLEVEL *toplevel,
 static void s_conn_update_line_object (TOPLEVEL *toplevel, OBJECT *object)
 {
   TILE *t_current;
-  GList *tl_current;
   GList *object_list;
   OBJECT *other_object;
-  OBJECT *found;
-  int j, k;
+  guint i;
 
   s_conn_freeze_hooks (toplevel, object);
 
   /* loop over all tiles which object appears in */
-  for (tl_current = object->tiles;
-       tl_current != NULL;
-       tl_current = g_list_next (tl_current)) {
-    t_current = tl_current->data;
+  for (i = 0; object->tiles != NULL && i < object->tiles->len; i++) {
+    t_current = g_ptr_array_index (object->tiles, i);
 
     for (object_list = t_current->objects;
          object_list != NULL;
@@ -387,193 +463,450 @@ static void s_conn_update_line_object (TOPLEVEL *toplevel, OBJECT *object)
 
       s_conn_freeze_hooks (toplevel, other_object);
 
-      /* Here is where you check the end points */
-      /* Check both end points of the other object */
-      for (k = 0; k < 2; k++) {
+      s_conn_connect_pair (toplevel, object, other_object);
 
-        /* If the other object is a pin, only check the correct end */
-        if (other_object->type == OBJ_PIN && other_object->whichend != k)
-          continue;
+      s_conn_thaw_hooks (toplevel, other_object);
+    }
+  }
 
-        /* Check both end points of the object */
-        for (j = 0; j < 2; j++) {
+#if DEBUG
+  s_conn_print(object->conns);
+#endif
 
-          /* If the object is a pin, only check the correct end */
-          if (object->type == OBJ_PIN && object->whichend != j)
-            continue;
+  s_conn_thaw_hooks (toplevel, object);
+}
 
-          /* Check for coincidence and compatability between
-             the objects being tested. */
-          if (object->line->x[j] == other_object->line->x[k] &&
-              object->line->y[j] == other_object->line->y[k] &&
-              check_direct_compat (object, other_object)) {
+/*! \brief add an OBJECT to the connection system
+ *
+ *  \par Function Description
+ *  This function searches for all geometrical conections of the OBJECT
+ *  <b>object</b> to all other connectable objects. It adds connections
+ *  to the object and from all other objects to this one.
+ *
+ *  \param toplevel (currently not used)
+ *  \param object OBJECT to add into the connection system
+ */
+void s_conn_update_object (TOPLEVEL *toplevel, OBJECT *object)
+{
+  switch (object->type) {
+    case OBJ_PIN:
+    case OBJ_NET:
+    case OBJ_BUS:
+      s_conn_update_line_object (toplevel, object);
+      break;
 
-            o_emit_pre_change_notify (toplevel, other_object);
+    case OBJ_COMPLEX:
+    case OBJ_PLACEHOLDER:
+      s_conn_update_glist (toplevel, object->complex->prim_objs);
+      break;
+  }
+}
 
-            add_connection (toplevel, object, other_object, CONN_ENDPOINT,
-                            other_object->line->x[k],
-                            other_object->line->y[k], j, k);
+/*! \brief hash function for endpoint index keys
+ *  \par Function Description
+ *  Hashes the kind and coordinates of a CONN_BUCKET.
+ */
+static guint conn_bucket_hash (gconstpointer key)
+{
+  const CONN_BUCKET *bucket = key;
 
-            add_connection (toplevel, other_object, object, CONN_ENDPOINT,
-                            object->line->x[j],
-                            object->line->y[j], k, j);
+  return ((guint) bucket->x * 31 + (guint) bucket->y) * 5 + bucket->kind;
+}
 
-            o_emit_change_notify (toplevel, other_object);
-          }
-        }
-      }
+/*! \brief equality function for endpoint index keys
+ *  \par Function Description
+ *  Two CONN_BUCKETs are equal if they have the same kind and coordinates.
+ */
+static gboolean conn_bucket_equal (gconstpointer a, gconstpointer b)
+{
+  const CONN_BUCKET *bucket_a = a;
+  const CONN_BUCKET *bucket_b = b;
 
-      /* Check both end points of the object against midpoints of the other */
-      for (k = 0; k < 2; k++) {
+  return (bucket_a->kind == bucket_b->kind &&
+          bucket_a->x == bucket_b->x &&
+          bucket_a->y == bucket_b->y);
+}
 
-        /* If the object is a pin, only check the correct end */
-        if (object->type == OBJ_PIN && object->whichend != k)
-          continue;
+static void conn_bucket_free (gpointer data)
+{
+  CONN_BUCKET *bucket = data;
 
-        /* check for midpoint of other object, k endpoint of current obj*/
-        found = s_conn_check_midpoint (other_object, object->line->x[k],
-                                                     object->line->y[k]);
+  g_list_free (bucket->objects);
+  g_free (bucket);
+}
 
-        /* Pins are not allowed midpoint connections onto them. */
-        /* Allow nets to connect to the middle of buses. */
-        /* Allow compatible objects to connect. */
-        if (found && other_object->type != OBJ_PIN &&
-            ((object->type == OBJ_NET && other_object->type == OBJ_BUS) ||
-              check_direct_compat (object, other_object))) {
+/*! \brief add an OBJECT under one key of an endpoint index
+ *  \par Function Description
+ *  Appends <b>object</b> to the bucket for the given key, creating
+ *  the bucket if necessary.
+ */
+static void conn_index_insert (GHashTable *index, CONN_KEY_KIND kind,
+                               int x, int y, OBJECT *object)
+{
+  CONN_BUCKET key;
+  CONN_BUCKET *bucket;
+
+  key.kind = kind;
+  key.x = x;
+  key.y = y;
+
+  bucket = g_hash_table_lookup (index, &key);
+  if (bucket == NULL) {
+    bucket = g_new0 (CONN_BUCKET, 1);
+    *bucket = key;
+    g_hash_table_insert (index, bucket, bucket);
+  }
 
-          add_connection (toplevel, object, other_object, CONN_MIDPOINT,
-                          object->line->x[k],
-                          object->line->y[k], k, -1);
+  bucket->objects = g_list_prepend (bucket->objects, object);
+}
 
-          add_connection (toplevel, other_object, object, CONN_MIDPOINT,
-                          object->line->x[k],
-                          object->line->y[k], -1, k);
+/*! \brief look up the OBJECTs under one key of an endpoint index
+ *  \return The list of OBJECTs, owned by the index
+ */
+static GList *conn_index_lookup (GHashTable *index, CONN_KEY_KIND kind,
+                                 int x, int y)
+{
+  CONN_BUCKET key;
+  CONN_BUCKET *bucket;
 
-        }
-      }
+  key.kind = kind;
+  key.x = x;
+  key.y = y;
 
-      /* Check both end points of the other object against midpoints of the first */
-      for (k = 0; k < 2; k++) {
+  bucket = g_hash_table_lookup (index, &key);
+  return (bucket != NULL) ? bucket->objects : NULL;
+}
 
-        /* If the other object is a pin, only check the correct end */
-        if (other_object->type == OBJ_PIN && other_object->whichend != k)
-          continue;
+/*! \brief add a line OBJECT to an endpoint index
+ *  \par Function Description
+ *  Files <b>object</b> under each of its connectable endpoints, under
+ *  the row and column of those endpoints, and, if it is horizontal or
+ *  vertical, under the line it lies on.  These are all the keys needed
+ *  to find the contacts tested by s_conn_connect_pair().
+ */
+static void conn_index_object (GHashTable *index, OBJECT *object)
+{
+  LINE *line = object->line;
+  int k;
 
-        /* do object's endpoints cross the middle of other_object? */
-        /* check for midpoint of other object, k endpoint of current obj*/
-        found = s_conn_check_midpoint (object, other_object->line->x[k],
-                                               other_object->line->y[k]);
+  for (k = 0; k < 2; k++) {
 
-        /* Pins are not allowed midpoint connections onto them. */
-        /* Allow nets to connect to the middle of buses. */
-        /* Allow compatible objects to connect. */
-        if (found && object->type != OBJ_PIN &&
-             ((object->type == OBJ_BUS && other_object->type == OBJ_NET) ||
-               check_direct_compat (object, other_object))) {
+    /* Only the connectable end of a pin takes part */
+    if (object->type == OBJ_PIN && object->whichend != k)
+      continue;
 
-          add_connection (toplevel, object, other_object, CONN_MIDPOINT,
-                          other_object->line->x[k],
-                          other_object->line->y[k], -1, k);
+    conn_index_insert (index, CONN_KEY_POINT, line->x[k], line->y[k], object);
+    conn_index_insert (index, CONN_KEY_ROW, 0, line->y[k], object);
+    conn_index_insert (index, CONN_KEY_COLUMN, line->x[k], 0, object);
+  }
 
-          add_connection (toplevel, other_object, object, CONN_MIDPOINT,
-                          other_object->line->x[k],
-                          other_object->line->y[k], k, -1);
-        }
-      }
+  if (line->x[0] == line->x[1] && line->y[0] == line->y[1])
+    return;
 
-      s_conn_thaw_hooks (toplevel, other_object);
-    }
+  if (line->y[0] == line->y[1])
+    conn_index_insert (index, CONN_KEY_HLINE, 0, line->y[0], object);
+  else if (line->x[0] == line->x[1])
+    conn_index_insert (index, CONN_KEY_VLINE, line->x[0], 0, object);
+}
+
+/*! \brief hold back the conns-changed hooks of an OBJECT
+ *  \par Function Description
+ *  Freezes the hooks of <b>object</b> until the end of the update.
+ *  Each OBJECT is only frozen once, so the hooks run at most once
+ *  for it when the update ends.
+ */
+static void conn_update_hold (CONN_UPDATE *update, OBJECT *object)
+{
+  if (g_hash_table_lookup (update->frozen, object) != NULL)
+    return;
+
+  g_hash_table_insert (update->frozen, object, object);
+  s_conn_freeze_hooks (update->toplevel, object);
+}
+
+static void conn_update_release (gpointer key, gpointer value,
+                                 gpointer user_data)
+{
+  s_conn_thaw_hooks ((TOPLEVEL *) user_data, (OBJECT *) key);
+}
+
+/*! \brief add OBJECTs from an endpoint index bucket to a candidate list
+ *  \par Function Description
+ *  Prepends each OBJECT of <b>objects</b> not yet in <b>seen</b> to
+ *  <b>candidates</b>.
+ */
+static GList *conn_add_candidates (GList *candidates, GHashTable *seen,
+                                   GList *objects)
+{
+  GList *iter;
+
+  for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
+    if (g_hash_table_lookup (seen, iter->data) != NULL)
+      continue;
+
+    g_hash_table_insert (seen, iter->data, iter->data);
+    candidates = g_list_prepend (candidates, iter->data);
   }
 
-#if DEBUG
-  s_conn_print(object->conn_list);
-#endif
+  return candidates;
+}
 
-  s_conn_thaw_hooks (toplevel, object);
+/*! \brief find the OBJECTs which may touch a line OBJECT
+ *  \par Function Description
+ *  Uses the endpoint index to list every OBJECT which has an endpoint
+ *  on an endpoint of <b>object</b>, which passes through an endpoint of
+ *  <b>object</b>, or which has an endpoint on the line of
+ *  <b>object</b>.
+ *
+ *  \return A GList of candidate OBJECTs, to be freed by the caller
+ */
+static GList *conn_find_candidates (GHashTable *index, GHashTable *seen,
+                                    OBJECT *object)
+{
+  LINE *line = object->line;
+  GList *candidates = NULL;
+  int k;
+
+  for (k = 0; k < 2; k++) {
+
+    if (object->type == OBJ_PIN && object->whichend != k)
+      continue;
+
+    candidates = conn_add_candidates (candidates, seen,
+                   conn_index_lookup (index, CONN_KEY_POINT,
+                                      line->x[k], line->y[k]));
+    candidates = conn_add_candidates (candidates, seen,
+                   conn_index_lookup (index, CONN_KEY_HLINE, 0, line->y[k]));
+    candidates = conn_add_candidates (candidates, seen,
+                   conn_index_lookup (index, CONN_KEY_VLINE, line->x[k], 0));
+  }
+
+  /* Pins are not allowed midpoint connections onto them. */
+  if (object->type == OBJ_PIN ||
+      (line->x[0] == line->x[1] && line->y[0] == line->y[1]))
+    return candidates;
+
+  if (line->y[0] == line->y[1]) {
+    candidates = conn_add_candidates (candidates, seen,
+                   conn_index_lookup (index, CONN_KEY_ROW, 0, line->y[0]));
+  } else if (line->x[0] == line->x[1]) {
+    candidates = conn_add_candidates (candidates, seen,
+                   conn_index_lookup (index, CONN_KEY_COLUMN, line->x[0], 0));
+  }
+
+  return candidates;
 }
 
-/*! \brief add an OBJECT to the connection system
+/*! \brief start a batched update of the connection system
+ *  \par Function Description
+ *  Returns a new CONN_UPDATE.  OBJECTs which are about to be moved or
+ *  reshaped are added to it with s_conn_update_add_object(), and are
+ *  all reconnected at once by s_conn_update_end().  This is much
+ *  cheaper than calling s_conn_remove_object() and
+ *  s_conn_update_object() on each OBJECT in turn, as the search for
+ *  new connections is shared between all the OBJECTs, and the
+ *  conns-changed hooks run only once per OBJECT.
  *
+ *  OBJECTs added to the update, or connected to OBJECTs added to the
+ *  update, must not be deleted before s_conn_update_end() is called.
+ *
+ *  \param toplevel The TOPLEVEL structure
+ *  \return A new CONN_UPDATE
+ */
+CONN_UPDATE *s_conn_update_begin (TOPLEVEL *toplevel)
+{
+  CONN_UPDATE *update = g_new0 (CONN_UPDATE, 1);
+
+  update->toplevel = toplevel;
+  update->objects = NULL;
+  update->members = g_hash_table_new (g_direct_hash, g_direct_equal);
+  update->frozen = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  return update;
+}
+
+/*! \brief add an OBJECT to a batched connection update
  *  \par Function Description
- *  This function searches for all geometrical conections of the OBJECT
- *  <b>object</b> to all other connectable objects. It adds connections
- *  to the object and from all other objects to this one.
+ *  Removes all connections from and to <b>object</b> (or, for a
+ *  complex, its pins and nets), and records it to be reconnected
+ *  when the update ends.  The OBJECT may then be changed freely,
+ *  as long as the tile system is kept up to date.
  *
- *  \param toplevel (currently not used)
- *  \param object OBJECT to add into the connection system
+ *  \param update The CONN_UPDATE
+ *  \param object The OBJECT to add
  */
-void s_conn_update_object (TOPLEVEL *toplevel, OBJECT *object)
+void s_conn_update_add_object (CONN_UPDATE *update, OBJECT *object)
 {
+  GList *iter;
+  guint i;
+
   switch (object->type) {
     case OBJ_PIN:
     case OBJ_NET:
     case OBJ_BUS:
-      s_conn_update_line_object (toplevel, object);
+      if (g_hash_table_lookup (update->members, object) != NULL)
+        break;
+
+      conn_update_hold (update, object);
+      for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+        conn_update_hold (update,
+                          g_array_index (object->conns, CONN, i).other_object);
+      }
+
+      s_conn_remove_object (update->toplevel, object);
+
+      g_hash_table_insert (update->members, object, object);
+      update->objects = g_list_prepend (update->objects, object);
       break;
 
     case OBJ_COMPLEX:
     case OBJ_PLACEHOLDER:
-      s_conn_update_glist (toplevel, object->complex->prim_objs);
+      for (iter = object->complex->prim_objs;
+           iter != NULL; iter = g_list_next (iter)) {
+        s_conn_update_add_object (update, iter->data);
+      }
       break;
   }
 }
 
-/*! \brief print all connections of a connection list
+/*! \brief finish a batched update of the connection system
  *  \par Function Description
- *  This is a debugging function to print a List of connections.
- *  \param conn_list GList of connection objects
+ *  Reconnects all the OBJECTs added to <b>update</b>, then runs the
+ *  conns-changed hooks held back during the update and frees it.
+ *
+ *  Only OBJECTs which share a tile with one of the updated OBJECTs are
+ *  put in the endpoint index, so the cost depends on the size of the
+ *  update rather than the size of the page.  Each pair of updated
+ *  OBJECTs is tested only once.
+ *
+ *  \param update The CONN_UPDATE to finish
  */
-void s_conn_print(GList * conn_list)
+void s_conn_update_end (CONN_UPDATE *update)
+{
+  TOPLEVEL *toplevel = update->toplevel;
+  GHashTable *tiles, *index, *seen, *done;
+  GHashTableIter tile_iter;
+  GList *iter, *o_iter, *candidates, *c_iter;
+  OBJECT *object, *other_object;
+  TILE *t_current;
+  guint i;
+
+  update->objects = g_list_reverse (update->objects);
+
+  /* Gather the tiles the updated objects now lie in */
+  tiles = g_hash_table_new (g_direct_hash, g_direct_equal);
+  for (iter = update->objects; iter != NULL; iter = g_list_next (iter)) {
+    object = iter->data;
+    for (i = 0; object->tiles != NULL && i < object->tiles->len; i++) {
+      t_current = g_ptr_array_index (object->tiles, i);
+      g_hash_table_insert (tiles, t_current, t_current);
+    }
+  }
+
+  /* Index every object in those tiles by its endpoints and lines */
+  index = g_hash_table_new_full (conn_bucket_hash, conn_bucket_equal,
+                                 NULL, conn_bucket_free);
+  seen = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  g_hash_table_iter_init (&tile_iter, tiles);
+  while (g_hash_table_iter_next (&tile_iter, (gpointer *) &t_current, NULL)) {
+    for (o_iter = t_current->objects;
+         o_iter != NULL; o_iter = g_list_next (o_iter)) {
+      if (g_hash_table_lookup (seen, o_iter->data) != NULL)
+        continue;
+      g_hash_table_insert (seen, o_iter->data, o_iter->data);
+      conn_index_object (index, o_iter->data);
+    }
+  }
+  g_hash_table_destroy (tiles);
+
+  /* Connect each updated object to the objects it touches */
+  done = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (iter = update->objects; iter != NULL; iter = g_list_next (iter)) {
+    object = iter->data;
+
+    g_hash_table_remove_all (seen);
+    candidates = conn_find_candidates (index, seen, object);
+
+    for (c_iter = candidates; c_iter != NULL; c_iter = g_list_next (c_iter)) {
+      other_object = c_iter->data;
+
+      if (other_object == object ||
+          g_hash_table_lookup (done, other_object) != NULL)
+        continue;
+
+      conn_update_hold (update, other_object);
+      s_conn_connect_pair (toplevel, object, other_object);
+    }
+
+    g_list_free (candidates);
+    g_hash_table_insert (done, object, object);
+  }
+
+  g_hash_table_destroy (done);
+  g_hash_table_destroy (seen);
+  g_hash_table_destroy (index);
+
+  /* Let the held back hooks run */
+  g_hash_table_foreach (update->frozen, conn_update_release, toplevel);
+
+  g_hash_table_destroy (update->frozen);
+  g_hash_table_destroy (update->members);
+  g_list_free (update->objects);
+  g_free (update);
+}
+
+/*! \brief print all connections of a connection array
+ *  \par Function Description
+ *  This is a debugging function to print an array of connections.
+ *  \param conns GArray of connections, or NULL
+ */
+void s_conn_print(GArray * conns)
 {
   CONN *conn;
-  GList *cl_current;
+  guint i;
 
   printf("\nStarting s_conn_print\n");
-  cl_current = conn_list;
-  while (cl_current != NULL) {
+  for (i = 0; conns != NULL && i < conns->len; i++) {
 
-    conn = (CONN *) cl_current->data;
+    conn = &g_array_index (conns, CONN, i);
     printf("-----------------------------------\n");
-    printf("other object: %s\n", conn->other_object->name);
+    printf("other object: %s\n", o_get_name (conn->other_object));
     printf("type: %d\n", conn->type);
     printf("x: %d y: %d\n", conn->x, conn->y);
     printf("whichone: %d\n", conn->whichone);
     printf("other_whichone: %d\n", conn->other_whichone);
     printf("-----------------------------------\n");
-
-    cl_current = g_list_next(cl_current);
   }
 
 }
 
 /*! \brief Search for net in existing connections.
  *  \par Function Description
- *  This method searches the connection list for the first matching
+ *  This method searches the connection array for the first matching
  *  connection with the given x, y, and whichone endpoint.
  *
  *  \param [in] new_net    Net OBJECT to compare to.
  *  \param [in] whichone   The connection number to check.
- *  \param [in] conn_list  List of existing connections to compare
- *                         <B>new_net</B> to.
+ *  \param [in] conns      Array of existing connections to compare
+ *                         <B>new_net</B> to, or NULL.
  *  \return TRUE if a matching connection is found, FALSE otherwise. 
  */
-int s_conn_net_search(OBJECT* new_net, int whichone, GList * conn_list)
+int s_conn_net_search(OBJECT* new_net, int whichone, GArray * conns)
 {
   CONN *conn;
-  GList *cl_current;
+  guint i;
 
-  cl_current = conn_list;
-  while (cl_current != NULL) {
+  for (i = 0; conns != NULL && i < conns->len; i++) {
 
-    conn = (CONN *) cl_current->data;
-    if (conn != NULL && conn->whichone == whichone && 
+    conn = &g_array_index (conns, CONN, i);
+    if (conn->whichone == whichone && 
         conn->x == new_net->line->x[whichone] &&
 	conn->y == new_net->line->y[whichone])
     {
        return TRUE;
     }
-
-    cl_current = g_list_next(cl_current);
   }
  
   return FALSE;
@@ -626,8 +959,8 @@ static GList *s_conn_return_glist_others (GList *input_list, GList *obj_list)
  */
 GList *s_conn_return_others(GList *input_list, OBJECT *object)
 {
-  GList *c_iter;
   GList *return_list;
+  guint i;
 
   return_list = input_list;
 
@@ -635,9 +968,8 @@ GList *s_conn_return_others(GList *input_list, OBJECT *object)
     case OBJ_PIN:
     case OBJ_NET:
     case OBJ_BUS:
-      for (c_iter = object->conn_list;
-           c_iter != NULL; c_iter = g_list_next (c_iter)) {
-        CONN *conn = c_iter->data;
+      for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+        CONN *conn = &g_array_index (object->conns, CONN, i);
 
         if (conn->other_object && conn->other_object != object) {
           return_list = g_list_append(return_list, conn->other_object);
@@ -119,7 +119,7 @@ void s_cue_output_lowlevel(TOPLEVEL * toplevel, OBJECT * object, int whichone,
 			   FILE * fp, int output_type)
 {
   int x, y;
-  GList *cl_current;
+  guint i;
   CONN *conn;
   int type, count = 0;
   int done = FALSE;
@@ -134,9 +134,8 @@ void s_cue_output_lowlevel(TOPLEVEL * toplevel, OBJECT * object, int whichone,
        (object->type == OBJ_PIN && object->pin_type == PIN_TYPE_BUS))
     bus_involved = TRUE;
 
-  cl_current = object->conn_list;
-  while (cl_current != NULL && !done) {
-    conn = (CONN *) cl_current->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len && !done; i++) {
+    conn = &g_array_index (object->conns, CONN, i);
 
     if (conn->x == x && conn->y == y) {
 
@@ -159,8 +158,6 @@ void s_cue_output_lowlevel(TOPLEVEL * toplevel, OBJECT * object, int whichone,
           break;
       }
     }
-
-    cl_current = g_list_next(cl_current);
   }
 
 #if DEBUG
@@ -201,16 +198,15 @@ void s_cue_output_lowlevel_midpoints(TOPLEVEL * toplevel, OBJECT * object,
 				     FILE * fp, int output_type)
 {
   int x, y;
-  GList *cl_current;
+  guint i;
   CONN *conn;
   int bus_involved = FALSE;
 
   if (object->type == OBJ_BUS)
     bus_involved = TRUE;
 
-  cl_current = object->conn_list;
-  while (cl_current != NULL) {
-    conn = (CONN *) cl_current->data;
+  for (i = 0; object->conns != NULL && i < object->conns->len; i++) {
+    conn = &g_array_index (object->conns, CONN, i);
 
     switch (conn->type) {
       case (CONN_MIDPOINT):
@@ -226,9 +222,6 @@ void s_cue_output_lowlevel_midpoints(TOPLEVEL * toplevel, OBJECT * object,
         }
         break;
     }
-
-
-    cl_current = g_list_next(cl_current);
   }
 }
 
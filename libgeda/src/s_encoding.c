@@ -66,6 +66,34 @@ static guchar s_encoding_Base64_rank[256] = {
 	255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255, /*	0xf0-0xff	*/
 };
 
+/*! Number of 3-byte groups encoded on each line in strict mode. */
+#define s_encoding_Groups_per_line	(72/4)
+
+/*! \brief Get the table of base64 symbol pairs.
+ *  \par Function Description
+ *  Returns a table holding, for each 12-bit value, the two base64
+ *  symbols encoding it, so that a 3-byte group is encoded with two
+ *  lookups instead of four.  The table is filled on first use.
+ *
+ *  \return The table of 2 * 4096 characters.
+ */
+static const gchar *s_encoding_base64_pairs (void)
+{
+  static gchar pairs[2 * 4096];
+  static gsize initialized = 0;
+  guint i;
+
+  if (g_once_init_enter (&initialized)) {
+    for (i = 0; i < 4096; i++) {
+      pairs[2 * i]     = s_encoding_Base64[i >> 6];
+      pairs[2 * i + 1] = s_encoding_Base64[i & 0x3f];
+    }
+    g_once_init_leave (&initialized, 1);
+  }
+
+  return pairs;
+}
+
 /*! \brief Convert a buffer from binary to base64 representation.
  *  \par Function Description
  *  Convert a buffer from binary to base64 representation.  Set
@@ -82,11 +110,14 @@ static guchar s_encoding_Base64_rank[256] = {
 gchar* s_encoding_base64_encode (gchar* src, guint srclen, 
 				 guint* dstlenp, gboolean strict) 
 {
+  const gchar *pairs;
+  const guchar *in = (const guchar *) src;
   gchar* dst;
-  guint dstpos;
+  gchar* out;
   guchar input[3];
   guchar output[4];
-  guint ocnt;
+  guint groups, line_left;
+  guint32 word;
   guint i;
 
   if (srclen == 0) 
@@ -99,45 +130,37 @@ gchar* s_encoding_base64_encode (gchar* src, guint srclen,
     *dstlenp += (*dstlenp / 72);	/* Handle trailing \n */
 
   dst = g_new(gchar, *dstlenp );
+  out = dst;
+  pairs = s_encoding_base64_pairs ();
 
-  /* bulk encoding */
-  dstpos = 0;
-  ocnt = 0;
+  /* bulk encoding, a line at a time */
+  line_left = strict ? s_encoding_Groups_per_line : G_MAXUINT;
   while (srclen >= 3) 
     {
-      /*
-	Convert 3 bytes of src to 4 bytes of output
-
-	output[0] = input[0] 7:2
-	output[1] = input[0] 1:0 input[1] 7:4
-	output[2] = input[1] 3:0 input[2] 7:6
-	output[3] = input[1] 5:0
+      groups = MIN (srclen / 3, line_left);
+      srclen -= groups * 3;
+      line_left -= groups;
 
+      /*
+	Convert 3 bytes of src to 4 bytes of output, as two 12-bit
+	halves of the 24-bit group.
        */
-      input[0] = *src++;
-      input[1] = *src++;
-      input[2] = *src++;
-      srclen -= 3;
-
-      output[0] = (input[0] >> 2);
-      output[1] = ((input[0] & 0x03) << 4) + 
-	(input[1] >> 4);
-      output[2] = ((input[1] & 0x0f) << 2) + 
-	(input[2] >> 6);
-      output[3] = (input[2] & 0x3f);
-
-      g_assert ((dstpos + 4) < *dstlenp);
+      for (i = 0; i < groups; i++)
+	{
+	  word = (in[0] << 16) | (in[1] << 8) | in[2];
+	  in += 3;
 
-      /* Map output to the Base64 alphabet */
-      dst[dstpos++] = s_encoding_Base64[(guint) output[0]];
-      dst[dstpos++] = s_encoding_Base64[(guint) output[1]];
-      dst[dstpos++] = s_encoding_Base64[(guint) output[2]];
-      dst[dstpos++] = s_encoding_Base64[(guint) output[3]];
+	  memcpy (out,     pairs + 2 * (word >> 12),   2);
+	  memcpy (out + 2, pairs + 2 * (word & 0xfff), 2);
+	  out += 4;
+	}
 
-      /* Add a newline if strict and  */
-      if (strict)
-	if ((++ocnt % (72/4)) == 0) 
-	  dst[dstpos++] = '\n';
+      /* Add a newline if strict and the line is full */
+      if (line_left == 0)
+	{
+	  *out++ = '\n';
+	  line_left = s_encoding_Groups_per_line;
+	}
     }
 
   /* Now worry about padding with remaining 1 or 2 bytes */
@@ -145,7 +168,7 @@ gchar* s_encoding_base64_encode (gchar* src, guint srclen,
     {
       input[0] = input[1] = input[2] = '\0';
       for (i = 0; i < srclen; i++) 
-	input[i] = *src++;
+	input[i] = *in++;
 
       output[0] = (input[0] >> 2);
       output[1] = ((input[0] & 0x03) << 4) + 
@@ -153,24 +176,22 @@ gchar* s_encoding_base64_encode (gchar* src, guint srclen,
       output[2] = ((input[1] & 0x0f) << 2) + 
 	(input[2] >> 6);
 
-      g_assert ((dstpos + 4) < *dstlenp);
-
-      dst[dstpos++] = s_encoding_Base64[(guint) output[0]];
-      dst[dstpos++] = s_encoding_Base64[(guint) output[1]];
+      *out++ = s_encoding_Base64[(guint) output[0]];
+      *out++ = s_encoding_Base64[(guint) output[1]];
 
       if (srclen == 1)
-	dst[dstpos++] = s_encoding_Pad64;
+	*out++ = s_encoding_Pad64;
       else
-	dst[dstpos++] = s_encoding_Base64[(guint) output[2]];
+	*out++ = s_encoding_Base64[(guint) output[2]];
 
-      dst[dstpos++] = s_encoding_Pad64;
+      *out++ = s_encoding_Pad64;
     }
 
-  g_assert (dstpos <= *dstlenp);
+  g_assert (out < dst + *dstlenp);
 
-  dst[dstpos] = '\0';
+  *out = '\0';
 
-  *dstlenp = dstpos + 1;
+  *dstlenp = out - dst + 1;
 
   return dst;
 }
@@ -207,8 +228,31 @@ gchar *s_encoding_base64_decode (gchar* src, guint srclen, guint* dstlenp)
 
   while (srclen > 0)
     {
+      /* Fast path: four base64 symbols in a row make three whole
+	 bytes.  Anything else goes through the state machine below. */
+      if (state == 0 && srclen >= 4)
+	{
+	  guint r0 = s_encoding_Base64_rank[(guchar) src[0]];
+	  guint r1 = s_encoding_Base64_rank[(guchar) src[1]];
+	  guint r2 = s_encoding_Base64_rank[(guchar) src[2]];
+	  guint r3 = s_encoding_Base64_rank[(guchar) src[3]];
+
+	  if (((r0 | r1 | r2 | r3) & 0xc0) == 0)
+	    {
+	      guint32 word = (r0 << 18) | (r1 << 12) | (r2 << 6) | r3;
+
+	      dst[dstidx++] = (gchar) (word >> 16);
+	      dst[dstidx++] = (gchar) (word >> 8);
+	      dst[dstidx++] = (gchar) word;
+	      ch = (guchar) src[3];
+	      src += 4;
+	      srclen -= 4;
+	      continue;
+	    }
+	}
+
       srclen--;
-      ch = *src++;
+      ch = (guchar) *src++;
       if (ch == s_encoding_Pad64) 
 	break;
       if (s_encoding_Base64_rank[ch]==255) /* Skip any non-base64 anywhere */
@@ -259,7 +303,7 @@ gchar *s_encoding_base64_decode (gchar* src, guint srclen, guint* dstlenp)
 	  while (srclen > 0)
 	    {
 	      srclen--;
-	      ch = *src++;
+	      ch = (guchar) *src++;
 	      if (ch == s_encoding_Pad64) break;
 	      if (s_encoding_Base64_rank[ch] != 255) break;
 	    }
@@ -279,7 +323,7 @@ gchar *s_encoding_base64_decode (gchar* src, guint srclen, guint* dstlenp)
 	  while (srclen > 0)
 	    {
 	      srclen--;
-	      ch = *src++;
+	      ch = (guchar) *src++;
 	      if (s_encoding_Base64_rank[ch] != 255) 
 		{
 		  g_free(dst);
@@ -0,0 +1,483 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02111-1301 USA
+ */
+#include <config.h>
+
+#include <stdio.h>
+
+#include "libgeda_priv.h"
+
+#ifdef HAVE_LIBDMALLOC
+#include <dmalloc.h>
+#endif
+
+/*! \file s_index.c
+ *  \brief Spatial index of the objects on a page
+ *
+ *  Each PAGE carries a <b>SPATIAL_INDEX</b> (st_spatial_index) of its
+ *  top-level OBJECTs.  The index splits the page into a grid of
+ *  <b>INDEX_CELLS_X</b> by <b>INDEX_CELLS_Y</b> cells, and every OBJECT
+ *  is stored in each cell touched by its bounding box.  Objects which
+ *  cover too many cells, or whose bounds are not known, are kept on a
+ *  separate overflow list which every query returns.
+ *
+ *  Unlike the tile system (see s_tile.c), which only tracks nets, pins
+ *  and buses for the connection system, the index covers all objects and
+ *  is used to find objects by location, e.g. for picking and redrawing.
+ *
+ *  Objects are not reindexed immediately when their bounds change.
+ *  Instead, s_index_touch_object() is called whenever an object's bounds
+ *  are recalculated or invalidated, and queues the object's top-level
+ *  ancestor.  Queued objects are placed again before the next query.
+ *
+ *  Every entry also remembers the position of its OBJECT in the page's
+ *  object list, so that queries can return objects in page order.
+ *
+ *  Hidden text only has bounds while hidden text is shown.  The index
+ *  notes the toplevel's show_hidden_text setting each time it is
+ *  brought up to date, and when the setting has changed it places all
+ *  of its hidden text again.  This way the text on every page follows
+ *  the setting, not just the text on the page being displayed.
+ */
+
+/*! \brief Work out the range of cells covered by a rectangle
+ *  \par Function Description
+ *  Clamps the cell coordinates to the grid, so that objects outside
+ *  the initial page extents are stored in the border cells.
+ */
+static void
+index_cell_range (SPATIAL_INDEX *index,
+                  int min_x, int min_y, int max_x, int max_y,
+                  int *x1, int *y1, int *x2, int *y2)
+{
+  *x1 = CLAMP ((int) (min_x / index->cell_width),  0, INDEX_CELLS_X - 1);
+  *x2 = CLAMP ((int) (max_x / index->cell_width),  0, INDEX_CELLS_X - 1);
+  *y1 = CLAMP ((int) (min_y / index->cell_height), 0, INDEX_CELLS_Y - 1);
+  *y2 = CLAMP ((int) (max_y / index->cell_height), 0, INDEX_CELLS_Y - 1);
+}
+
+/*! \brief Take an entry out of the cells or overflow list it is in */
+static void
+index_unplace_entry (SPATIAL_INDEX *index, INDEX_ENTRY *entry)
+{
+  int i, j;
+
+  switch (entry->location) {
+    case INDEX_IN_CELLS:
+      for (i = entry->x1; i <= entry->x2; i++) {
+        for (j = entry->y1; j <= entry->y2; j++) {
+          g_ptr_array_remove_fast (index->cells[i][j], entry);
+        }
+      }
+      break;
+
+    case INDEX_IN_OVERFLOW:
+      g_ptr_array_remove_fast (index->overflow, entry);
+      break;
+
+    default:
+      break;
+  }
+
+  entry->location = INDEX_NOWHERE;
+}
+
+/*! \brief Place an entry according to its object's current bounds
+ *  \par Function Description
+ *  Hidden text which is not being shown has no bounds and can never be
+ *  found, so it is left out of the cells altogether.  It is placed
+ *  again when it is made visible, or when index_flush() sees that
+ *  hidden text is now shown.  Any other object without bounds goes on
+ *  the overflow list.
+ */
+static void
+index_place_entry (TOPLEVEL *toplevel, SPATIAL_INDEX *index,
+                   INDEX_ENTRY *entry)
+{
+  int left, top, right, bottom;
+  int i, j;
+
+  if (!world_get_single_object_bounds (toplevel, entry->object,
+                                       &left, &top, &right, &bottom)) {
+    if (o_is_visible (toplevel, entry->object) ||
+        toplevel->show_hidden_text) {
+      entry->location = INDEX_IN_OVERFLOW;
+      g_ptr_array_add (index->overflow, entry);
+    }
+    return;
+  }
+
+  index_cell_range (index, left, top, right, bottom,
+                    &entry->x1, &entry->y1, &entry->x2, &entry->y2);
+
+  if ((entry->x2 - entry->x1 + 1) * (entry->y2 - entry->y1 + 1)
+      > INDEX_MAX_CELL_SPAN) {
+    entry->location = INDEX_IN_OVERFLOW;
+    g_ptr_array_add (index->overflow, entry);
+    return;
+  }
+
+  for (i = entry->x1; i <= entry->x2; i++) {
+    for (j = entry->y1; j <= entry->y2; j++) {
+      if (index->cells[i][j] == NULL) {
+        index->cells[i][j] = g_ptr_array_new ();
+      }
+      g_ptr_array_add (index->cells[i][j], entry);
+    }
+  }
+  entry->location = INDEX_IN_CELLS;
+}
+
+/*! \brief Queue an entry to be placed again before the next query */
+static void
+index_mark_dirty (SPATIAL_INDEX *index, INDEX_ENTRY *entry)
+{
+  if (entry->dirty)
+    return;
+
+  entry->dirty = TRUE;
+  g_ptr_array_add (index->dirty, entry);
+}
+
+/*! \brief Queue an entry to be placed again if it is hidden text */
+static void
+index_mark_hidden_dirty (gpointer key, gpointer value, gpointer user_data)
+{
+  OBJECT *object = key;
+  INDEX_ENTRY *entry = value;
+  SPATIAL_INDEX *index = user_data;
+
+  if (object->type == OBJ_TEXT && object->visibility != VISIBLE) {
+    index_mark_dirty (index, entry);
+  }
+}
+
+/*! \brief Place all entries whose bounds have changed
+ *  \par Function Description
+ *  If hidden text has been shown or hidden since the last flush, all
+ *  hidden text is queued first.
+ *
+ *  The entry is only marked clean after its bounds have been fetched,
+ *  so that a bounds recalculation triggered by the fetch does not
+ *  queue the entry again.
+ */
+static void
+index_flush (TOPLEVEL *toplevel, SPATIAL_INDEX *index)
+{
+  guint n;
+
+  if (index->show_hidden_text != toplevel->show_hidden_text) {
+    g_hash_table_foreach (index->entries, index_mark_hidden_dirty, index);
+    index->show_hidden_text = toplevel->show_hidden_text;
+  }
+
+  for (n = 0; n < index->dirty->len; n++) {
+    INDEX_ENTRY *entry = g_ptr_array_index (index->dirty, n);
+
+    index_unplace_entry (index, entry);
+    index_place_entry (toplevel, index, entry);
+    entry->dirty = FALSE;
+  }
+  g_ptr_array_set_size (index->dirty, 0);
+}
+
+/*! \brief Add an entry to a query result, unless already there */
+static void
+index_collect (SPATIAL_INDEX *index, GPtrArray *found, GPtrArray *entries)
+{
+  guint n;
+
+  if (entries == NULL)
+    return;
+
+  for (n = 0; n < entries->len; n++) {
+    INDEX_ENTRY *entry = g_ptr_array_index (entries, n);
+    if (entry->query_stamp != index->query_stamp) {
+      entry->query_stamp = index->query_stamp;
+      g_ptr_array_add (found, entry);
+    }
+  }
+}
+
+/*! \brief Order entries by position in the page's object list */
+static gint
+index_entry_order_cmp (gconstpointer a, gconstpointer b)
+{
+  const INDEX_ENTRY *entry_a = *(INDEX_ENTRY **) a;
+  const INDEX_ENTRY *entry_b = *(INDEX_ENTRY **) b;
+
+  if (entry_a->order < entry_b->order) return -1;
+  if (entry_a->order > entry_b->order) return 1;
+  return 0;
+}
+
+/*! \brief Create a new, empty spatial index
+ *  \par Function Description
+ *  Creates a spatial index whose cells evenly divide the initial page
+ *  extents of \a toplevel.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \return A newly allocated SPATIAL_INDEX, to be freed with
+ *          s_index_free().
+ */
+SPATIAL_INDEX *
+s_index_new (TOPLEVEL *toplevel)
+{
+  SPATIAL_INDEX *index = g_new0 (SPATIAL_INDEX, 1);
+
+  index->entries = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                          NULL, g_free);
+  index->overflow = g_ptr_array_new ();
+  index->dirty = g_ptr_array_new ();
+  index->show_hidden_text = toplevel->show_hidden_text;
+
+  index->cell_width =
+    MAX ((double) toplevel->init_right / (double) INDEX_CELLS_X, 1.0);
+  index->cell_height =
+    MAX ((double) toplevel->init_bottom / (double) INDEX_CELLS_Y, 1.0);
+
+  return index;
+}
+
+/*! \brief Free a spatial index
+ *  \par Function Description
+ *  Frees \a index and all its entries.  The indexed objects are not
+ *  affected.
+ *
+ *  \param [in] index  The SPATIAL_INDEX to free.
+ */
+void
+s_index_free (SPATIAL_INDEX *index)
+{
+  int i, j;
+
+  if (index == NULL)
+    return;
+
+  for (i = 0; i < INDEX_CELLS_X; i++) {
+    for (j = 0; j < INDEX_CELLS_Y; j++) {
+      if (index->cells[i][j] != NULL) {
+        g_ptr_array_free (index->cells[i][j], TRUE);
+      }
+    }
+  }
+  g_ptr_array_free (index->overflow, TRUE);
+  g_ptr_array_free (index->dirty, TRUE);
+  g_hash_table_destroy (index->entries);
+  g_free (index);
+}
+
+/*! \brief Add an object to a spatial index
+ *  \par Function Description
+ *  Adds \a object to \a index, ordered after all objects already in
+ *  the index.  The object is placed in the cells before the next query.
+ *  Does nothing if \a object is already in the index.
+ *
+ *  \param [in] index   The SPATIAL_INDEX to add to.
+ *  \param [in] object  The top-level OBJECT being added.
+ */
+void
+s_index_add_object (SPATIAL_INDEX *index, OBJECT *object)
+{
+  INDEX_ENTRY *entry;
+
+  g_return_if_fail (index != NULL);
+  g_return_if_fail (object != NULL);
+
+  if (g_hash_table_lookup (index->entries, object) != NULL)
+    return;
+
+  entry = g_new0 (INDEX_ENTRY, 1);
+  entry->object = object;
+  entry->order = index->next_order++;
+  entry->location = INDEX_NOWHERE;
+
+  g_hash_table_insert (index->entries, object, entry);
+  index_mark_dirty (index, entry);
+}
+
+/*! \brief Replace an object in a spatial index, keeping its order
+ *  \par Function Description
+ *  Removes \a object1 from \a index and adds \a object2 at the same
+ *  position in the ordering.  If \a object1 is not in the index, \a
+ *  object2 is added after all other objects.
+ *
+ *  \param [in] index    The SPATIAL_INDEX to modify.
+ *  \param [in] object1  The OBJECT being removed.
+ *  \param [in] object2  The OBJECT being added.
+ */
+void
+s_index_replace_object (SPATIAL_INDEX *index,
+                        OBJECT *object1, OBJECT *object2)
+{
+  INDEX_ENTRY *entry;
+  guint order;
+
+  g_return_if_fail (index != NULL);
+
+  entry = g_hash_table_lookup (index->entries, object1);
+  if (entry == NULL) {
+    s_index_add_object (index, object2);
+    return;
+  }
+
+  order = entry->order;
+  s_index_remove_object (index, object1);
+  s_index_add_object (index, object2);
+
+  entry = g_hash_table_lookup (index->entries, object2);
+  entry->order = order;
+}
+
+/*! \brief Remove an object from a spatial index
+ *
+ *  \param [in] index   The SPATIAL_INDEX to remove from.
+ *  \param [in] object  The OBJECT being removed.
+ */
+void
+s_index_remove_object (SPATIAL_INDEX *index, OBJECT *object)
+{
+  INDEX_ENTRY *entry;
+
+  g_return_if_fail (index != NULL);
+
+  entry = g_hash_table_lookup (index->entries, object);
+  if (entry == NULL)
+    return;
+
+  index_unplace_entry (index, entry);
+  if (entry->dirty) {
+    g_ptr_array_remove_fast (index->dirty, entry);
+  }
+  g_hash_table_remove (index->entries, object);
+}
+
+/*! \brief Compare the positions of two objects in a spatial index
+ *  \par Function Description
+ *  Compares the positions of \a object1 and \a object2 in the page's
+ *  object list, as recorded by \a index.
+ *
+ *  \param [in] index    The SPATIAL_INDEX to look in.
+ *  \param [in] object1  The first OBJECT.
+ *  \param [in] object2  The second OBJECT.
+ *  \return Less than, equal to or greater than zero if \a object1
+ *          comes before, at or after \a object2.  Zero if either is
+ *          not in \a index.
+ */
+gint
+s_index_compare_order (SPATIAL_INDEX *index,
+                       OBJECT *object1, OBJECT *object2)
+{
+  INDEX_ENTRY *entry1;
+  INDEX_ENTRY *entry2;
+
+  g_return_val_if_fail (index != NULL, 0);
+
+  entry1 = g_hash_table_lookup (index->entries, object1);
+  entry2 = g_hash_table_lookup (index->entries, object2);
+  if (entry1 == NULL || entry2 == NULL)
+    return 0;
+
+  return index_entry_order_cmp (&entry1, &entry2);
+}
+
+/*! \brief Notify the spatial index that an object's bounds changed
+ *  \par Function Description
+ *  Queues the top-level ancestor of \a object to be placed again in the
+ *  index of the page it belongs to.  Does nothing for objects which are
+ *  not on a page.  This should be called whenever an object's bounds
+ *  are recalculated or invalidated.
+ *
+ *  \param [in] object  The OBJECT whose bounds changed.
+ */
+void
+s_index_touch_object (OBJECT *object)
+{
+  INDEX_ENTRY *entry;
+
+  while (object->parent != NULL) {
+    object = object->parent;
+  }
+
+  if (object->page == NULL || object->page->spatial_index == NULL)
+    return;
+
+  entry = g_hash_table_lookup (object->page->spatial_index->entries, object);
+  if (entry != NULL) {
+    index_mark_dirty (object->page->spatial_index, entry);
+  }
+}
+
+/*! \brief Find candidate objects in a set of regions
+ *  \par Function Description
+ *  Returns the objects whose indexed bounds may intersect any of the
+ *  given box shaped regions, in the order they appear in the page's
+ *  object list.  The result is a superset of the objects actually in
+ *  the regions; callers must still test each object.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] index     The SPATIAL_INDEX to search.
+ *  \param [in] rects     The BOX regions to check.
+ *  \param [in] n_rects   The number of regions.
+ *  \return A GList of candidate OBJECTs, to be freed by the caller
+ *          with g_list_free().
+ */
+GList *
+s_index_query_regions (TOPLEVEL *toplevel, SPATIAL_INDEX *index,
+                       BOX *rects, int n_rects)
+{
+  GPtrArray *found;
+  GList *list = NULL;
+  int i, j, n;
+  int x1, y1, x2, y2;
+
+  g_return_val_if_fail (index != NULL, NULL);
+
+  index_flush (toplevel, index);
+
+  index->query_stamp++;
+  found = g_ptr_array_new ();
+
+  index_collect (index, found, index->overflow);
+
+  for (n = 0; n < n_rects; n++) {
+    index_cell_range (index,
+                      MIN (rects[n].lower_x, rects[n].upper_x),
+                      MIN (rects[n].lower_y, rects[n].upper_y),
+                      MAX (rects[n].lower_x, rects[n].upper_x),
+                      MAX (rects[n].lower_y, rects[n].upper_y),
+                      &x1, &y1, &x2, &y2);
+
+    for (i = x1; i <= x2; i++) {
+      for (j = y1; j <= y2; j++) {
+        index_collect (index, found, index->cells[i][j]);
+      }
+    }
+  }
+
+  g_ptr_array_sort (found, index_entry_order_cmp);
+
+  for (n = (int) found->len - 1; n >= 0; n--) {
+    INDEX_ENTRY *entry = g_ptr_array_index (found, n);
+    list = g_list_prepend (list, entry->object);
+  }
+
+  g_ptr_array_free (found, TRUE);
+  return list;
+}
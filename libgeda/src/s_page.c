@@ -36,6 +36,7 @@
 #include <config.h>
 
 #include <stdio.h>
+#include <math.h>
 #ifdef HAVE_STDLIB_H
 #include <stdlib.h>
 #endif
@@ -58,7 +59,8 @@
 
 static gint global_pid = 0;
 
-/* Called just before removing an OBJECT from a PAGE. */
+/* Called just after adding an OBJECT to a PAGE.  The caller adds the
+ * object to the page's spatial index first. */
 static void
 object_added (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
@@ -79,7 +81,8 @@ object_added (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
   o_emit_change_notify (toplevel, object);
 }
 
-/* Called just before removing an OBJECT from a PAGE. */
+/* Called just before removing an OBJECT from a PAGE.  The caller
+ * removes the object from the page's spatial index afterwards. */
 static void
 pre_object_removed (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
@@ -93,6 +96,11 @@ pre_object_removed (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 #endif
   object->page = NULL;
 
+  /* Record the removal in the page's journal */
+  if (page->journal != NULL) {
+    g_hash_table_insert (page->journal, GINT_TO_POINTER (object->sid), NULL);
+  }
+
   /* Clear page's object_lastplace pointer if set */
   if (page->object_lastplace == object) {
     page->object_lastplace = NULL;
@@ -143,6 +151,9 @@ PAGE *s_page_new (TOPLEVEL *toplevel, const gchar *filename)
   /* Init tile array */
   s_tile_init (toplevel, page);
 
+  /* Init spatial index */
+  page->spatial_index = s_index_new (toplevel);
+
   /* Init the object list */
   page->_object_list = NULL;
 
@@ -245,6 +256,11 @@ void s_page_delete (TOPLEVEL *toplevel, PAGE *page)
 #endif
   s_tile_free_all (page);
 
+  s_index_free (page->spatial_index);
+  page->spatial_index = NULL;
+
+  s_page_journal_stop (page);
+
   /* free current page undo structs */
   s_undo_free_all (toplevel, page); 
 
@@ -633,6 +649,7 @@ gint s_page_autosave (TOPLEVEL *toplevel)
 void s_page_append (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
   page->_object_list = g_list_append (page->_object_list, object);
+  s_index_add_object (page->spatial_index, object);
   object_added (toplevel, page, object);
 }
 
@@ -651,6 +668,7 @@ void s_page_append_list (TOPLEVEL *toplevel, PAGE *page, GList *obj_list)
   GList *iter;
   page->_object_list = g_list_concat (page->_object_list, obj_list);
   for (iter = obj_list; iter != NULL; iter = g_list_next (iter)) {
+    s_index_add_object (page->spatial_index, iter->data);
     object_added (toplevel, page, iter->data);
   }
 }
@@ -668,6 +686,7 @@ void s_page_append_list (TOPLEVEL *toplevel, PAGE *page, GList *obj_list)
 void s_page_remove (TOPLEVEL *toplevel, PAGE *page, OBJECT *object)
 {
   pre_object_removed (toplevel, page, object);
+  s_index_remove_object (page->spatial_index, object);
   page->_object_list = g_list_remove (page->_object_list, object);
 }
 
@@ -697,6 +716,8 @@ s_page_replace (TOPLEVEL *toplevel, PAGE *page,
 
   pre_object_removed (toplevel, page, object1);
   iter->data = object2;
+  /* object2 takes over object1's position in the spatial index order */
+  s_index_replace_object (page->spatial_index, object1, object2);
   object_added (toplevel, page, object2);
 }
 
@@ -714,6 +735,7 @@ void s_page_delete_objects (TOPLEVEL *toplevel, PAGE *page)
   GList *iter;
   for (iter = objects; iter != NULL; iter = g_list_next (iter)) {
     pre_object_removed (toplevel, page, iter->data);
+    s_index_remove_object (page->spatial_index, iter->data);
   }
   page->_object_list = NULL;
   s_delete_object_glist (toplevel, objects);
@@ -779,11 +801,15 @@ GList *s_page_objects_in_region (TOPLEVEL *toplevel, PAGE *page,
 GList *s_page_objects_in_regions (TOPLEVEL *toplevel, PAGE *page,
                                   BOX *rects, int n_rects)
 {
+  GList *candidates;
   GList *iter;
   GList *list = NULL;
   int i;
 
-  for (iter = page->_object_list; iter != NULL; iter = g_list_next (iter)) {
+  candidates = s_index_query_regions (toplevel, page->spatial_index,
+                                      rects, n_rects);
+
+  for (iter = candidates; iter != NULL; iter = g_list_next (iter)) {
     OBJECT *object = iter->data;
     int left, top, right, bottom;
     int visible;
@@ -803,6 +829,276 @@ GList *s_page_objects_in_regions (TOPLEVEL *toplevel, PAGE *page,
     }
   }
 
+  g_list_free (candidates);
+
   list = g_list_reverse (list);
   return list;
 }
+
+/*! \brief Measure the distance to the connectable point of a line
+ *  \par Function Description
+ *  Finds the point of \a object nearest to (\a x, \a y) that a net
+ *  could connect to: the active end of a pin, or either end of a net
+ *  or bus, or any point along an orthogonal net or bus.
+ *
+ *  \param [in]  object  The pin, net or bus OBJECT.
+ *  \param [in]  x       The x coordinate to measure from.
+ *  \param [in]  y       The y coordinate to measure from.
+ *  \param [out] near_x  The x coordinate of the nearest point.
+ *  \param [out] near_y  The y coordinate of the nearest point.
+ *  \return The squared distance to the nearest point.
+ */
+static double nearest_line_point (OBJECT *object, int x, int y,
+                                  int *near_x, int *near_y)
+{
+  int x1, y1, x2, y2;
+  double dist1, dist2, mindist;
+
+  if (object->type == OBJ_PIN) {
+    *near_x = object->line->x[object->whichend];
+    *near_y = object->line->y[object->whichend];
+    return ((double) (x - *near_x) * (x - *near_x) +
+            (double) (y - *near_y) * (y - *near_y));
+  }
+
+  x1 = object->line->x[0];
+  y1 = object->line->y[0];
+  x2 = object->line->x[1];
+  y2 = object->line->y[1];
+
+  /* endpoint tests */
+  dist1 = (double) (x - x1) * (x - x1) + (double) (y - y1) * (y - y1);
+  dist2 = (double) (x - x2) * (x - x2) + (double) (y - y2) * (y - y2);
+  if (dist1 < dist2) {
+    *near_x = x1;
+    *near_y = y1;
+    mindist = dist1;
+  } else {
+    *near_x = x2;
+    *near_y = y2;
+    mindist = dist2;
+  }
+
+  /* midpoint tests */
+  if (x1 == x2 && ((y1 >= y && y >= y2) || (y2 >= y && y >= y1)) &&
+      (double) (x - x1) * (x - x1) < mindist) {
+    mindist = (double) (x - x1) * (x - x1);
+    *near_x = x1;
+    *near_y = y;
+  }
+  if (y1 == y2 && ((x1 >= x && x >= x2) || (x2 >= x && x >= x1)) &&
+      (double) (y - y1) * (y - y1) < mindist) {
+    mindist = (double) (y - y1) * (y - y1);
+    *near_x = x;
+    *near_y = y1;
+  }
+
+  return mindist;
+}
+
+/*! \brief Compare the positions of two objects on a page
+ *
+ *  \par Function Description
+ *  Tells which of two objects comes first in the object list of \a
+ *  page, without walking the list.
+ *
+ *  \param [in] page     The PAGE the objects are on.
+ *  \param [in] object1  The first OBJECT.
+ *  \param [in] object2  The second OBJECT.
+ *  \return Less than, equal to or greater than zero if \a object1
+ *          comes before, at or after \a object2.  Zero if either is
+ *          not on \a page.
+ */
+gint s_page_compare_order (PAGE *page, OBJECT *object1, OBJECT *object2)
+{
+  g_return_val_if_fail (page != NULL, 0);
+
+  return s_index_compare_order (page->spatial_index, object1, object2);
+}
+
+/*! \brief Find the nearest pin, net or bus on a page
+ *  \par Function Description
+ *  Finds the object of the given \a type whose connectable point is
+ *  closest to (\a x, \a y), looking no further than \a radius.
+ *  Only the objects the spatial index places near the point are
+ *  examined, including the pins inside nearby components.  Hidden
+ *  objects are skipped, as are objects for which \a accept, if not
+ *  NULL, returns FALSE.
+ *
+ *  For pins the connectable point is their active end; for nets and
+ *  buses it is either end, or the foot of the perpendicular on
+ *  horizontal and vertical segments.
+ *
+ *  \param [in]  toplevel  The TOPLEVEL object.
+ *  \param [in]  page      The PAGE to search.
+ *  \param [in]  x         The x coordinate to search around.
+ *  \param [in]  y         The y coordinate to search around.
+ *  \param [in]  radius    The maximum distance to search.
+ *  \param [in]  type      OBJ_PIN, OBJ_NET or OBJ_BUS.
+ *  \param [in]  accept    Function called with each object of \a type
+ *                         and \a accept_data, or NULL.
+ *  \param [in]  accept_data  Data passed to \a accept.
+ *  \param [out] nearest_x The x coordinate of the point found, or NULL.
+ *  \param [out] nearest_y The y coordinate of the point found, or NULL.
+ *  \param [out] distance  The distance to the point found, or NULL.
+ *  \return The nearest OBJECT, or NULL if none is within \a radius.
+ */
+OBJECT *s_page_find_nearest (TOPLEVEL *toplevel, PAGE *page,
+                             int x, int y, int radius, int type,
+                             gboolean (*accept) (OBJECT *, void *),
+                             void *accept_data,
+                             int *nearest_x, int *nearest_y,
+                             double *distance)
+{
+  GList *candidates;
+  GList *iter;
+  GList *prim;
+  OBJECT *found = NULL;
+  double best = (double) radius * radius;
+  int best_x = 0, best_y = 0;
+  int near_x, near_y;
+  double dist;
+  BOX rect;
+
+  g_return_val_if_fail (page != NULL, NULL);
+  g_return_val_if_fail (type == OBJ_PIN || type == OBJ_NET ||
+                        type == OBJ_BUS, NULL);
+
+  rect.lower_x = x - radius;
+  rect.lower_y = y - radius;
+  rect.upper_x = x + radius;
+  rect.upper_y = y + radius;
+
+  candidates = s_index_query_regions (toplevel, page->spatial_index,
+                                      &rect, 1);
+
+  for (iter = candidates; iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *object = iter->data;
+
+    if (!o_is_visible (toplevel, object))
+      continue;
+
+    if (object->type == type) {
+      if (accept != NULL && !accept (object, accept_data))
+        continue;
+
+      dist = nearest_line_point (object, x, y, &near_x, &near_y);
+      if (dist <= best) {
+        best = dist;
+        best_x = near_x;
+        best_y = near_y;
+        found = object;
+      }
+      continue;
+    }
+
+    /* pins of components are not in the index themselves */
+    if (type != OBJ_PIN ||
+        (object->type != OBJ_COMPLEX && object->type != OBJ_PLACEHOLDER))
+      continue;
+
+    for (prim = object->complex->prim_objs; prim != NULL;
+         prim = g_list_next (prim)) {
+      OBJECT *pin = prim->data;
+
+      if (pin->type != OBJ_PIN || !o_is_visible (toplevel, pin))
+        continue;
+      if (accept != NULL && !accept (pin, accept_data))
+        continue;
+
+      dist = nearest_line_point (pin, x, y, &near_x, &near_y);
+      if (dist <= best) {
+        best = dist;
+        best_x = near_x;
+        best_y = near_y;
+        found = pin;
+      }
+    }
+  }
+
+  g_list_free (candidates);
+
+  if (found != NULL) {
+    if (nearest_x != NULL) *nearest_x = best_x;
+    if (nearest_y != NULL) *nearest_y = best_y;
+    if (distance  != NULL) *distance  = sqrt (best);
+  }
+
+  return found;
+}
+
+/*! \brief Start recording the objects changed on a page
+ *  \par Function Description
+ *  Starts keeping a journal of the top-level objects which are added
+ *  to, changed on or removed from \a page, so that undo can save only
+ *  the objects which changed.  Does nothing if \a page already keeps
+ *  a journal.
+ *
+ *  \param [in] page  The PAGE to record changes for.
+ *
+ *  \sa s_page_journal_take() s_page_journal_stop()
+ */
+void s_page_journal_start (PAGE *page)
+{
+  if (page->journal == NULL) {
+    page->journal = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+}
+
+/*! \brief Stop recording the objects changed on a page
+ *  \par Function Description
+ *  Discards the journal of \a page, if any.
+ *
+ *  \param [in] page  The PAGE to stop recording changes for.
+ */
+void s_page_journal_stop (PAGE *page)
+{
+  if (page->journal != NULL) {
+    g_hash_table_destroy (page->journal);
+    page->journal = NULL;
+  }
+}
+
+/*! \brief Take the journal of objects changed on a page
+ *  \par Function Description
+ *  Returns the changes recorded for \a page since the journal was
+ *  started or last taken, and starts a new, empty journal.  The
+ *  returned table maps the sid of each changed top-level object
+ *  (stored with GINT_TO_POINTER()) to the OBJECT now on the page with
+ *  that sid, or to NULL if the object was removed.
+ *
+ *  The returned table should be freed with g_hash_table_destroy().
+ *
+ *  \param [in] page  The PAGE to take the journal of.
+ *  \return The journal, or NULL if \a page does not keep a journal.
+ */
+GHashTable *s_page_journal_take (PAGE *page)
+{
+  GHashTable *journal = page->journal;
+
+  if (journal != NULL) {
+    page->journal = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+  return journal;
+}
+
+/*! \brief Record that an object changed
+ *  \par Function Description
+ *  Adds the top-level ancestor of \a object to the journal of the
+ *  page it belongs to.  Does nothing for objects which are not on a
+ *  page, or if the page does not keep a journal.
+ *
+ *  \param [in] object  The OBJECT which changed.
+ */
+void s_page_journal_note (OBJECT *object)
+{
+  while (object->parent != NULL) {
+    object = object->parent;
+  }
+
+  if (object->page == NULL || object->page->journal == NULL)
+    return;
+
+  g_hash_table_insert (object->page->journal,
+                       GINT_TO_POINTER (object->sid), object);
+}
@@ -0,0 +1,157 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2011 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#include <config.h>
+
+#include <string.h>
+
+#include "libgeda_priv.h"
+
+#ifdef HAVE_LIBDMALLOC
+#include <dmalloc.h>
+#endif
+
+/*!
+ * \file s_string.c
+ * \brief Table of interned strings.
+ *
+ * Strings which recur across a design, such as attribute names and
+ * pin numbers, are stored once in this table. An interned string is
+ * never freed or changed, so its pointer stays valid for the life of
+ * the program, and two interned strings are equal exactly when their
+ * pointers are equal.
+ */
+
+/*! Longest string looked up without a temporary heap copy. */
+#define INTERN_STACK_SIZE 128
+
+/*! Storage for the characters of all interned strings. */
+static GStringChunk *intern_chunk = NULL;
+
+/*! Maps each interned string to itself. */
+static GHashTable *intern_table = NULL;
+
+G_LOCK_DEFINE_STATIC (intern);
+
+/*! \brief Intern a string while holding the lock.
+ *  \par Function Description
+ *  Returns the interned copy of \a string, adding it to the table
+ *  when \a insert is set.
+ */
+static const gchar *
+intern_locked (const gchar *string, gboolean insert)
+{
+  const gchar *interned;
+
+  if (intern_table == NULL) {
+    if (!insert)
+      return NULL;
+    intern_chunk = g_string_chunk_new (4096);
+    intern_table = g_hash_table_new (g_str_hash, g_str_equal);
+  }
+
+  interned = g_hash_table_lookup (intern_table, string);
+  if (interned == NULL && insert) {
+    interned = g_string_chunk_insert (intern_chunk, string);
+    g_hash_table_insert (intern_table, (gpointer) interned, (gpointer) interned);
+  }
+
+  return interned;
+}
+
+/*! \brief Intern a string.
+ *  \par Function Description
+ *  Returns the canonical copy of \a string from the table of interned
+ *  strings, adding it the first time it is seen. The result must not
+ *  be modified or freed.
+ *
+ *  \param [in] string  The string to intern, or NULL.
+ *  \return The interned string, or NULL if \a string is NULL.
+ */
+const gchar *
+s_string_intern (const gchar *string)
+{
+  const gchar *interned;
+
+  if (string == NULL)
+    return NULL;
+
+  G_LOCK (intern);
+  interned = intern_locked (string, TRUE);
+  G_UNLOCK (intern);
+
+  return interned;
+}
+
+/*! \brief Intern the start of a string.
+ *  \par Function Description
+ *  Like s_string_intern(), but interns only the first \a len bytes of
+ *  \a string, which need not be nul-terminated there. Short strings
+ *  already in the table are found without allocating.
+ *
+ *  \param [in] string  The string to intern.
+ *  \param [in] len     The number of bytes to intern.
+ *  \return The interned string.
+ */
+const gchar *
+s_string_intern_len (const gchar *string, gsize len)
+{
+  gchar buffer[INTERN_STACK_SIZE];
+  gchar *copy = buffer;
+  const gchar *interned;
+
+  g_return_val_if_fail (string != NULL, NULL);
+
+  if (len >= INTERN_STACK_SIZE)
+    copy = g_malloc (len + 1);
+  memcpy (copy, string, len);
+  copy[len] = '\0';
+
+  interned = s_string_intern (copy);
+
+  if (copy != buffer)
+    g_free (copy);
+
+  return interned;
+}
+
+/*! \brief Find an interned string.
+ *  \par Function Description
+ *  Returns the interned copy of \a string if it has been interned
+ *  before, without adding it. Use this to look up names given by a
+ *  caller: a name which was never interned cannot match any interned
+ *  string.
+ *
+ *  \param [in] string  The string to look up, or NULL.
+ *  \return The interned string, or NULL if there is none.
+ */
+const gchar *
+s_string_lookup (const gchar *string)
+{
+  const gchar *interned;
+
+  if (string == NULL)
+    return NULL;
+
+  G_LOCK (intern);
+  interned = intern_locked (string, FALSE);
+  G_UNLOCK (intern);
+
+  return interned;
+}
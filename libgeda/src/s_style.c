@@ -0,0 +1,162 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 1998-2010 Ales Hvezda
+ * Copyright (C) 1998-2011 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#include <config.h>
+
+#include "libgeda_priv.h"
+
+#ifdef HAVE_LIBDMALLOC
+#include <dmalloc.h>
+#endif
+
+/*!
+ * \file s_style.c
+ * \brief Table of shared stroke and fill styles.
+ *
+ * Every OBJECT points to an OBJECT_STYLE holding its line and fill
+ * options. Most objects in a design use one of a handful of styles, so
+ * the styles are interned: objects with identical options share one
+ * block, and the OBJECT itself only carries the pointer. An interned
+ * style is never freed or changed, so an object changes its style by
+ * pointing to a different block.
+ */
+
+/*! The style of a newly created object. */
+static const OBJECT_STYLE default_style = {
+  END_NONE, TYPE_SOLID, 0, 0, 0,
+  FILLING_HOLLOW, 0, 0, 0, 0, 0,
+};
+
+/*! Maps each interned style to itself. */
+static GHashTable *style_table = NULL;
+
+G_LOCK_DEFINE_STATIC (style);
+
+/*! \brief Hash function for the style table. */
+static guint
+style_hash (gconstpointer key)
+{
+  const OBJECT_STYLE *style = key;
+  guint hash;
+
+  hash = style->line_end;
+  hash = hash * 31 + style->line_type;
+  hash = hash * 31 + style->line_width;
+  hash = hash * 31 + style->line_length;
+  hash = hash * 31 + style->line_space;
+  hash = hash * 31 + style->fill_type;
+  hash = hash * 31 + style->fill_width;
+  hash = hash * 31 + style->fill_angle1;
+  hash = hash * 31 + style->fill_pitch1;
+  hash = hash * 31 + style->fill_angle2;
+  hash = hash * 31 + style->fill_pitch2;
+
+  return hash;
+}
+
+/*! \brief Equality function for the style table. */
+static gboolean
+style_equal (gconstpointer a, gconstpointer b)
+{
+  const OBJECT_STYLE *sa = a;
+  const OBJECT_STYLE *sb = b;
+
+  return (sa->line_end    == sb->line_end    &&
+          sa->line_type   == sb->line_type   &&
+          sa->line_width  == sb->line_width  &&
+          sa->line_length == sb->line_length &&
+          sa->line_space  == sb->line_space  &&
+          sa->fill_type   == sb->fill_type   &&
+          sa->fill_width  == sb->fill_width  &&
+          sa->fill_angle1 == sb->fill_angle1 &&
+          sa->fill_pitch1 == sb->fill_pitch1 &&
+          sa->fill_angle2 == sb->fill_angle2 &&
+          sa->fill_pitch2 == sb->fill_pitch2);
+}
+
+/*! \brief Get the default style.
+ *  \par Function Description
+ *  Returns the style given to newly created objects: solid, zero
+ *  width lines with no end caps and no fill.
+ *
+ *  \return The default style.
+ */
+const OBJECT_STYLE *
+s_style_default (void)
+{
+  return &default_style;
+}
+
+/*! \brief Intern a style.
+ *  \par Function Description
+ *  Returns the shared copy of \a style, adding it to the table the
+ *  first time it is seen. \a style is typically a modified copy of an
+ *  object's current style on the stack. The result must not be
+ *  modified or freed.
+ *
+ *  \param [in] style  The style to intern.
+ *  \return The interned style.
+ */
+const OBJECT_STYLE *
+s_style_intern (const OBJECT_STYLE *style)
+{
+  OBJECT_STYLE *interned;
+
+  g_return_val_if_fail (style != NULL, &default_style);
+
+  if (style_equal (style, &default_style))
+    return &default_style;
+
+  G_LOCK (style);
+
+  if (style_table == NULL)
+    style_table = g_hash_table_new (style_hash, style_equal);
+
+  interned = g_hash_table_lookup (style_table, style);
+  if (interned == NULL) {
+    interned = g_new (OBJECT_STYLE, 1);
+    *interned = *style;
+    g_hash_table_insert (style_table, interned, interned);
+  }
+
+  G_UNLOCK (style);
+
+  return interned;
+}
+
+/*! \brief Change the line width of an object.
+ *  \par Function Description
+ *  Points \a object to the style that differs from its current style
+ *  only in the line width. This does not emit change notification or
+ *  recalculate the bounds of \a object.
+ *
+ *  \param [in,out] object  The object to change.
+ *  \param [in]     width   The new line width.
+ */
+void
+s_style_set_line_width (OBJECT *object, int width)
+{
+  OBJECT_STYLE style;
+
+  g_return_if_fail (object != NULL);
+
+  style = *object->style;
+  style.line_width = width;
+  object->style = s_style_intern (&style);
+}
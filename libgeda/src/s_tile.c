@@ -100,6 +100,31 @@ void s_tile_init(TOPLEVEL * toplevel, PAGE * p_current)
 #endif
 }
 
+/*! \brief add an object to a single tile
+ *  \par Function Description
+ *  Adds <b>object</b> to the tile <b>t_current</b>, unless it is
+ *  already there, and records the tile in the object's tile array.
+ *  An object lies in only a few tiles, so the check searches the
+ *  object's tiles rather than the objects of the tile.
+ *  \param t_current The TILE to add the object to
+ *  \param object    The OBJECT to add
+ */
+static void s_tile_add_to_tile (TILE *t_current, OBJECT *object)
+{
+  guint i;
+
+  if (object->tiles == NULL)
+    object->tiles = g_ptr_array_sized_new (4);
+
+  for (i = 0; i < object->tiles->len; i++) {
+    if (g_ptr_array_index (object->tiles, i) == t_current)
+      return;
+  }
+
+  t_current->objects = g_list_append (t_current->objects, object);
+  g_ptr_array_add (object->tiles, t_current);
+}
+
 /*! \brief add a line object to the tiles
  *  \par Function Description
  *  This function takes a single line object and adds it to
@@ -111,9 +136,7 @@ void s_tile_init(TOPLEVEL * toplevel, PAGE * p_current)
  */
 static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
 {
-  TILE *t_current;
   PAGE *p_current;
-  GList *found;
   int i, j;
   int v, w;
   double x1, y1, x2, y2;
@@ -124,7 +147,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
   int start, end;
 
 #if DEBUG  
-  printf("name: %s\n", object->name);
+  printf("name: %s\n", o_get_name (object));
 #endif
 
   g_return_if_fail (object != NULL);
@@ -163,15 +186,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           return;
         }
         /* g_assert(v < MAX_TILES_X && w < MAX_TILES_Y && v >= 0 && w >= 0); */
-        t_current = &p_current->world_tiles[v][w];
-        found = g_list_find(t_current->objects, object);
-
-        if (!found) {
-          /*printf("%d %d\n", v, w);*/
-          t_current->objects = g_list_append(t_current->objects,
-                                             object);
-          object->tiles = g_list_append(object->tiles, t_current);
-        }
+        s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
 
         v = (int) x;
         w = (int) ceil(y);
@@ -179,15 +194,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           return;
         }
         /*g_assert(v < MAX_TILES_X && w < MAX_TILES_Y && v >= 0 && w >= 0);*/
-        t_current = &p_current->world_tiles[v][w];
-        found = g_list_find(t_current->objects, object);
-
-        if (!found) {
-          /*printf("%d %d\n", v, w);*/
-          t_current->objects = g_list_append(t_current->objects,
-                                             object);
-          object->tiles = g_list_append(object->tiles, t_current);
-        }
+        s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
 
       } else {
         v = (int) x;
@@ -196,15 +203,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           return;
         }
         /*g_assert(v < MAX_TILES_X && w < MAX_TILES_Y && v >= 0 && w >= 0);*/
-        t_current = &p_current->world_tiles[v][w];
-        found = g_list_find(t_current->objects, object);
-
-        if (!found) {
-          /*printf("%d %d\n", v, w);*/
-          t_current->objects = g_list_append(t_current->objects,
-                                             object);
-          object->tiles = g_list_append(object->tiles, t_current);
-        }
+        s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
       }
     }
 
@@ -222,15 +221,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           }
           /*g_assert(v < MAX_TILES_X && w < MAX_TILES_Y &&
             v >= 0 && w >= 0);*/
-          t_current = &p_current->world_tiles[v][w];
-          found = g_list_find(t_current->objects, object);
-
-          if (!found) {
-            /*printf("%d %d\n", v, w);*/
-            t_current->objects =
-              g_list_append(t_current->objects, object);
-            object->tiles = g_list_append(object->tiles, t_current);
-          }
+          s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
 
           w = (int) y;
           v = (int) ceil(x);
@@ -239,15 +230,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           }
           /* g_assert(v < MAX_TILES_X && w < MAX_TILES_Y &&
              v >= 0 && w >= 0);*/
-          t_current = &p_current->world_tiles[v][w];
-          found = g_list_find(t_current->objects, object);
-
-          if (!found) {
-            /*printf("%d %d\n", v, w);*/
-            t_current->objects =
-              g_list_append(t_current->objects, object);
-            object->tiles = g_list_append(object->tiles, t_current);
-          }
+          s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
 
         } else {
           w = (int) y;
@@ -257,15 +240,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
           }
           /*g_assert(v < MAX_TILES_X && w < MAX_TILES_Y &&
             v >= 0 && w >= 0);*/
-          t_current = &p_current->world_tiles[v][w];
-          found = g_list_find(t_current->objects, object);
-
-          if (!found) {
-            /*printf("%d %d\n", v, w);*/
-            t_current->objects =
-              g_list_append(t_current->objects, object);
-            object->tiles = g_list_append(object->tiles, t_current);
-          }
+          s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
         }
       }
     }
@@ -283,15 +258,7 @@ static void s_tile_add_line_object (TOPLEVEL *toplevel, OBJECT *object)
       }
       /*g_assert(v < MAX_TILES_X && w < MAX_TILES_Y &&
         v >= 0 && w >= 0);*/
-      t_current = &p_current->world_tiles[v][w];
-      found = g_list_find(t_current->objects, object);
-
-      if (!found) {
-        /*printf("%d %d\n", v, w);*/
-        t_current->objects = g_list_append(t_current->objects,
-                                           object);
-        object->tiles = g_list_append(object->tiles, t_current);
-      }
+      s_tile_add_to_tile (&p_current->world_tiles[v][w], object);
 
     }
   }
@@ -335,7 +302,7 @@ void s_tile_add_object (TOPLEVEL *toplevel, OBJECT *object)
 void s_tile_remove_object(OBJECT *object)
 {
   GList *iter;
-  GList *tl_current;
+  guint i;
 
   /* Correctly deal with compound objects */
   if (object->type == OBJ_COMPLEX || object->type == OBJ_PLACEHOLDER) {
@@ -346,18 +313,19 @@ void s_tile_remove_object(OBJECT *object)
     }
   }
 
-  for (tl_current = object->tiles;
-       tl_current != NULL;
-       tl_current = g_list_next (tl_current)) {
-    TILE *t_current = (TILE*)tl_current->data;
+  if (object->tiles == NULL)
+    return;
+
+  for (i = 0; i < object->tiles->len; i++) {
+    TILE *t_current = g_ptr_array_index (object->tiles, i);
     
     /* remove object from the list of objects for this tile */
     t_current->objects = g_list_remove(t_current->objects, object);
   }
 
-  /* reset the list of tiles for this object appears in */
-  g_list_free(object->tiles);
-  object->tiles = NULL;
+  /* reset the tiles this object appears in, keeping the array for
+   * when it is added again */
+  g_ptr_array_set_size (object->tiles, 0);
 }
 
 /*! \brief update the tile informations of an object
@@ -446,7 +414,7 @@ void s_tile_print(TOPLEVEL * toplevel, PAGE *page)
       while (temp) {
         o_current = (OBJECT *) temp->data;
 
-        printf("%s\n", o_current->name);
+        printf("%s\n", o_get_name (o_current));
 
         temp = g_list_next(temp);
       }
@@ -167,6 +167,12 @@ TOPLEVEL *s_toplevel_new (void)
   toplevel->rendered_text_bounds_data = NULL;
 
   toplevel->change_notify_funcs = NULL;
+  toplevel->damage_notify_funcs = NULL;
+
+  toplevel->change_notify_freeze_count = 0;
+  toplevel->change_notify_batch = NULL;
+  toplevel->change_notify_order = NULL;
+  toplevel->change_notify_damaged = FALSE;
 
   toplevel->attribs_changed_hooks = NULL;
 
@@ -224,6 +230,17 @@ void s_toplevel_delete (TOPLEVEL *toplevel)
   }
   g_list_free (toplevel->change_notify_funcs);
 
+  /* Remove all damage notification handlers */
+  for (iter = toplevel->damage_notify_funcs;
+       iter != NULL; iter = g_list_next (iter)) {
+    g_free (iter->data);
+  }
+  g_list_free (toplevel->damage_notify_funcs);
+
+  if (toplevel->change_notify_batch != NULL)
+    g_hash_table_destroy (toplevel->change_notify_batch);
+  g_list_free (toplevel->change_notify_order);
+
   s_weakref_notify (toplevel, toplevel->weak_refs);
 
   g_free (toplevel);
@@ -84,7 +84,7 @@ UNDO *s_undo_new_head(void)
   u_new = (UNDO *) g_malloc(sizeof(UNDO));
   u_new->type = -1;
   u_new->filename = NULL;
-  u_new->object_list = NULL;
+  u_new->changes = NULL;
   u_new->left = u_new->right = u_new->top = u_new->bottom = -1;
 
   u_new->page_control = 0;
@@ -111,7 +111,7 @@ void s_undo_destroy_head(UNDO *u_head)
  *  \par Function Description
  *
  */
-UNDO *s_undo_add (UNDO *head, int type, char *filename, GList *object_list,
+UNDO *s_undo_add (UNDO *head, int type, char *filename, GList *changes,
 		 int left, int top, int right, int bottom, int page_control,
 		 int up)
 {
@@ -122,7 +122,7 @@ UNDO *s_undo_add (UNDO *head, int type, char *filename, GList *object_list,
 
   u_new->filename = g_strdup (filename);
 	
-  u_new->object_list = object_list;
+  u_new->changes = changes;
 
   u_new->type = type;
 
@@ -164,8 +164,8 @@ void s_undo_print_all( UNDO *head )
 
     if (u_current->filename) printf("%s\n", u_current->filename);
 		
-    if (u_current->object_list) {
-      print_struct_forw (u_current->object_list);
+    if (u_current->changes) {
+      printf("\t%d changed objects\n", g_list_length (u_current->changes));
     }
 		
     printf("\t%d %d %d %d\n", u_current->left, u_current->top,
@@ -195,10 +195,8 @@ void s_undo_destroy_all(TOPLEVEL *toplevel, UNDO *head)
     u_prev = u_current->prev;	
     g_free(u_current->filename);
 		
-    if (u_current->object_list) {
-      s_delete_object_glist (toplevel, u_current->object_list);
-      u_current->object_list = NULL;
-    }
+    s_undo_free_changes (toplevel, u_current->changes);
+    u_current->changes = NULL;
 
     g_free(u_current);
     u_current = u_prev;
@@ -235,10 +233,8 @@ void s_undo_remove(TOPLEVEL *toplevel, UNDO *head, UNDO *u_tos)
 
       g_free(u_current->filename);	
 
-      if (u_current->object_list) {
-        s_delete_object_glist (toplevel, u_current->object_list);
-        u_current->object_list = NULL;
-      }
+      s_undo_free_changes (toplevel, u_current->changes);
+      u_current->changes = NULL;
 
       g_free(u_current);
       return;
@@ -267,10 +263,8 @@ void s_undo_remove_rest(TOPLEVEL *toplevel, UNDO *head)
       g_free(u_current->filename);
     }
 
-    if (u_current->object_list) {
-      s_delete_object_glist (toplevel, u_current->object_list);
-      u_current->object_list = NULL;
-    }
+    s_undo_free_changes (toplevel, u_current->changes);
+    u_current->changes = NULL;
 
     g_free(u_current);
     u_current = u_next;
@@ -289,7 +283,7 @@ int s_undo_levels(UNDO *head)
 	
   u_current = head;
   while (u_current != NULL) {
-    if (u_current->filename || u_current->object_list) {
+    if (u_current->type == UNDO_ALL) {
       count++;	
     } 	
 		
@@ -308,6 +302,8 @@ void s_undo_init(PAGE *p_current)
 {
 	p_current->undo_tos = p_current->undo_bottom = NULL;
 	p_current->undo_current = NULL;
+	p_current->undo_shadow = NULL;
+	p_current->undo_synced = NULL;
 }
 
 /*! \todo Finish function documentation!!!
@@ -321,4 +317,428 @@ void s_undo_free_all(TOPLEVEL *toplevel, PAGE *p_current)
   p_current->undo_bottom = NULL;
   p_current->undo_tos = NULL;
   p_current->undo_current = NULL;
+
+  if (p_current->undo_shadow != NULL) {
+    GHashTableIter iter;
+    gpointer value;
+
+    g_hash_table_iter_init (&iter, p_current->undo_shadow);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      s_undo_object_unref (toplevel, value);
+    }
+    g_hash_table_destroy (p_current->undo_shadow);
+    p_current->undo_shadow = NULL;
+  }
+  p_current->undo_synced = NULL;
+}
+
+/*! \brief Save the state of an object for undo
+ *  \par Function Description
+ *  Creates an UNDO_OBJECT holding a private copy of \a object, which
+ *  keeps the sid of \a object, and the sid of the object it is
+ *  attached to.  The copy is never modified, so the same UNDO_OBJECT
+ *  is shared by every undo level and page shadow in which the object
+ *  has this state.
+ *
+ *  The new UNDO_OBJECT has one reference, which should be released
+ *  with s_undo_object_unref().
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] object    The top-level OBJECT to save.
+ *  \return The new UNDO_OBJECT.
+ */
+UNDO_OBJECT *s_undo_object_new (TOPLEVEL *toplevel, OBJECT *object)
+{
+  UNDO_OBJECT *state = g_new0 (UNDO_OBJECT, 1);
+
+  state->ref_count = 1;
+  state->object = o_object_copy (toplevel, object);
+  object->copied_to = NULL;
+  state->attached_to = (object->attached_to != NULL) ?
+    object->attached_to->sid : -1;
+
+  return state;
+}
+
+/*! \brief Add a reference to a saved object state
+ *  \par Function Description
+ *  Increases the reference count of \a state.
+ *
+ *  \param [in] state  The UNDO_OBJECT to reference, or NULL.
+ *  \return \a state.
+ */
+UNDO_OBJECT *s_undo_object_ref (UNDO_OBJECT *state)
+{
+  if (state != NULL) {
+    state->ref_count++;
+  }
+  return state;
+}
+
+/*! \brief Release a reference to a saved object state
+ *  \par Function Description
+ *  Decreases the reference count of \a state, and frees it and its
+ *  copy of the object when no references remain.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] state     The UNDO_OBJECT to release, or NULL.
+ */
+void s_undo_object_unref (TOPLEVEL *toplevel, UNDO_OBJECT *state)
+{
+  if (state == NULL)
+    return;
+
+  g_return_if_fail (state->ref_count > 0);
+
+  if (--state->ref_count == 0) {
+    s_delete_object (toplevel, state->object);
+    g_free (state);
+  }
+}
+
+/*! \brief Free a list of undo changes
+ *  \par Function Description
+ *  Frees each UNDO_CHANGE in \a changes, and the list itself.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] changes   The GList of UNDO_CHANGEs to free.
+ */
+void s_undo_free_changes (TOPLEVEL *toplevel, GList *changes)
+{
+  GList *iter;
+
+  for (iter = changes; iter != NULL; iter = g_list_next (iter)) {
+    UNDO_CHANGE *change = iter->data;
+
+    s_undo_object_unref (toplevel, change->before);
+    s_undo_object_unref (toplevel, change->after);
+    g_free (change);
+  }
+  g_list_free (changes);
+}
+
+/* Sets the shadow state of the object with the given sid, taking over
+ * the caller's reference to state.  A NULL state forgets the object. */
+static void
+undo_shadow_set (TOPLEVEL *toplevel, PAGE *page, int sid, UNDO_OBJECT *state)
+{
+  UNDO_OBJECT *old_state;
+
+  old_state = g_hash_table_lookup (page->undo_shadow, GINT_TO_POINTER (sid));
+  s_undo_object_unref (toplevel, old_state);
+
+  if (state != NULL) {
+    g_hash_table_insert (page->undo_shadow, GINT_TO_POINTER (sid), state);
+  } else {
+    g_hash_table_remove (page->undo_shadow, GINT_TO_POINTER (sid));
+  }
+}
+
+/* Collects the changes made to the page since it was last synced with
+ * an undo level.  If fold is TRUE, the changes of the levels between
+ * undo_current and undo_synced are taken over as well. */
+static GList *
+undo_take_changes (TOPLEVEL *toplevel, PAGE *page, gboolean fold)
+{
+  GHashTable *pending;
+  GHashTable *journal;
+  GHashTableIter iter;
+  gpointer key, value;
+  GList *changes = NULL;
+  GList *c_iter;
+  UNDO *u_current;
+
+  pending = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  /* Levels above undo_current which the page was synced to, but which
+   * were dropped with o_undo_remove_last_undo(), are about to be
+   * discarded: keep their changes. */
+  if (fold && page->undo_synced != NULL &&
+      page->undo_synced != page->undo_current) {
+    u_current = (page->undo_current != NULL) ?
+      page->undo_current->next : page->undo_bottom;
+
+    for (; u_current != NULL; u_current = u_current->next) {
+      for (c_iter = u_current->changes;
+           c_iter != NULL; c_iter = g_list_next (c_iter)) {
+        UNDO_CHANGE *change = c_iter->data;
+        UNDO_CHANGE *prev = g_hash_table_lookup (pending,
+                                                 GINT_TO_POINTER (change->sid));
+        if (prev == NULL) {
+          g_hash_table_insert (pending, GINT_TO_POINTER (change->sid), change);
+          changes = g_list_prepend (changes, change);
+        } else {
+          s_undo_object_unref (toplevel, prev->after);
+          prev->after = change->after;
+          s_undo_object_unref (toplevel, change->before);
+          g_free (change);
+        }
+      }
+      g_list_free (u_current->changes);
+      u_current->changes = NULL;
+
+      if (u_current == page->undo_synced)
+        break;
+    }
+  }
+
+  journal = s_page_journal_take (page);
+  if (journal != NULL) {
+    g_hash_table_iter_init (&iter, journal);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      OBJECT *object = value;
+      UNDO_CHANGE *change = g_hash_table_lookup (pending, key);
+
+      if (change == NULL) {
+        change = g_new0 (UNDO_CHANGE, 1);
+        change->sid = GPOINTER_TO_INT (key);
+        change->before =
+          s_undo_object_ref (g_hash_table_lookup (page->undo_shadow, key));
+        g_hash_table_insert (pending, key, change);
+        changes = g_list_prepend (changes, change);
+      } else {
+        s_undo_object_unref (toplevel, change->after);
+      }
+
+      change->after = (object != NULL) ?
+        s_undo_object_new (toplevel, object) : NULL;
+      undo_shadow_set (toplevel, page, change->sid,
+                       s_undo_object_ref (change->after));
+    }
+    g_hash_table_destroy (journal);
+  }
+
+  g_hash_table_destroy (pending);
+
+  /* Drop objects which were added and removed again */
+  c_iter = changes;
+  while (c_iter != NULL) {
+    UNDO_CHANGE *change = c_iter->data;
+    GList *next = g_list_next (c_iter);
+
+    if (change->before == NULL && change->after == NULL) {
+      changes = g_list_delete_link (changes, c_iter);
+      g_free (change);
+    }
+    c_iter = next;
+  }
+
+  return g_list_reverse (changes);
+}
+
+/*! \brief Take the changes made to a page for a new undo level
+ *  \par Function Description
+ *  Returns the changes made to the objects of \a page since it last
+ *  matched an undo level, as a GList of UNDO_CHANGEs to store in the
+ *  next level with s_undo_add().  Only objects which were added,
+ *  changed or removed are copied, and each copy is shared with the
+ *  page's shadow and with the next level which changes the object
+ *  again.  The first call for a page saves the state of every object
+ *  on it and returns NULL.
+ *
+ *  The caller should set the page's undo_synced to the level the
+ *  changes are stored in.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] page      The PAGE to take the changes of.
+ *  \return A GList of UNDO_CHANGEs.
+ */
+GList *s_undo_take_changes (TOPLEVEL *toplevel, PAGE *page)
+{
+  const GList *iter;
+
+  if (page->undo_shadow == NULL) {
+    page->undo_shadow = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    for (iter = s_page_objects (page);
+         iter != NULL; iter = g_list_next (iter)) {
+      OBJECT *object = iter->data;
+      undo_shadow_set (toplevel, page, object->sid,
+                       s_undo_object_new (toplevel, object));
+    }
+
+    s_page_journal_start (page);
+    return NULL;
+  }
+
+  return undo_take_changes (toplevel, page, TRUE);
+}
+
+/* Makes the objects of the page match the before (if backwards is
+ * TRUE) or after state of each change, and updates the shadow. */
+static void
+undo_apply_changes (TOPLEVEL *toplevel, PAGE *page, GList *changes,
+                    gboolean backwards)
+{
+  GHashTable *live;
+  GHashTable *changed;
+  GHashTable *orphans;
+  GHashTable *slotted;
+  GHashTableIter h_iter;
+  gpointer key, value;
+  const GList *iter;
+
+  if (changes == NULL)
+    return;
+
+  live = g_hash_table_new (g_direct_hash, g_direct_equal);
+  changed = g_hash_table_new (g_direct_hash, g_direct_equal);
+  orphans = g_hash_table_new (g_direct_hash, g_direct_equal);
+  slotted = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (iter = s_page_objects (page); iter != NULL; iter = g_list_next (iter)) {
+    OBJECT *object = iter->data;
+    g_hash_table_insert (live, GINT_TO_POINTER (object->sid), object);
+  }
+
+  for (iter = changes; iter != NULL; iter = g_list_next (iter)) {
+    UNDO_CHANGE *change = iter->data;
+    g_hash_table_insert (changed, GINT_TO_POINTER (change->sid), change);
+  }
+
+  /* Replace, add or remove the changed objects */
+  for (iter = changes; iter != NULL; iter = g_list_next (iter)) {
+    UNDO_CHANGE *change = iter->data;
+    UNDO_OBJECT *target = backwards ? change->before : change->after;
+    gpointer sid = GINT_TO_POINTER (change->sid);
+    OBJECT *object = g_hash_table_lookup (live, sid);
+    OBJECT *new_obj = NULL;
+
+    if (object != NULL) {
+      /* Detach attributes without changing their color; unchanged
+       * ones are attached again to the replacement below. */
+      if (object->attached_to != NULL) {
+        o_attrib_remove (toplevel, &object->attached_to->attribs, object);
+      }
+      while (object->attribs != NULL) {
+        OBJECT *a_current = object->attribs->data;
+        if (!g_hash_table_lookup (changed, GINT_TO_POINTER (a_current->sid))) {
+          g_hash_table_insert (orphans, a_current, sid);
+        }
+        o_attrib_remove (toplevel, &object->attribs, a_current);
+      }
+    }
+
+    if (target != NULL) {
+      /* The saved copy is shared, so the page gets a copy of its own */
+      new_obj = o_object_copy (toplevel, target->object);
+      target->object->copied_to = NULL;
+
+      if (object != NULL) {
+        s_page_replace (toplevel, page, object, new_obj);
+      } else {
+        s_page_append (toplevel, page, new_obj);
+      }
+      g_hash_table_insert (live, sid, new_obj);
+    } else if (object != NULL) {
+      s_page_remove (toplevel, page, object);
+      g_hash_table_remove (live, sid);
+    }
+
+    if (object != NULL) {
+      s_delete_object (toplevel, object);
+    }
+  }
+
+  /* Restore attribute attachments */
+  for (iter = changes; iter != NULL; iter = g_list_next (iter)) {
+    UNDO_CHANGE *change = iter->data;
+    UNDO_OBJECT *target = backwards ? change->before : change->after;
+    OBJECT *object, *parent;
+
+    object = g_hash_table_lookup (live, GINT_TO_POINTER (change->sid));
+    if (object == NULL)
+      continue;
+
+    if (object->type == OBJ_COMPLEX) {
+      g_hash_table_insert (slotted, object, object);
+    }
+
+    if (target->attached_to == -1)
+      continue;
+
+    parent = g_hash_table_lookup (live, GINT_TO_POINTER (target->attached_to));
+    if (parent != NULL) {
+      o_attrib_attach (toplevel, object, parent, FALSE);
+      if (parent->type == OBJ_COMPLEX) {
+        g_hash_table_insert (slotted, parent, parent);
+      }
+    }
+  }
+
+  g_hash_table_iter_init (&h_iter, orphans);
+  while (g_hash_table_iter_next (&h_iter, &key, &value)) {
+    OBJECT *parent = g_hash_table_lookup (live, value);
+    if (parent != NULL) {
+      o_attrib_attach (toplevel, key, parent, FALSE);
+    }
+  }
+
+  /* Copies of complex objects lose their slot until their slot=
+   * attribute is attached again */
+  g_hash_table_iter_init (&h_iter, slotted);
+  while (g_hash_table_iter_next (&h_iter, &key, NULL)) {
+    s_slot_update_object (toplevel, key);
+  }
+
+  for (iter = changes; iter != NULL; iter = g_list_next (iter)) {
+    UNDO_CHANGE *change = iter->data;
+    UNDO_OBJECT *target = backwards ? change->before : change->after;
+
+    undo_shadow_set (toplevel, page, change->sid, s_undo_object_ref (target));
+  }
+
+  g_hash_table_destroy (live);
+  g_hash_table_destroy (changed);
+  g_hash_table_destroy (orphans);
+  g_hash_table_destroy (slotted);
+}
+
+/*! \brief Restore a page to the state of an undo level
+ *  \par Function Description
+ *  Makes the objects of \a page match the undo level \a target, by
+ *  reverting any changes not yet saved in an undo level and then
+ *  applying the changes of each level between the one the page last
+ *  matched and \a target.  Only the objects which differ are
+ *  replaced.
+ *
+ *  \param [in] toplevel  The TOPLEVEL object.
+ *  \param [in] page      The PAGE to restore.
+ *  \param [in] target    The UNDO level to restore.
+ */
+void s_undo_goto (TOPLEVEL *toplevel, PAGE *page, UNDO *target)
+{
+  GList *unsaved;
+  UNDO *u_current;
+
+  if (page->undo_shadow == NULL || page->undo_synced == NULL)
+    return;
+
+  unsaved = undo_take_changes (toplevel, page, FALSE);
+  undo_apply_changes (toplevel, page, unsaved, TRUE);
+  s_undo_free_changes (toplevel, unsaved);
+
+  /* Is the target below the level the page matches? */
+  for (u_current = page->undo_synced;
+       u_current != NULL && u_current != target;
+       u_current = u_current->prev);
+
+  if (u_current == target) {
+    for (u_current = page->undo_synced;
+         u_current != target; u_current = u_current->prev) {
+      undo_apply_changes (toplevel, page, u_current->changes, TRUE);
+    }
+  } else {
+    for (u_current = page->undo_synced->next;
+         u_current != NULL; u_current = u_current->next) {
+      undo_apply_changes (toplevel, page, u_current->changes, FALSE);
+      if (u_current == target)
+        break;
+    }
+  }
+
+  /* The changes made while restoring are not new changes */
+  g_hash_table_destroy (s_page_journal_take (page));
+
+  page->undo_synced = target;
 }
@@ -32,8 +32,143 @@ struct WeakRef
 {
   void (*notify_func)(void *, void *);
   void *user_data;
+  guint next;   /* position + 1 of the next entry with the same
+                 * user_data, or 0 */
 };
 
+/* Registrations are kept by value in an array.  Once there are more
+ * than WEAKREF_INDEX_MIN of them, an index from user data to the
+ * chain of positions registered with it makes removal O(1).  This
+ * matters for the TOPLEVEL, which holds one weak reference for every
+ * OBJECT wrapped by Scheme. */
+#define WEAKREF_INDEX_MIN 16
+
+struct st_weak_refs
+{
+  GArray *refs;        /* struct WeakRef entries */
+  GHashTable *index;   /* user_data -> position + 1 of the first entry
+                        * of its chain, or NULL */
+};
+
+#define WEAKREF_ENTRY(weak_refs, pos) \
+  (&g_array_index ((weak_refs)->refs, struct WeakRef, (pos)))
+
+/*! \brief Add an entry to the user data index of a weak ref list.
+ * \par Function Description
+ * Puts the entry at \a pos at the head of the chain of entries with
+ * the same user data.
+ *
+ * \param [in,out] weak_refs  List of registered weak references.
+ * \param [in] pos            Position of the entry to index.
+ */
+static void
+s_weakref_index_insert (WEAK_REFS *weak_refs, guint pos)
+{
+  struct WeakRef *entry = WEAKREF_ENTRY (weak_refs, pos);
+
+  entry->next =
+    GPOINTER_TO_UINT (g_hash_table_lookup (weak_refs->index,
+                                           entry->user_data));
+  g_hash_table_insert (weak_refs->index, entry->user_data,
+                       GUINT_TO_POINTER (pos + 1));
+}
+
+/*! \brief Replace a link in the user data index of a weak ref list.
+ * \par Function Description
+ * Finds the link to position \a pos in the chain of entries with user
+ * data \a user_data, and makes it point to \a link instead, which is a
+ * position + 1 or 0 to end the chain there.
+ *
+ * \param [in,out] weak_refs  List of registered weak references.
+ * \param [in] user_data      User data of the entry at \a pos.
+ * \param [in] pos            Position of the entry linked to.
+ * \param [in] link           New link.
+ */
+static void
+s_weakref_index_relink (WEAK_REFS *weak_refs, void *user_data,
+                        guint pos, guint link)
+{
+  struct WeakRef *entry;
+  guint head;
+
+  head = GPOINTER_TO_UINT (g_hash_table_lookup (weak_refs->index,
+                                                user_data));
+  if (head == pos + 1) {
+    if (link != 0) {
+      g_hash_table_insert (weak_refs->index, user_data,
+                           GUINT_TO_POINTER (link));
+    } else {
+      g_hash_table_remove (weak_refs->index, user_data);
+    }
+    return;
+  }
+
+  g_return_if_fail (head != 0);
+  for (entry = WEAKREF_ENTRY (weak_refs, head - 1);
+       entry->next != pos + 1;
+       entry = WEAKREF_ENTRY (weak_refs, entry->next - 1)) {
+    g_return_if_fail (entry->next != 0);
+  }
+  entry->next = link;
+}
+
+/*! \brief Build the user data index of a weak ref list.
+ * \par Function Description
+ * Indexes every entry of \a weak_refs by its user data.
+ *
+ * \param [in,out] weak_refs  List of registered weak references.
+ */
+static void
+s_weakref_build_index (WEAK_REFS *weak_refs)
+{
+  guint i;
+
+  weak_refs->index = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  for (i = 0; i < weak_refs->refs->len; i++) {
+    s_weakref_index_insert (weak_refs, i);
+  }
+}
+
+/*! \brief Remove one entry from a weak ref list.
+ * \par Function Description
+ * Removes the entry at \a pos by moving the last entry into its place.
+ *
+ * \param [in,out] weak_refs  List of registered weak references.
+ * \param [in] pos            Position of the entry to remove.
+ */
+static void
+s_weakref_remove_index (WEAK_REFS *weak_refs, guint pos)
+{
+  struct WeakRef *entry = WEAKREF_ENTRY (weak_refs, pos);
+  guint last = weak_refs->refs->len - 1;
+
+  if (weak_refs->index != NULL) {
+    s_weakref_index_relink (weak_refs, entry->user_data, pos, entry->next);
+  }
+
+  g_array_remove_index_fast (weak_refs->refs, pos);
+
+  if (weak_refs->index != NULL && pos != last) {
+    entry = WEAKREF_ENTRY (weak_refs, pos);
+    s_weakref_index_relink (weak_refs, entry->user_data, last, pos + 1);
+  }
+}
+
+/*! \brief Free a weak ref list.
+ *
+ * \param [in] weak_refs  List of registered weak references.
+ */
+static void
+s_weakref_free (WEAK_REFS *weak_refs)
+{
+  if (weak_refs->index != NULL) {
+    g_hash_table_destroy (weak_refs->index);
+  }
+  g_array_free (weak_refs->refs, TRUE);
+  g_free (weak_refs);
+}
+
 /*! \brief Notify weak reference watchers that a structure is dead.
  * \par Function Description
  * For each entry in \a weak_refs, call notify function with the dead
@@ -41,74 +176,120 @@ struct WeakRef
  * \a weak_refs. Should be called during destruction of an structure
  * that allows weak references.
  *
+ * The most recently added entries are notified first, unless entries
+ * have been removed since, which may change the order.
+ *
  * \param [in] dead_ptr       Pointer to structure being destroyed.
  * \param [in,out] weak_refs  List of registered weak references.
  */
 void
-s_weakref_notify (void *dead_ptr, GList *weak_refs)
+s_weakref_notify (void *dead_ptr, WEAK_REFS *weak_refs)
 {
-  GList *iter;
   struct WeakRef *entry;
-  for (iter = weak_refs; iter != NULL; iter = g_list_next (iter)) {
-    entry = (struct WeakRef *) iter->data;
-    if (entry != NULL && entry->notify_func != NULL) {
+  guint i;
+
+  if (weak_refs == NULL) return;
+
+  for (i = weak_refs->refs->len; i-- > 0; ) {
+    entry = WEAKREF_ENTRY (weak_refs, i);
+    if (entry->notify_func != NULL) {
       entry->notify_func (dead_ptr, entry->user_data);
     }
-    g_free (entry);
   }
-  g_list_free (weak_refs);
+  s_weakref_free (weak_refs);
 }
 
 /*! \brief Add a weak reference watcher to a weak ref list.
  * \par Function Description
  * Adds the weak reference callback \a notify_func to the weak
- * reference list \a weak_refs, returning the new head of \a
- * weak_refs. \a notify_func will be called with two arguments: a
- * pointer to the object being destroyed, and the \a user_data.
+ * reference list \a weak_refs, returning the new \a weak_refs. \a
+ * notify_func will be called with two arguments: a pointer to the
+ * object being destroyed, and the \a user_data.
  *
- * \param [in,out] weak_refs  List of registered weak references.
+ * \param [in,out] weak_refs  List of registered weak references, or NULL.
  * \param [in] notify_func    Weak reference notify function.
  * \param [in] user_data      Data to be passed to \a notify_func.
  *
- * \return new head of \a weak_refs list.
+ * \return new \a weak_refs list.
  */
-GList *
-s_weakref_add (GList *weak_refs, void (*notify_func)(void *, void *),
+WEAK_REFS *
+s_weakref_add (WEAK_REFS *weak_refs, void (*notify_func)(void *, void *),
                void *user_data)
 {
-  struct WeakRef *entry = g_malloc0 (sizeof (struct WeakRef));
-  entry->notify_func = notify_func;
-  entry->user_data = user_data;
-  return g_list_prepend (weak_refs, entry);
+  struct WeakRef entry;
+
+  if (weak_refs == NULL) {
+    weak_refs = g_new0 (WEAK_REFS, 1);
+    weak_refs->refs = g_array_new (FALSE, FALSE, sizeof (struct WeakRef));
+  }
+
+  entry.notify_func = notify_func;
+  entry.user_data = user_data;
+  entry.next = 0;
+  g_array_append_val (weak_refs->refs, entry);
+
+  if (weak_refs->index != NULL) {
+    s_weakref_index_insert (weak_refs, weak_refs->refs->len - 1);
+  } else if (weak_refs->refs->len > WEAKREF_INDEX_MIN) {
+    s_weakref_build_index (weak_refs);
+  }
+
+  return weak_refs;
 }
 
 /*! \brief Remove a weak reference watcher from a weak ref list.
  * \par Function Description
- * Removes a weak reference callback from the weak reference list \a
- * weak_refs, returning the new head of \a weak_refs.
+ * Removes every entry with both \a notify_func and \a user_data from
+ * the weak reference list \a weak_refs, returning the new \a
+ * weak_refs, which is NULL once the last callback has been removed.
  *
  * \param [in,out] weak_refs    List of registered weak references.
  * \param [in] notify_func      Notify function to search for.
  * \param [in] user_data        User data to search for.
  *
- * \return new head of \a weak_refs list.
+ * \return new \a weak_refs list.
  */
-GList *
-s_weakref_remove (GList *weak_refs, void (*notify_func)(void *, void *),
+WEAK_REFS *
+s_weakref_remove (WEAK_REFS *weak_refs, void (*notify_func)(void *, void *),
                   void *user_data)
 {
-  GList *iter;
   struct WeakRef *entry;
-  for (iter = weak_refs; iter != NULL; iter = g_list_next (iter)) {
-    entry = iter->data;
-    if ((entry != NULL) &&
-        (entry->notify_func == notify_func) &&
-        (entry->user_data == user_data)) {
-      g_free (entry);
-      iter->data = NULL;
+  guint pos;
+
+  if (weak_refs == NULL) return NULL;
+
+  if (weak_refs->index != NULL) {
+    /* Removing an entry moves another one, so follow the chain from
+     * its head again after each removal. */
+    pos = GPOINTER_TO_UINT (g_hash_table_lookup (weak_refs->index,
+                                                 user_data));
+    while (pos != 0) {
+      entry = WEAKREF_ENTRY (weak_refs, pos - 1);
+      if (entry->notify_func == notify_func) {
+        s_weakref_remove_index (weak_refs, pos - 1);
+        pos = GPOINTER_TO_UINT (g_hash_table_lookup (weak_refs->index,
+                                                     user_data));
+      } else {
+        pos = entry->next;
+      }
+    }
+  } else {
+    /* Go backwards, so the entry moved into a freed slot has already
+     * been looked at. */
+    for (pos = weak_refs->refs->len; pos-- > 0; ) {
+      entry = WEAKREF_ENTRY (weak_refs, pos);
+      if ((entry->notify_func == notify_func) &&
+          (entry->user_data == user_data)) {
+        s_weakref_remove_index (weak_refs, pos);
+      }
     }
   }
-  return g_list_remove_all (weak_refs, NULL);
+
+  if (weak_refs->refs->len == 0) {
+    s_weakref_free (weak_refs);
+    return NULL;
+  }
+  return weak_refs;
 }
 
 static void
@@ -122,15 +303,15 @@ weak_ptr_notify_func (void *dead_ptr, void *user_data) {
 /*! \brief Add a weak pointer to a weak ref list.
  * \par Function Description
  * Adds a weak reference for \a weak_pointer_loc to the weak reference
- * list \a weak_refs, returning the new head of \a weak_refs.
+ * list \a weak_refs, returning the new \a weak_refs.
  *
  * \param [in,out] weak_refs     List of registered weak references.
  * \param [in] weak_pointer_loc  Memory address of a pointer.
  *
- * \return new head of \a weak_refs list.
+ * \return new \a weak_refs list.
  */
-GList *
-s_weakref_add_ptr (GList *weak_refs, void **weak_pointer_loc)
+WEAK_REFS *
+s_weakref_add_ptr (WEAK_REFS *weak_refs, void **weak_pointer_loc)
 {
   return s_weakref_add (weak_refs, weak_ptr_notify_func, weak_pointer_loc);
 }
@@ -138,16 +319,15 @@ s_weakref_add_ptr (GList *weak_refs, void **weak_pointer_loc)
 /*! \brief Remove a weak pointer from a weak ref list.
  * \par Function Description
  * Removes the weak reference for \a weak_pointer_loc from the weak
- * reference list \a weak_refs, returning the new head of \a
- * weak_refs.
+ * reference list \a weak_refs, returning the new \a weak_refs.
  *
  * \param [in,out] weak_refs     List of registered weak references.
  * \param [in] weak_pointer_loc  Memory address of a pointer.
  *
- * \return new head of \a weak_refs list.
+ * \return new \a weak_refs list.
  */
-GList *
-s_weakref_remove_ptr (GList *weak_refs, void **weak_pointer_loc)
+WEAK_REFS *
+s_weakref_remove_ptr (WEAK_REFS *weak_refs, void **weak_pointer_loc)
 {
   return s_weakref_remove (weak_refs, weak_ptr_notify_func, weak_pointer_loc);
 }
@@ -27,6 +27,9 @@
 #include "libgeda_priv.h"
 #include "libgedaguile_priv.h"
 
+/*! global which is used to give copied objects a new sid */
+extern int global_sid;
+
 SCM_SYMBOL (wrong_type_arg_sym , "wrong-type-arg");
 SCM_SYMBOL (line_sym , "line");
 SCM_SYMBOL (net_sym , "net");
@@ -187,7 +190,10 @@ SCM_DEFINE (copy_object, "%copy-object", 1, 0, 0,
   TOPLEVEL *toplevel = edascm_c_current_toplevel ();
   OBJECT *obj = edascm_to_object (obj_s);
 
-  result = edascm_from_object (o_object_copy (toplevel, obj));
+  OBJECT *copy = o_object_copy (toplevel, obj);
+  copy->sid = global_sid++;
+
+  result = edascm_from_object (copy);
 
   /* At the moment, the only pointer to the object is owned by the
    * smob. */
@@ -0,0 +1,198 @@
+/* gEDA - GPL Electronic Design Automation
+ * libgeda - gEDA's library
+ * Copyright (C) 2010 gEDA Contributors (see ChangeLog for details)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111 USA
+ */
+#include <config.h>
+
+#include "libgeda_priv.h"
+
+/*!
+ * \file test_weakref.c
+ * \brief Tests for the weak reference lists of s_weakref.c.
+ *
+ * Each test is run with few entries, when lists are searched
+ * linearly, and with many, when they are indexed by user data.
+ */
+
+/* Number of entries which is sure to make a list indexed. */
+#define MANY 40
+
+/* Each callback counts its notifications in the int at user_data. */
+static void
+notify_a (void *dead_ptr, void *user_data)
+{
+  ((int *) user_data)[0]++;
+}
+
+static void
+notify_b (void *dead_ptr, void *user_data)
+{
+  ((int *) user_data)[1]++;
+}
+
+/* Fill a weak ref list with n - 1 entries notifying counts[1..n-1],
+ * which keep it indexed, and the entries under test on counts[0]. */
+static WEAK_REFS *
+add_fillers (WEAK_REFS *weak_refs, int (*counts)[2], int n)
+{
+  int i;
+
+  for (i = 1; i < n; i++) {
+    weak_refs = s_weakref_add (weak_refs, notify_a, counts[i]);
+  }
+  return weak_refs;
+}
+
+/* Check that every filler was notified once by notify_a. */
+static void
+check_fillers (int (*counts)[2], int n)
+{
+  int i;
+
+  for (i = 1; i < n; i++) {
+    g_assert (counts[i][0] == 1 && counts[i][1] == 0);
+  }
+}
+
+/* The same user data registered with two callbacks.  Removing it with
+ * either one leaves the other. */
+static void
+test_duplicate_user_data (int n)
+{
+  int counts[MANY][2];
+  WEAK_REFS *weak_refs;
+
+  memset (counts, 0, sizeof (counts));
+  weak_refs = s_weakref_add (NULL, notify_a, counts[0]);
+  weak_refs = add_fillers (weak_refs, counts, n);
+  weak_refs = s_weakref_add (weak_refs, notify_b, counts[0]);
+  weak_refs = s_weakref_remove (weak_refs, notify_a, counts[0]);
+  s_weakref_notify (NULL, weak_refs);
+  g_assert (counts[0][0] == 0 && counts[0][1] == 1);
+  check_fillers (counts, n);
+
+  memset (counts, 0, sizeof (counts));
+  weak_refs = s_weakref_add (NULL, notify_a, counts[0]);
+  weak_refs = add_fillers (weak_refs, counts, n);
+  weak_refs = s_weakref_add (weak_refs, notify_b, counts[0]);
+  weak_refs = s_weakref_remove (weak_refs, notify_b, counts[0]);
+  s_weakref_notify (NULL, weak_refs);
+  g_assert (counts[0][0] == 1 && counts[0][1] == 0);
+  check_fillers (counts, n);
+}
+
+/* Removing with a callback that isn't registered for the user data
+ * removes nothing. */
+static void
+test_mismatched_callback (int n)
+{
+  int counts[MANY][2];
+  WEAK_REFS *weak_refs;
+
+  memset (counts, 0, sizeof (counts));
+  weak_refs = s_weakref_add (NULL, notify_a, counts[0]);
+  weak_refs = add_fillers (weak_refs, counts, n);
+  weak_refs = s_weakref_remove (weak_refs, notify_b, counts[0]);
+  g_assert (weak_refs != NULL);
+  s_weakref_notify (NULL, weak_refs);
+  g_assert (counts[0][0] == 1 && counts[0][1] == 0);
+  check_fillers (counts, n);
+}
+
+/* Removing user data registered more than once with the same callback
+ * removes all of its entries, and removals keep working once it is
+ * gone. */
+static void
+test_repeated_entry (int n)
+{
+  int counts[MANY][2];
+  WEAK_REFS *weak_refs;
+  int i;
+
+  memset (counts, 0, sizeof (counts));
+  weak_refs = s_weakref_add (NULL, notify_a, counts[0]);
+  weak_refs = add_fillers (weak_refs, counts, n);
+  weak_refs = s_weakref_add (weak_refs, notify_a, counts[0]);
+  weak_refs = s_weakref_add (weak_refs, notify_a, counts[0]);
+  weak_refs = s_weakref_remove (weak_refs, notify_a, counts[0]);
+
+  for (i = 1; i < n; i += 2) {
+    weak_refs = s_weakref_remove (weak_refs, notify_a, counts[i]);
+  }
+  s_weakref_notify (NULL, weak_refs);
+
+  g_assert (counts[0][0] == 0);
+  for (i = 1; i < n; i++) {
+    g_assert (counts[i][0] == (i % 2 == 0 ? 1 : 0));
+  }
+}
+
+/* Removing the last entry frees the list. */
+static void
+test_remove_all (int n)
+{
+  int counts[MANY][2];
+  WEAK_REFS *weak_refs;
+  int i;
+
+  weak_refs = s_weakref_add (NULL, notify_b, counts[0]);
+  weak_refs = add_fillers (weak_refs, counts, n);
+  for (i = 1; i < n; i++) {
+    weak_refs = s_weakref_remove (weak_refs, notify_a, counts[i]);
+    g_assert (weak_refs != NULL);
+  }
+  weak_refs = s_weakref_remove (weak_refs, notify_b, counts[0]);
+  g_assert (weak_refs == NULL);
+}
+
+/* Weak pointers are cleared when notified, unless removed. */
+static void
+test_weak_pointers (int n)
+{
+  void *ptrs[MANY];
+  WEAK_REFS *weak_refs = NULL;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    ptrs[i] = ptrs;
+    weak_refs = s_weakref_add_ptr (weak_refs, &ptrs[i]);
+  }
+  for (i = 0; i < n; i += 3) {
+    weak_refs = s_weakref_remove_ptr (weak_refs, &ptrs[i]);
+  }
+  s_weakref_notify (NULL, weak_refs);
+
+  for (i = 0; i < n; i++) {
+    g_assert ((ptrs[i] == NULL) == (i % 3 != 0));
+  }
+}
+
+int
+main (int argc, char *argv[])
+{
+  int sizes[] = { 2, MANY };
+  int i;
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    test_duplicate_user_data (sizes[i]);
+    test_mismatched_callback (sizes[i]);
+    test_repeated_entry (sizes[i]);
+    test_remove_all (sizes[i]);
+    test_weak_pointers (sizes[i]);
+  }
+  return 0;
+}
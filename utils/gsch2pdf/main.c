@@ -61,7 +61,7 @@ static void print_arc(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 {
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
     cairo_set_source_rgb(
@@ -110,24 +110,17 @@ static void print_box(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
         0.0
         );
 
-    if ((object->fill_type == FILLING_HATCH) || (object->fill_type == FILLING_MESH))
+    if ((object->style->fill_type == FILLING_HATCH) || (object->style->fill_type == FILLING_MESH))
     {
         int index;
-        GArray *lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-
-        m_hatch_box(object->box, object->fill_angle1, object->fill_pitch1, lines);
-
-        if (object->fill_type == FILLING_MESH)
-        {
-            m_hatch_box(object->box, object->fill_angle2, object->fill_pitch2, lines);
-        }
+        GArray *lines = m_hatch_object(object);
 
         cairo_set_line_width(
             cairo,
-            object->fill_width > 5.0 ? object->fill_width : 5.0
+            object->style->fill_width > 5.0 ? object->style->fill_width : 5.0
             );
 
-        for (index=0; index<lines->len; index++)
+        for (index=0; lines != NULL && index<lines->len; index++)
         {
             LINE *line = &g_array_index(lines, LINE, index);
 
@@ -147,7 +140,7 @@ static void print_box(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
     cairo_move_to(
@@ -176,7 +169,7 @@ static void print_box(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 
     cairo_close_path(cairo);
 
-    if (object->fill_type == FILLING_FILL)
+    if (object->style->fill_type == FILLING_FILL)
     {
         cairo_fill_preserve(cairo);
     }
@@ -227,25 +220,18 @@ static void print_circle(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
         0.0
         );
 
-    if ((object->fill_type == FILLING_HATCH) || (object->fill_type == FILLING_MESH))
+    if ((object->style->fill_type == FILLING_HATCH) || (object->style->fill_type == FILLING_MESH))
     {
         int index;
-        GArray *lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-
-        m_hatch_circle(object->circle, object->fill_angle1, object->fill_pitch1, lines);
-
-        if (object->fill_type == FILLING_MESH)
-        {
-            m_hatch_circle(object->circle, object->fill_angle2, object->fill_pitch2, lines);
-        }
+        GArray *lines = m_hatch_object(object);
 
         cairo_set_line_width(
             cairo,
-            object->fill_width > 5.0 ? object->fill_width : 5.0
+            object->style->fill_width > 5.0 ? object->style->fill_width : 5.0
             );
 
 
-        for (index=0; index<lines->len; index++)
+        for (index=0; lines != NULL && index<lines->len; index++)
         {
             LINE *line = &g_array_index(lines, LINE, index);
 
@@ -265,7 +251,7 @@ static void print_circle(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
     cairo_new_sub_path(cairo);
@@ -279,7 +265,7 @@ static void print_circle(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
         2.0 * M_PI
         );
 
-    if (object->fill_type == FILLING_FILL)
+    if (object->style->fill_type == FILLING_FILL)
     {
         cairo_fill(cairo);
     }
@@ -326,7 +312,7 @@ static void print_line(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 {
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
     cairo_set_source_rgb(
@@ -395,24 +381,17 @@ static void print_path(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
         0.0
         );
 
-    if ((object->fill_type == FILLING_HATCH) || (object->fill_type == FILLING_MESH))
+    if ((object->style->fill_type == FILLING_HATCH) || (object->style->fill_type == FILLING_MESH))
     {
         int index;
-        GArray *lines = g_array_new (FALSE, FALSE, sizeof (LINE));
-
-        m_hatch_path(object->path, object->fill_angle1, object->fill_pitch1, lines);
-
-        if (object->fill_type == FILLING_MESH)
-        {
-            m_hatch_path(object->path, object->fill_angle2, object->fill_pitch2, lines);
-        }
+        GArray *lines = m_hatch_object(object);
 
         cairo_set_line_width(
             cairo,
-            object->fill_width > 5.0 ? object->fill_width : 5.0
+            object->style->fill_width > 5.0 ? object->style->fill_width : 5.0
             );
 
-        for (index=0; index<lines->len; index++)
+        for (index=0; lines != NULL && index<lines->len; index++)
         {
             LINE *line = &g_array_index(lines, LINE, index);
 
@@ -475,10 +454,10 @@ static void print_path(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
-    if (object->fill_type == FILLING_FILL)
+    if (object->style->fill_type == FILLING_FILL)
     {
         cairo_fill_preserve(cairo);
     }
@@ -492,7 +471,7 @@ static void print_pin(TOPLEVEL *current, cairo_t *cairo, OBJECT *object)
 {
     cairo_set_line_width(
         cairo,
-        object->line_width > 10.0 ? object->line_width : 10.0
+        object->style->line_width > 10.0 ? object->style->line_width : 10.0
         );
 
     cairo_set_source_rgb(